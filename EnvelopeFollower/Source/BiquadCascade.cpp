@@ -0,0 +1,447 @@
+/*
+  ==============================================================================
+
+    BiquadCascade.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the BiquadCascade component class.
+    Dependencies:
+    - BiquadCascade.h
+    - math.h
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "BiquadCascade.h" // Import the interface definition for the BiquadCascade component for implementation.
+#include <math.h> // Imports the basic c stdlib math library
+
+/**
+ * The constructor for the BiquadCascade component.
+ *
+ * Defaults to a 2nd order Butterworth bandpass from 1000 Hz to 1000 Hz at 44100 Hz, matching the Filter defaults.
+ */
+template <typename SampleType>
+BiquadCascade<SampleType>::BiquadCascade()
+{
+    design(false);
+}
+
+/**
+ * Sets the number of input audio samples per second and redesigns the cascade.
+ *
+ * A new sampling frequency means a new stream, so the coefficients jump straight to the new design.
+ *
+ * Arguments
+ * ---------
+ * double freq: The new number of input audio samples per second.
+ */
+template <typename SampleType>
+void BiquadCascade<SampleType>::setSamplingFrequency(double freq)
+{
+    sampling_frequency = freq;
+    design(false);
+}
+
+/**
+ * Sets the cutoff frequency of the lowpass side. The coefficients glide to the new design.
+ *
+ * Arguments
+ * ---------
+ * double freq: The new cutoff frequency in Hz.
+ */
+template <typename SampleType>
+void BiquadCascade<SampleType>::setLowpass(double freq)
+{
+    // Skip the redesign if nothing changed.
+    if (freq == lowpass_frequency) {
+        return;
+    }
+    lowpass_frequency = freq;
+    design(true);
+}
+
+/**
+ * Sets the cutoff frequency of the highpass side. The coefficients glide to the new design.
+ *
+ * Arguments
+ * ---------
+ * double freq: The new cutoff frequency in Hz.
+ */
+template <typename SampleType>
+void BiquadCascade<SampleType>::setHighpass(double freq)
+{
+    // Skip the redesign if nothing changed.
+    if (freq == highpass_frequency) {
+        return;
+    }
+    highpass_frequency = freq;
+    design(true);
+}
+
+/**
+ * Sets the order of both sides of the bandpass.
+ *
+ * The number of sections changes with the order, so there is nothing to glide from: the cascade is reset.
+ *
+ * Arguments
+ * ---------
+ * int new_order: 2, 4 or 8. Other values are rounded to the nearest of those.
+ */
+template <typename SampleType>
+void BiquadCascade<SampleType>::setOrder(int new_order)
+{
+    new_order = new_order <= 2 ? 2 : (new_order <= 5 ? 4 : 8);
+    if (new_order == order) {
+        return;
+    }
+    order = new_order;
+    design(false);
+    reset();
+}
+
+/**
+ * Selects a Butterworth or Linkwitz-Riley design. Resets the cascade.
+ *
+ * Arguments
+ * ---------
+ * Alignment new_alignment: The new alignment.
+ */
+template <typename SampleType>
+void BiquadCascade<SampleType>::setAlignment(Alignment new_alignment)
+{
+    if (new_alignment == alignment) {
+        return;
+    }
+    alignment = new_alignment;
+    design(false);
+    reset();
+}
+
+/**
+ * Sets how many samples the coefficients take to glide to a new design after a cutoff change.
+ *
+ * Arguments
+ * ---------
+ * int num_samples: The glide length. 0 makes changes take effect immediately.
+ */
+template <typename SampleType>
+void BiquadCascade<SampleType>::setSmoothingLength(int num_samples)
+{
+    smoothing_length = std::max(num_samples, 0);
+}
+
+/**
+ * Clears the state of every section.
+ */
+template <typename SampleType>
+void BiquadCascade<SampleType>::reset()
+{
+    std::fill(s1, s1 + max_sections, (SampleType) 0);
+    std::fill(s2, s2 + max_sections, (SampleType) 0);
+}
+
+/**
+ * Recomputes every section's coefficients from the cutoffs, order, alignment and sampling frequency.
+ *
+ * Butterworth sections come from the RBJ cookbook lowpass/highpass with the pole pair Qs of an analogue
+ * Butterworth filter. A Linkwitz-Riley filter is the Butterworth filter of half the order applied twice, which at
+ * order 2 means two first-order sections, stored as biquads with b2 = a2 = 0.
+ *
+ * Arguments
+ * ---------
+ * bool glide: Whether the coefficients glide to the new design or jump straight to it.
+ */
+template <typename SampleType>
+void BiquadCascade<SampleType>::design(bool glide)
+{
+    // The Butterworth filter each side is built from, and how many times it's applied.
+    const int butterworth_order = alignment == Alignment::linkwitzRiley ? order / 2 : order;
+    const int repeats = alignment == Alignment::linkwitzRiley ? 2 : 1;
+    // A first-order Butterworth filter is one section; otherwise one section per pole pair.
+    const int sections_per_filter = butterworth_order == 1 ? 1 : butterworth_order / 2;
+    const int sections_per_side = sections_per_filter * repeats;
+    num_sections = sections_per_side * 2;
+
+    // Keep both cutoffs strictly inside (0, nyquist) so every section stays stable.
+    const double lowest = 1.0;
+    const double highest = 0.49 * sampling_frequency;
+    const double cutoffs[2] = { std::min(std::max(lowpass_frequency, lowest), highest),
+                                std::min(std::max(highpass_frequency, lowest), highest) };
+
+    int section = 0;
+    for (int side = 0; side < 2; ++side) {
+        const bool highpass = side == 1;
+        const double w0 = 2.0 * pi * cutoffs[side] / sampling_frequency;
+        const double cos_w0 = cos(w0);
+        const double sin_w0 = sin(w0);
+
+        for (int repeat = 0; repeat < repeats; ++repeat) {
+            if (butterworth_order == 1) {
+                // Bilinear one-pole, the same design as Filter::calc_coeff.
+                const double k = tan(w0 / 2.0);
+                const double a0 = 1.0 + k;
+                if (highpass) {
+                    setSection(section++, 1.0 / a0, -1.0 / a0, 0.0, (k - 1.0) / a0, 0.0);
+                } else {
+                    setSection(section++, k / a0, k / a0, 0.0, (k - 1.0) / a0, 0.0);
+                }
+                continue;
+            }
+
+            for (int pair = 0; pair < butterworth_order / 2; ++pair) {
+                // The Q of this pole pair of an analogue Butterworth filter.
+                const double q = 1.0 / (2.0 * cos((2 * pair + 1) * pi / (2.0 * butterworth_order)));
+                const double alpha = sin_w0 / (2.0 * q);
+                const double a0 = 1.0 + alpha;
+                if (highpass) {
+                    const double b = (1.0 + cos_w0) / 2.0;
+                    setSection(section++, b / a0, -2.0 * b / a0, b / a0, -2.0 * cos_w0 / a0, (1.0 - alpha) / a0);
+                } else {
+                    const double b = (1.0 - cos_w0) / 2.0;
+                    setSection(section++, b / a0, 2.0 * b / a0, b / a0, -2.0 * cos_w0 / a0, (1.0 - alpha) / a0);
+                }
+            }
+        }
+    }
+
+    if (glide && smoothing_length > 0) {
+        // Spread the change over whole chunks, and step once per chunk.
+        const int chunks = (smoothing_length + ramp_chunk - 1) / ramp_chunk;
+        for (int index = 0; index < num_sections; ++index) {
+            step_b0[index] = (target_b0[index] - b0[index]) / chunks;
+            step_b1[index] = (target_b1[index] - b1[index]) / chunks;
+            step_b2[index] = (target_b2[index] - b2[index]) / chunks;
+            step_a1[index] = (target_a1[index] - a1[index]) / chunks;
+            step_a2[index] = (target_a2[index] - a2[index]) / chunks;
+        }
+        ramp_remaining = chunks * ramp_chunk;
+    } else {
+        std::copy(target_b0, target_b0 + max_sections, b0);
+        std::copy(target_b1, target_b1 + max_sections, b1);
+        std::copy(target_b2, target_b2 + max_sections, b2);
+        std::copy(target_a1, target_a1 + max_sections, a1);
+        std::copy(target_a2, target_a2 + max_sections, a2);
+        ramp_remaining = 0;
+    }
+}
+
+/**
+ * Sets the target coefficients of one section, normalised so that a0 is 1. design decides whether they glide in.
+ *
+ * Arguments
+ * ---------
+ * int section: The index of the section.
+ * double nb0, nb1, nb2: The feedforward coefficients.
+ * double na1, na2: The feedback coefficients.
+ */
+template <typename SampleType>
+void BiquadCascade<SampleType>::setSection(int section, double nb0, double nb1, double nb2, double na1, double na2)
+{
+    target_b0[section] = (SampleType) nb0;
+    target_b1[section] = (SampleType) nb1;
+    target_b2[section] = (SampleType) nb2;
+    target_a1[section] = (SampleType) na1;
+    target_a2[section] = (SampleType) na2;
+}
+
+/**
+ * Advances the coefficient glide by one chunk. Lands exactly on the targets on the last chunk.
+ */
+template <typename SampleType>
+void BiquadCascade<SampleType>::stepRamp()
+{
+    if (ramp_remaining <= ramp_chunk) {
+        std::copy(target_b0, target_b0 + max_sections, b0);
+        std::copy(target_b1, target_b1 + max_sections, b1);
+        std::copy(target_b2, target_b2 + max_sections, b2);
+        std::copy(target_a1, target_a1 + max_sections, a1);
+        std::copy(target_a2, target_a2 + max_sections, a2);
+        return;
+    }
+    for (int index = 0; index < num_sections; ++index) {
+        b0[index] += step_b0[index];
+        b1[index] += step_b1[index];
+        b2[index] += step_b2[index];
+        a1[index] += step_a1[index];
+        a2[index] += step_a2[index];
+    }
+}
+
+/**
+ * Filters a block of samples in place.
+ *
+ * While gliding, the block is cut at every chunk boundary and the coefficients are stepped in between,
+ * so the wavefront kernel itself always runs with constant coefficients.
+ *
+ * Arguments
+ * ---------
+ * SampleType* samples: The samples to filter. Overwritten with the output.
+ * int numSamples: The number of samples.
+ */
+template <typename SampleType>
+void BiquadCascade<SampleType>::process(SampleType* samples, int numSamples)
+{
+    while (numSamples > 0 && ramp_remaining > 0) {
+        // Step at the start of each chunk, exactly as processSample does.
+        if (ramp_remaining % ramp_chunk == 0) {
+            stepRamp();
+        }
+        const int segment = std::min(numSamples, (ramp_remaining - 1) % ramp_chunk + 1);
+        processConstant(samples, segment);
+        ramp_remaining -= segment;
+        samples += segment;
+        numSamples -= segment;
+    }
+    if (numSamples > 0) {
+        processConstant(samples, numSamples);
+    }
+}
+
+/**
+ * Runs process over a part of a block that uses constant coefficients.
+ *
+ * Picks a wavefront kernel specialised for the number of sections where it measures faster than running the sections
+ * in sequence: 2 sections, and 4 sections in float. At 8 sections, and 4 in double, the hoisted coefficients and state
+ * no longer fit in registers, the kernel spills, and the sequential loop wins. BiquadCascadeBenchmark.cpp checks this.
+ *
+ * Arguments
+ * ---------
+ * SampleType* samples: The samples to filter. Overwritten with the output.
+ * int numSamples: The number of samples.
+ */
+template <typename SampleType>
+void BiquadCascade<SampleType>::processConstant(SampleType* samples, int numSamples)
+{
+    if (num_sections == 2) {
+        processWavefront<2>(samples, numSamples);
+        return;
+    }
+    if (num_sections == 4 && sizeof(SampleType) == sizeof(float)) {
+        processWavefront<4>(samples, numSamples);
+        return;
+    }
+    for (int index = 0; index < numSamples; ++index) {
+        SampleType sample = samples[index];
+        for (int section = 0; section < num_sections; ++section) {
+            const SampleType output = b0[section] * sample + s1[section];
+            s1[section] = b1[section] * sample - a1[section] * output + s2[section];
+            s2[section] = b2[section] * sample - a2[section] * output;
+            sample = output;
+        }
+        samples[index] = sample;
+    }
+}
+
+/**
+ * Filters a block in place with a wavefront over a fixed number of sections.
+ *
+ * On step t, section n filters sample t - n, taking its input from what section n - 1 produced on step t - 1.
+ * Updating the sections from last to first lets every section read its input before it is overwritten, and means
+ * no section in a step waits on another. The first NumSections - 1 steps fill the wavefront and the last
+ * NumSections - 1 drain it, so a block leaves nothing in flight and the output matches sequential processing.
+ *
+ * Arguments
+ * ---------
+ * SampleType* samples: The samples to filter. Overwritten with the output, which trails the input by NumSections - 1 steps.
+ * int numSamples: The number of samples.
+ */
+template <typename SampleType>
+template <int NumSections>
+void BiquadCascade<SampleType>::processWavefront(SampleType* samples, int numSamples)
+{
+    // Hoist the coefficients and state so they stay in registers for the whole block.
+    SampleType c_b0[NumSections], c_b1[NumSections], c_b2[NumSections], c_a1[NumSections], c_a2[NumSections];
+    SampleType z1[NumSections], z2[NumSections];
+    // The output of each section from the previous step.
+    SampleType pipe[NumSections] = {};
+    for (int section = 0; section < NumSections; ++section) {
+        c_b0[section] = b0[section];
+        c_b1[section] = b1[section];
+        c_b2[section] = b2[section];
+        c_a1[section] = a1[section];
+        c_a2[section] = a2[section];
+        z1[section] = s1[section];
+        z2[section] = s2[section];
+    }
+
+    // One transposed direct form II step of one section.
+    auto run = [&](int section, SampleType input) {
+        const SampleType output = c_b0[section] * input + z1[section];
+        z1[section] = c_b1[section] * input - c_a1[section] * output + z2[section];
+        z2[section] = c_b2[section] * input - c_a2[section] * output;
+        return output;
+    };
+
+    // A step where only some sections have a sample to work on, while filling or draining the wavefront.
+    auto partialStep = [&](int step) {
+        const int first = std::max(0, step - numSamples + 1);
+        const int last = std::min(NumSections - 1, step);
+        for (int section = last; section >= first; --section) {
+            pipe[section] = run(section, section == 0 ? samples[step] : pipe[section - 1]);
+        }
+        if (last == NumSections - 1) {
+            samples[step - (NumSections - 1)] = pipe[NumSections - 1];
+        }
+    };
+
+    const int num_steps = numSamples + NumSections - 1;
+    int step = 0;
+    // Fill.
+    for (; step < std::min(NumSections - 1, num_steps); ++step) {
+        partialStep(step);
+    }
+    // Every section busy. The output overwrites a sample that has already been read.
+    for (; step < numSamples; ++step) {
+        for (int section = NumSections - 1; section > 0; --section) {
+            pipe[section] = run(section, pipe[section - 1]);
+        }
+        pipe[0] = run(0, samples[step]);
+        samples[step - (NumSections - 1)] = pipe[NumSections - 1];
+    }
+    // Drain.
+    for (; step < num_steps; ++step) {
+        partialStep(step);
+    }
+
+    // Write the state back for the next block.
+    for (int section = 0; section < NumSections; ++section) {
+        s1[section] = z1[section];
+        s2[section] = z2[section];
+    }
+}
+
+/**
+ * Filters a single sample, running the sections one after another.
+ *
+ * Arguments
+ * ---------
+ * SampleType sample: The next input sample.
+ *
+ * Returns
+ * -------
+ * SampleType: The next output sample.
+ */
+template <typename SampleType>
+SampleType BiquadCascade<SampleType>::processSample(SampleType sample)
+{
+    // Same glide bookkeeping as process, one sample at a time.
+    if (ramp_remaining > 0) {
+        if (ramp_remaining % ramp_chunk == 0) {
+            stepRamp();
+        }
+        --ramp_remaining;
+    }
+    for (int section = 0; section < num_sections; ++section) {
+        const SampleType output = b0[section] * sample + s1[section];
+        s1[section] = b1[section] * sample - a1[section] * output + s2[section];
+        s2[section] = b2[section] * sample - a2[section] * output;
+        sample = output;
+    }
+    return sample;
+}
+
+// The plugin uses both precisions, depending on what the host asks for.
+template class BiquadCascade<float>;
+template class BiquadCascade<double>;
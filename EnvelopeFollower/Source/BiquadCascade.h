@@ -0,0 +1,309 @@
+/*
+  ==============================================================================
+
+    BiquadCascade.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition for the BiquadCascade component class, a Butterworth or Linkwitz-Riley
+                 bandpass made of up to eight second-order sections.
+    Dependencies:
+    - algorithm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <algorithm> // Imports the c++ stdlib algorithm libarary.
+
+/**
+ * A bandpass built from a cascade of lowpass and highpass biquad sections.
+ *
+ * Replaces the one-pole Filter pair in SignalProcessor when a steeper slope is needed to isolate a band.
+ * The lowpass and highpass sides each have the selected order (2, 4 or 8), as either a Butterworth
+ * design or a Linkwitz-Riley design (two cascaded Butterworth filters of half the order).
+ *
+ * The coefficients and state live in contiguous per-field arrays (one array of b0s, one of b1s, and so on),
+ * and a block is processed as a wavefront: on each step every section advances by one sample, with section n
+ * working on the sample section n - 1 finished on the previous step. The sections in a step don't depend on each
+ * other, so their multiply-add chains overlap instead of waiting on one another. The wavefront is filled at the
+ * start of each block and drained at the end, so the output is identical to running the sections one after
+ * another and adds no latency.
+ *
+ * The overlap only pays off while the kernel fits in registers: at 2 sections, and 4 in float. Larger cascades run the
+ * sections one after another instead. BiquadCascadeBenchmark.cpp checks that choice.
+ *
+ * Templated on the sample type. Designs are computed in double.
+ *
+ * Attributes
+ * ----------
+ * public static const int max_sections: The most sections a cascade can have. (8: four per side at order 8)
+ * private double sampling_frequency: The number of input audio samples per second.
+ * private double lowpass_frequency: The cutoff of the lowpass side in Hz.
+ * private double highpass_frequency: The cutoff of the highpass side in Hz.
+ * private int order: The order of each side. 2, 4 or 8.
+ * private Alignment alignment: Butterworth or Linkwitz-Riley.
+ * private int num_sections: The number of sections in use.
+ * private int smoothing_length: The number of samples coefficient changes take to glide in.
+ * private int ramp_remaining: The number of samples left in the current coefficient glide.
+ * private SampleType b0, b1, b2, a1, a2 [max_sections]: The coefficients in use, one array per coefficient.
+ * private SampleType step_b0, step_b1, step_b2, step_a1, step_a2 [max_sections]: The per-chunk change of each coefficient while gliding.
+ * private SampleType target_b0, target_b1, target_b2, target_a1, target_a2 [max_sections]: The coefficients being glided to.
+ * private SampleType s1, s2 [max_sections]: The transposed direct form II state of each section.
+ *
+ * Methods
+ * -------
+ * public void setSamplingFrequency(double freq): Sets the sampling frequency and redesigns the cascade without gliding.
+ * public void setLowpass(double freq): Sets the lowpass cutoff. Glides to the new coefficients.
+ * public void setHighpass(double freq): Sets the highpass cutoff. Glides to the new coefficients.
+ * public void setOrder(int new_order): Sets the order of each side. Resets the cascade.
+ * public void setAlignment(Alignment new_alignment): Selects Butterworth or Linkwitz-Riley. Resets the cascade.
+ * public void setSmoothingLength(int num_samples): Sets how many samples coefficient changes take to glide in.
+ * public void reset(): Clears the section state.
+ * public void process(SampleType* samples, int numSamples): Filters a block in place.
+ * public SampleType processSample(SampleType sample): Filters one sample, running the sections one after another.
+ * public int getNumSections(): Returns the number of sections in use.
+ * private void design(bool glide): Recomputes the section coefficients from the settings.
+ * private void setSection(int section, double b0, double b1, double b2, double a1, double a2): Sets one section's target coefficients.
+ * private void stepRamp(): Advances the coefficient glide by one chunk.
+ * private void processConstant(SampleType* samples, int numSamples): Runs the wavefront or the sequential loop over a stretch with constant coefficients.
+ * private void processWavefront<int NumSections>(SampleType* samples, int numSamples): The block kernel for a fixed section count.
+ *
+ * Owned by
+ * - SignalProcessor
+ * - PitchTracker
+ */
+template <typename SampleType>
+class BiquadCascade
+{
+public:
+    /**
+     * The available filter alignments.
+     */
+    enum class Alignment {
+        /// Maximally flat passband, -3 dB at the cutoff.
+        butterworth,
+        /// Two cascaded Butterworth filters of half the order, -6 dB at the cutoff.
+        linkwitzRiley
+    };
+
+    /// <summary>
+    ///     The most sections a cascade can have: four lowpass and four highpass at order 8.
+    /// </summary>
+    static const int max_sections = 8;
+
+    /**
+     * The constructor for the BiquadCascade component.
+     *
+     * Defaults to a 2nd order Butterworth bandpass from 1000 Hz to 1000 Hz at 44100 Hz, matching the Filter defaults.
+     */
+    BiquadCascade();
+
+    /**
+     * Sets the number of input audio samples per second and redesigns the cascade.
+     *
+     * A new sampling frequency means a new stream, so the coefficients jump straight to the new design.
+     *
+     * Arguments
+     * ---------
+     * double freq: The new number of input audio samples per second.
+     */
+    void setSamplingFrequency(double freq);
+
+    /**
+     * Sets the cutoff frequency of the lowpass side. The coefficients glide to the new design.
+     *
+     * Arguments
+     * ---------
+     * double freq: The new cutoff frequency in Hz.
+     */
+    void setLowpass(double freq);
+
+    /**
+     * Sets the cutoff frequency of the highpass side. The coefficients glide to the new design.
+     *
+     * Arguments
+     * ---------
+     * double freq: The new cutoff frequency in Hz.
+     */
+    void setHighpass(double freq);
+
+    /**
+     * Sets the order of both sides of the bandpass.
+     *
+     * The number of sections changes with the order, so there is nothing to glide from: the cascade is reset.
+     *
+     * Arguments
+     * ---------
+     * int new_order: 2, 4 or 8. Other values are rounded to the nearest of those.
+     */
+    void setOrder(int new_order);
+
+    /**
+     * Selects a Butterworth or Linkwitz-Riley design. Resets the cascade.
+     *
+     * Arguments
+     * ---------
+     * Alignment new_alignment: The new alignment.
+     */
+    void setAlignment(Alignment new_alignment);
+
+    /**
+     * Sets how many samples the coefficients take to glide to a new design after a cutoff change.
+     *
+     * Arguments
+     * ---------
+     * int num_samples: The glide length. 0 makes changes take effect immediately.
+     */
+    void setSmoothingLength(int num_samples);
+
+    /**
+     * Clears the state of every section.
+     */
+    void reset();
+
+    /**
+     * Filters a block of samples in place.
+     *
+     * Arguments
+     * ---------
+     * SampleType* samples: The samples to filter. Overwritten with the output.
+     * int numSamples: The number of samples.
+     */
+    void process(SampleType* samples, int numSamples);
+
+    /**
+     * Filters a single sample, running the sections one after another.
+     *
+     * Used by SignalProcessor::takeInSample. Gives the same output as process.
+     *
+     * Arguments
+     * ---------
+     * SampleType sample: The next input sample.
+     *
+     * Returns
+     * -------
+     * SampleType: The next output sample.
+     */
+    SampleType processSample(SampleType sample);
+
+    /**
+     * Returns the number of sections in use for the current order and alignment.
+     *
+     * Returns
+     * -------
+     * int: The number of sections.
+     */
+    int getNumSections() const { return num_sections; };
+
+private:
+    /**
+     * Recomputes every section's coefficients from the cutoffs, order, alignment and sampling frequency.
+     *
+     * Arguments
+     * ---------
+     * bool glide: Whether the coefficients glide to the new design or jump straight to it.
+     */
+    void design(bool glide);
+
+    /**
+     * Sets the target coefficients of one section, normalised so that a0 is 1. design decides whether they glide in.
+     *
+     * Arguments
+     * ---------
+     * int section: The index of the section.
+     * double nb0, nb1, nb2: The feedforward coefficients.
+     * double na1, na2: The feedback coefficients.
+     */
+    void setSection(int section, double nb0, double nb1, double nb2, double na1, double na2);
+
+    /**
+     * Advances the coefficient glide by one chunk.
+     */
+    void stepRamp();
+
+    /**
+     * Filters a block in place with a wavefront over a fixed number of sections.
+     *
+     * Arguments
+     * ---------
+     * SampleType* samples: The samples to filter. Overwritten with the output.
+     * int numSamples: The number of samples.
+     */
+    template <int NumSections>
+    void processWavefront(SampleType* samples, int numSamples);
+
+    /**
+     * Runs process over a part of a block that uses constant coefficients.
+     *
+     * Arguments
+     * ---------
+     * SampleType* samples: The samples to filter. Overwritten with the output.
+     * int numSamples: The number of samples.
+     */
+    void processConstant(SampleType* samples, int numSamples);
+
+    /// <summary>
+    ///     An approximation of the pi constant for usage in calculations.
+    /// </summary>
+    const double pi = 3.1415926535;
+
+    /// <summary>
+    ///     The coefficients are stepped every ramp_chunk samples while gliding, rather than every sample, so the kernel
+    ///     never carries ramp increments. Any straight line between two stable biquads is stable, so every step is too.
+    /// </summary>
+    static const int ramp_chunk = 32;
+
+    /// <summary>
+    ///     The number of input audio samples per second.
+    /// </summary>
+    double sampling_frequency = 44100;
+    /// <summary>
+    ///     The cutoff frequency of the lowpass side in Hz.
+    /// </summary>
+    double lowpass_frequency = 1000;
+    /// <summary>
+    ///     The cutoff frequency of the highpass side in Hz.
+    /// </summary>
+    double highpass_frequency = 1000;
+    /// <summary>
+    ///     The order of each side. 2, 4 or 8.
+    /// </summary>
+    int order = 2;
+    /// <summary>
+    ///     Butterworth or Linkwitz-Riley.
+    /// </summary>
+    Alignment alignment = Alignment::butterworth;
+    /// <summary>
+    ///     The number of sections in use. The lowpass sections come first, then the highpass sections.
+    /// </summary>
+    int num_sections = 2;
+
+    /// <summary>
+    ///     The number of samples coefficient changes take to glide in.
+    /// </summary>
+    int smoothing_length = 0;
+    /// <summary>
+    ///     The number of samples left in the current glide. 0 when the coefficients are at their targets.
+    /// </summary>
+    int ramp_remaining = 0;
+
+    /// <summary>
+    ///     The coefficients in use, normalised so a0 is 1. One array per coefficient, indexed by section.
+    /// </summary>
+    SampleType b0[max_sections] = {}, b1[max_sections] = {}, b2[max_sections] = {}, a1[max_sections] = {}, a2[max_sections] = {};
+    /// <summary>
+    ///     How much each coefficient moves per chunk while gliding.
+    /// </summary>
+    SampleType step_b0[max_sections] = {}, step_b1[max_sections] = {}, step_b2[max_sections] = {}, step_a1[max_sections] = {}, step_a2[max_sections] = {};
+    /// <summary>
+    ///     The coefficients being glided to.
+    /// </summary>
+    SampleType target_b0[max_sections] = {}, target_b1[max_sections] = {}, target_b2[max_sections] = {}, target_a1[max_sections] = {}, target_a2[max_sections] = {};
+    /// <summary>
+    ///     The transposed direct form II state of each section.
+    /// </summary>
+    SampleType s1[max_sections] = {}, s2[max_sections] = {};
+};
@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    BiquadCascadeBenchmark.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: A standalone benchmark of the BiquadCascade block kernels. Times orders 2, 4 and 8 through process
+                 (the wavefront or the sequential loop, whichever processConstant picks) against processSample, and
+                 fails if process is slower for any of them, so the kernel choice can be checked on a new machine or
+                 compiler. Not part of the plugin build. From this directory:
+
+                     g++ -std=c++17 -O3 -o BiquadCascadeBenchmark BiquadCascadeBenchmark.cpp BiquadCascade.cpp
+
+    Dependencies:
+    - BiquadCascade.h
+    - algorithm
+    - chrono
+    - math.h
+    - stdio.h
+    - vector
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "BiquadCascade.h" // Import the interface definition for the BiquadCascade component being measured.
+#include <algorithm> // Imports the c++ stdlib algorithm libarary.
+#include <chrono> // Imports the c++ stdlib clocks used for timing.
+#include <math.h> // Imports the basic c stdlib math library
+#include <stdio.h> // Imports the c stdlib printf used for the report.
+#include <vector> // Imports the c++ stdlib vector container used for the test signal.
+
+/// <summary>
+///     The block size, a typical host buffer.
+/// </summary>
+static const int block_size = 512;
+/// <summary>
+///     The number of blocks timed per run: about 3.5 minutes of audio at 48 kHz.
+/// </summary>
+static const int num_blocks = 20000;
+/// <summary>
+///     The number of runs per case. The fastest is reported, to keep scheduler noise out.
+/// </summary>
+static const int num_runs = 5;
+/// <summary>
+///     The speedup below which process counts as slower than processSample. Leaves room for timing noise, since a
+///     cascade on the sequential loop is expected to tie.
+/// </summary>
+static const double slower_threshold = 0.9;
+
+/**
+ * Times one order in one mode, and leaves the output of the last block for comparison.
+ *
+ * Arguments
+ * ---------
+ * int order: The order of each side of the bandpass. 2, 4 or 8.
+ * bool use_process: Whether to filter with process or with processSample (one section after another).
+ * const std::vector<SampleType>& signal: The input, a whole number of blocks, looped over.
+ * std::vector<SampleType>& block: The buffer filtered in place. Holds the output of the last block afterwards.
+ *
+ * Returns
+ * -------
+ * double: The fastest run in milliseconds.
+ */
+template <typename SampleType>
+static double timeCase(int order, bool use_process, const std::vector<SampleType>& signal, std::vector<SampleType>& block)
+{
+    const int num_signal_blocks = (int) signal.size() / block_size;
+    double fastest = 1e30;
+    for (int run = 0; run < num_runs; ++run) {
+        // A fresh cascade per run, so every run filters the same samples from the same state.
+        BiquadCascade<SampleType> cascade;
+        cascade.setSamplingFrequency(48000);
+        cascade.setOrder(order);
+        cascade.setHighpass(100);
+        cascade.setLowpass(5000);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int index = 0; index < num_blocks; ++index) {
+            const auto first = signal.begin() + (index % num_signal_blocks) * block_size;
+            std::copy(first, first + block_size, block.begin());
+            if (use_process) {
+                cascade.process(block.data(), block_size);
+            } else {
+                for (int sample = 0; sample < block_size; ++sample) {
+                    block[sample] = cascade.processSample(block[sample]);
+                }
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+        fastest = std::min(fastest, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return fastest;
+}
+
+/**
+ * Runs every order in both modes for one sample type and prints the report.
+ *
+ * Arguments
+ * ---------
+ * const char* name: The name of the sample type, for the report.
+ *
+ * Returns
+ * -------
+ * bool: True if process was at least as fast as processSample, within the noise allowance, at every order.
+ */
+template <typename SampleType>
+static bool runBenchmark(const char* name)
+{
+    // A low and a high partial, so both sides of the bandpass have something to do. Generated up front so the
+    // timing is the filter alone.
+    std::vector<SampleType> signal(16 * block_size);
+    for (size_t index = 0; index < signal.size(); ++index) {
+        signal[index] = (SampleType) (0.5 * sin(0.01 * index) + 0.25 * sin(0.37 * index));
+    }
+    std::vector<SampleType> process_block(block_size), sequential_block(block_size);
+    bool passed = true;
+
+    printf("%s, %d-sample blocks, %d blocks, fastest of %d runs:\n", name, block_size, num_blocks, num_runs);
+    for (int order : { 2, 4, 8 }) {
+        const double process_time = timeCase(order, true, signal, process_block);
+        const double sequential_time = timeCase(order, false, signal, sequential_block);
+        const double speedup = sequential_time / process_time;
+        const bool slower = speedup < slower_threshold;
+        passed = passed && !slower;
+
+        // Both modes must agree, or the timing means nothing.
+        double difference = 0;
+        for (int sample = 0; sample < block_size; ++sample) {
+            difference = std::max(difference, fabs((double) (process_block[sample] - sequential_block[sample])));
+        }
+
+        printf("  order %d: process %7.1f ms, processSample %7.1f ms, speedup %.2fx, max difference %g: %s\n",
+               order, process_time, sequential_time, speedup, difference, slower ? "SLOWER" : "ok");
+    }
+    return passed;
+}
+
+int main()
+{
+    // Run both, so one failure doesn't hide the other.
+    const bool float_passed = runBenchmark<float>("float");
+    const bool double_passed = runBenchmark<double>("double");
+    return float_passed && double_passed ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    DelayLine.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the DelayLine component class.
+    Dependencies:
+    - DelayLine.h
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "DelayLine.h" // Import the interface definition for the DelayLine component for implementation.
+
+/**
+ * Allocates the ring for the given number of channels and the longest delay, and clears it.
+ *
+ * Allocates memory, so should only be called from prepareToPlay.
+ *
+ * Arguments
+ * ---------
+ * int new_num_channels: The most channels process will be given.
+ * int max_delay: The longest delay in samples.
+ */
+template <typename SampleType>
+void DelayLine<SampleType>::prepare(int new_num_channels, int max_delay)
+{
+    num_channels = std::max(new_num_channels, 0);
+    capacity = std::max(max_delay, 0) + 1;
+    ring.assign((size_t) num_channels * capacity, (SampleType) 0);
+    delay = std::min(delay, capacity - 1);
+    write_index = 0;
+}
+
+/**
+ * Sets the delay in samples.
+ *
+ * Arguments
+ * ---------
+ * int new_delay: The new delay. Clamped to between 0 and the max_delay passed to prepare.
+ */
+template <typename SampleType>
+void DelayLine<SampleType>::setDelay(int new_delay)
+{
+    const bool was_delaying = delay > 0;
+    delay = std::min(std::max(new_delay, 0), capacity - 1);
+    if (!was_delaying && delay > 0) {
+        // Nothing is written while the delay is 0, so don't replay audio from before it was.
+        reset();
+    }
+}
+
+/**
+ * Clears the ring.
+ */
+template <typename SampleType>
+void DelayLine<SampleType>::reset()
+{
+    std::fill(ring.begin(), ring.end(), (SampleType) 0);
+    write_index = 0;
+}
+
+/**
+ * Delays a block of samples in place. Does nothing while the delay is 0.
+ *
+ * Arguments
+ * ---------
+ * SampleType* const* channels: One write pointer per channel. Overwritten with the delayed samples.
+ * int numChannels: The number of channels. Channels past the number passed to prepare are left alone.
+ * int numSamples: The number of samples in each channel.
+ */
+template <typename SampleType>
+void DelayLine<SampleType>::process(SampleType* const* channels, int numChannels, int numSamples)
+{
+    if (delay == 0) {
+        return;
+    }
+    numChannels = std::min(numChannels, num_channels);
+    for (int channel = 0; channel < numChannels; ++channel) {
+        SampleType* samples = channels[channel];
+        SampleType* channel_ring = ring.data() + (size_t) channel * capacity;
+        int write = write_index;
+        int read = write - delay;
+        if (read < 0) {
+            read += capacity;
+        }
+        for (int index = 0; index < numSamples; ++index) {
+            channel_ring[write] = samples[index];
+            samples[index] = channel_ring[read];
+            if (++write == capacity) {
+                write = 0;
+            }
+            if (++read == capacity) {
+                read = 0;
+            }
+        }
+    }
+    write_index = (int) ((write_index + (long long) numSamples) % capacity);
+}
+
+// The plugin uses both precisions, depending on what the host asks for.
+template class DelayLine<float>;
+template class DelayLine<double>;
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    DelayLine.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition of the DelayLine component class, a multichannel delay of a whole
+                 number of samples backed by a preallocated ring.
+    Dependencies:
+    - algorithm
+    - vector
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <algorithm> // Imports the c++ stdlib algorithm libarary.
+#include <vector> // Imports the c++ stdlib vector container used for the preallocated ring.
+
+/**
+ * Delays every channel of a block by the same whole number of samples.
+ *
+ * Used to hold the audio back by the lookahead, so that once the host compensates for the reported latency the
+ * audio lines up with the envelope again. The ring is allocated by prepare for the longest delay, so changing the
+ * delay and processing never allocate. All channels share one write position, and each channel's ring is a
+ * contiguous run of the shared buffer.
+ *
+ * Attributes
+ * ----------
+ * private std::vector<SampleType> ring: The delayed samples, capacity per channel, one channel after another.
+ * private int num_channels: The number of channels the ring has room for.
+ * private int capacity: The ring length per channel, one more than the longest delay.
+ * private int delay: The current delay in samples.
+ * private int write_index: The ring index the next sample of every channel is written to.
+ *
+ * Methods
+ * -------
+ * public void prepare(int new_num_channels, int max_delay): Allocates the ring for the given channels and longest delay, and clears it.
+ * public void setDelay(int new_delay): Sets the delay in samples.
+ * public void reset(): Clears the ring.
+ * public void process(SampleType* const* channels, int numChannels, int numSamples): Delays a block in place.
+ * public int getDelay(): Returns the delay in samples.
+ *
+ * Owned by
+ * - SignalProcessor
+ */
+template <typename SampleType>
+class DelayLine
+{
+public:
+    /**
+     * Allocates the ring for the given number of channels and the longest delay, and clears it.
+     *
+     * Allocates memory, so should only be called from prepareToPlay.
+     *
+     * Arguments
+     * ---------
+     * int new_num_channels: The most channels process will be given.
+     * int max_delay: The longest delay in samples.
+     */
+    void prepare(int new_num_channels, int max_delay);
+
+    /**
+     * Sets the delay in samples.
+     *
+     * While delaying, the ring always holds the last max_delay samples, so a new delay reads them straight away.
+     * Turning the delay on from 0 clears the ring, since nothing is written while the delay is 0.
+     *
+     * Arguments
+     * ---------
+     * int new_delay: The new delay. Clamped to between 0 and the max_delay passed to prepare.
+     */
+    void setDelay(int new_delay);
+
+    /**
+     * Clears the ring.
+     */
+    void reset();
+
+    /**
+     * Delays a block of samples in place. Does nothing while the delay is 0.
+     *
+     * Arguments
+     * ---------
+     * SampleType* const* channels: One write pointer per channel. Overwritten with the delayed samples.
+     * int numChannels: The number of channels. Channels past the number passed to prepare are left alone.
+     * int numSamples: The number of samples in each channel.
+     */
+    void process(SampleType* const* channels, int numChannels, int numSamples);
+
+    /**
+     * Returns the delay in samples.
+     *
+     * Returns
+     * -------
+     * int: The delay.
+     */
+    int getDelay() const { return delay; };
+
+private:
+    /// <summary>
+    ///     The delayed samples, capacity per channel, one channel after another.
+    /// </summary>
+    std::vector<SampleType> ring;
+    /// <summary>
+    ///     The number of channels the ring has room for.
+    /// </summary>
+    int num_channels = 0;
+    /// <summary>
+    ///     The ring length per channel, one more than the longest delay.
+    /// </summary>
+    int capacity = 1;
+    /// <summary>
+    ///     The current delay in samples.
+    /// </summary>
+    int delay = 0;
+    /// <summary>
+    ///     The ring index the next sample of every channel is written to.
+    /// </summary>
+    int write_index = 0;
+};
@@ -0,0 +1,374 @@
+/*
+  ==============================================================================
+
+    EnvelopeBank.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the EnvelopeBank component class.
+    Dependencies:
+    - EnvelopeBank.h
+    - algorithm
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "EnvelopeBank.h" // Import the interface definition for the EnvelopeBank component for implementation.
+#include <algorithm> // Imports the c++ stdlib algorithm libarary.
+
+/**
+ * The constructor for the EnvelopeBank component.
+ *
+ * The bank starts with no lanes. Call prepare before processing.
+ */
+template <typename SampleType>
+EnvelopeBank<SampleType>::EnvelopeBank()
+{
+}
+
+/**
+ * Allocates the lane arrays and the interleaved block buffer, and resets every lane to the SignalProcessor defaults.
+ *
+ * Allocates memory, so should only be called from prepareToPlay.
+ *
+ * Arguments
+ * ---------
+ * int num_lanes: The number of independent chains.
+ * int max_block_size: The largest number of samples processBlock will receive at once.
+ */
+template <typename SampleType>
+void EnvelopeBank<SampleType>::prepare(int new_num_lanes, int new_max_block_size)
+{
+    num_lanes = std::max(new_num_lanes, 0);
+    max_block_size = std::max(new_max_block_size, 0);
+    // Round up to whole registers so the kernel never needs a scalar tail.
+    lane_stride = (num_lanes + LaneVector<SampleType>::width - 1) / LaneVector<SampleType>::width * LaneVector<SampleType>::width;
+    active_lanes = num_lanes;
+    active_stride = lane_stride;
+
+    // Defaults match a freshly constructed SignalProcessor.
+    lowpass_frequency.assign(lane_stride, 1000.0f);
+    highpass_frequency.assign(lane_stride, 1000.0f);
+    recovery_time.assign(lane_stride, 0);
+    bandpass.assign(lane_stride, false);
+    gain.assign(lane_stride, 1);
+    decay.assign(lane_stride, 0);
+
+    for (int section = 0; section < 2; ++section) {
+        b0[section].assign(lane_stride, 0);
+        b1[section].assign(lane_stride, 0);
+        b2[section].assign(lane_stride, 0);
+        a1[section].assign(lane_stride, 0);
+        a2[section].assign(lane_stride, 0);
+        s1[section].assign(lane_stride, 0);
+        s2[section].assign(lane_stride, 0);
+    }
+    envelope.assign(lane_stride, 0);
+
+    interleaved.assign((size_t) max_block_size * lane_stride, 0);
+
+    for (int lane = 0; lane < lane_stride; ++lane) {
+        calcLaneFilter(lane);
+        calcLaneDecay(lane);
+    }
+}
+
+/**
+ * Sets the number of input audio samples this component should expect per second and rebuilds every lane's coefficients.
+ *
+ * Arguments
+ * ---------
+ * double freq: The new number of input audio samples per second.
+ */
+template <typename SampleType>
+void EnvelopeBank<SampleType>::setSamplingFrequency(double freq)
+{
+    sampling_frequency = freq;
+    for (int lane = 0; lane < lane_stride; ++lane) {
+        calcLaneFilter(lane);
+        calcLaneDecay(lane);
+    }
+}
+
+/**
+ * Sets the scaling factor applied to one lane's input samples.
+ *
+ * Arguments
+ * ---------
+ * int lane: The index of the lane to update.
+ * float new_gain: The new linear scaling factor.
+ */
+template <typename SampleType>
+void EnvelopeBank<SampleType>::setLaneGain(int lane, float new_gain)
+{
+    gain[lane] = (SampleType) new_gain;
+}
+
+/**
+ * Sets the cutoff frequency of one lane's lowpass filter, and makes the lane's filter the one-pole pair again.
+ *
+ * Arguments
+ * ---------
+ * int lane: The index of the lane to update.
+ * float lp_val: The new cutoff frequency in Hz.
+ */
+template <typename SampleType>
+void EnvelopeBank<SampleType>::setLaneLowpass(int lane, float lp_val)
+{
+    lowpass_frequency[lane] = lp_val;
+    bandpass[lane] = false;
+    calcLaneFilter(lane);
+}
+
+/**
+ * Sets the cutoff frequency of one lane's highpass filter, and makes the lane's filter the one-pole pair again.
+ *
+ * Arguments
+ * ---------
+ * int lane: The index of the lane to update.
+ * float hp_val: The new cutoff frequency in Hz.
+ */
+template <typename SampleType>
+void EnvelopeBank<SampleType>::setLaneHighpass(int lane, float hp_val)
+{
+    highpass_frequency[lane] = hp_val;
+    bandpass[lane] = false;
+    calcLaneFilter(lane);
+}
+
+/**
+ * Makes one lane's filter a fourth-order bandpass between two edges.
+ *
+ * Arguments
+ * ---------
+ * int lane: The index of the lane to update.
+ * float lower_edge: The lower -3 dB frequency in Hz.
+ * float upper_edge: The upper -3 dB frequency in Hz. Above lower_edge.
+ */
+template <typename SampleType>
+void EnvelopeBank<SampleType>::setLaneBandpass(int lane, float lower_edge, float upper_edge)
+{
+    highpass_frequency[lane] = lower_edge;
+    lowpass_frequency[lane] = upper_edge;
+    bandpass[lane] = true;
+    calcLaneFilter(lane);
+}
+
+/**
+ * Sets one lane's gain, one-pole cutoffs and recovery time together, rebuilding its coefficients once.
+ *
+ * Arguments
+ * ---------
+ * int lane: The index of the lane to update.
+ * float new_gain: The new linear scaling factor.
+ * float lp_val: The new lowpass cutoff frequency in Hz.
+ * float hp_val: The new highpass cutoff frequency in Hz.
+ * float new_recovery_time: The new half-life in seconds.
+ */
+template <typename SampleType>
+void EnvelopeBank<SampleType>::setLaneSettings(int lane, float new_gain, float lp_val, float hp_val, float new_recovery_time)
+{
+    gain[lane] = (SampleType) new_gain;
+    lowpass_frequency[lane] = lp_val;
+    highpass_frequency[lane] = hp_val;
+    recovery_time[lane] = new_recovery_time;
+    bandpass[lane] = false;
+    calcLaneFilter(lane);
+    calcLaneDecay(lane);
+}
+
+/**
+ * Sets the amount of time one lane's envelope takes to decay to half of its value. At least 1ms, as in SignalProcessor.
+ *
+ * Arguments
+ * ---------
+ * int lane: The index of the lane to update.
+ * float new_recovery_time: The new half-life in seconds.
+ */
+template <typename SampleType>
+void EnvelopeBank<SampleType>::setLaneRecoveryTime(int lane, float new_recovery_time)
+{
+    recovery_time[lane] = new_recovery_time;
+    calcLaneDecay(lane);
+}
+
+/**
+ * Limits processBlock to the first count lanes.
+ *
+ * Arguments
+ * ---------
+ * int count: The number of lanes to advance. Clamped to between 0 and the number of lanes passed to prepare.
+ */
+template <typename SampleType>
+void EnvelopeBank<SampleType>::setActiveLanes(int count)
+{
+    active_lanes = std::min(std::max(count, 0), num_lanes);
+    active_stride = std::min((active_lanes + LaneVector<SampleType>::width - 1) / LaneVector<SampleType>::width * LaneVector<SampleType>::width, lane_stride);
+}
+
+/**
+ * Rebuilds one lane's filter coefficients from its cutoffs and the sampling frequency.
+ *
+ * Arguments
+ * ---------
+ * int lane: The index of the lane to update.
+ */
+template <typename SampleType>
+void EnvelopeBank<SampleType>::calcLaneFilter(int lane)
+{
+    if (bandpass[lane]) {
+        // Two identical RBJ cookbook bandpass sections (0 dB at the centre). Each is -1.5 dB at the edges when
+        // Q * (e - 1/e) = sqrt(sqrt(2) - 1), where e is the ratio of the upper edge to the centre.
+        // Keep the centre strictly inside (0, nyquist) so the sections stay stable.
+        const double lower = std::max((double) highpass_frequency[lane], 1.0);
+        const double upper = std::max((double) lowpass_frequency[lane], lower * 1.01);
+        const double centre = std::min(sqrt(lower * upper), 0.49 * sampling_frequency);
+        const double edge_ratio = sqrt(upper / lower);
+        const double q = sqrt(sqrt(2.0) - 1.0) / (edge_ratio - 1.0 / edge_ratio);
+        const double w0 = 2.0 * pi * centre / sampling_frequency;
+        const double alpha = sin(w0) / (2.0 * q);
+        const double a0 = 1.0 + alpha;
+        for (int section = 0; section < 2; ++section) {
+            setLaneSection(lane, section, alpha / a0, 0.0, -alpha / a0, -2.0 * cos(w0) / a0, (1.0 - alpha) / a0);
+        }
+    } else {
+        // Same bilinear one-pole design as Filter::calc_coeff, as first-order sections.
+        double lp_k = tan(pi * lowpass_frequency[lane] / sampling_frequency);
+        double lp_alpha = 1 + lp_k;
+        setLaneSection(lane, 0, lp_k / lp_alpha, lp_k / lp_alpha, 0.0, -(1.0 - lp_k) / lp_alpha, 0.0);
+
+        double hp_k = tan(pi * highpass_frequency[lane] / sampling_frequency);
+        double hp_alpha = 1 + hp_k;
+        setLaneSection(lane, 1, 1.0 / hp_alpha, -1.0 / hp_alpha, 0.0, -(1.0 - hp_k) / hp_alpha, 0.0);
+    }
+}
+
+/**
+ * Rebuilds one lane's decay from its recovery time and the sampling frequency.
+ *
+ * Arguments
+ * ---------
+ * int lane: The index of the lane to update.
+ */
+template <typename SampleType>
+void EnvelopeBank<SampleType>::calcLaneDecay(int lane)
+{
+    // Same half-life formula as SignalProcessor::setRecoveryTimeValue.
+    double num_samples = fmax(recovery_time[lane], 0.001) * sampling_frequency;
+    decay[lane] = (SampleType) pow(2, (-1 / num_samples));
+}
+
+/**
+ * Sets the coefficients of one of a lane's filter sections, normalised so that a0 is 1.
+ *
+ * Arguments
+ * ---------
+ * int lane: The index of the lane.
+ * int section: 0 for the first section, 1 for the second.
+ * double nb0, nb1, nb2: The feedforward coefficients.
+ * double na1, na2: The feedback coefficients.
+ */
+template <typename SampleType>
+void EnvelopeBank<SampleType>::setLaneSection(int lane, int section, double nb0, double nb1, double nb2, double na1, double na2)
+{
+    b0[section][lane] = (SampleType) nb0;
+    b1[section][lane] = (SampleType) nb1;
+    b2[section][lane] = (SampleType) nb2;
+    a1[section][lane] = (SampleType) na1;
+    a2[section][lane] = (SampleType) na2;
+}
+
+/**
+ * Advances every lane by a block of input samples.
+ *
+ * Arguments
+ * ---------
+ * const SampleType* const* inputs: One read pointer per active lane. Several lanes may share the same pointer.
+ * int numSamples: The number of samples to read from each input. At most the max_block_size passed to prepare.
+ */
+template <typename SampleType>
+void EnvelopeBank<SampleType>::processBlock(const SampleType* const* inputs, int numSamples)
+{
+    numSamples = std::min(numSamples, max_block_size);
+    SampleType* block = interleaved.data();
+
+    // Transpose the inputs to [sample][lane]. The padding lanes keep whatever they held and are never read back.
+    for (int lane = 0; lane < active_lanes; ++lane) {
+        const SampleType* input = inputs[lane];
+        for (int index = 0; index < numSamples; ++index) {
+            block[(size_t) index * lane_stride + lane] = input[index];
+        }
+    }
+
+    // Most banks are all one-pole lanes, which can skip the second-order terms.
+    if (std::find(bandpass.begin(), bandpass.begin() + active_stride, true) != bandpass.begin() + active_stride) {
+        processGroups<true>(block, numSamples);
+    } else {
+        processGroups<false>(block, numSamples);
+    }
+}
+
+/**
+ * Runs the filter and envelope kernel over the transposed block, one register of lanes at a time, in place.
+ *
+ * Arguments
+ * ---------
+ * SampleType* block: The input block transposed to [sample][lane]. Overwritten with the envelope trace.
+ * int numSamples: The number of samples in the block.
+ */
+template <typename SampleType>
+template <bool SecondOrder>
+void EnvelopeBank<SampleType>::processGroups(SampleType* block, int numSamples)
+{
+    typedef LaneVector<SampleType> V;
+
+    // Each group of width lanes is an independent set of recurrences. Keep the group's
+    // coefficients and state in registers for the whole block.
+    for (int group = 0; group < active_stride; group += V::width) {
+        const typename V::Register group_gain = V::load(&gain[group]);
+        const typename V::Register group_decay = V::load(&decay[group]);
+        typename V::Register group_b0[2], group_b1[2], group_b2[2], group_a1[2], group_a2[2], z1[2], z2[2];
+        for (int section = 0; section < 2; ++section) {
+            group_b0[section] = V::load(&b0[section][group]);
+            group_b1[section] = V::load(&b1[section][group]);
+            group_b2[section] = V::load(&b2[section][group]);
+            group_a1[section] = V::load(&a1[section][group]);
+            group_a2[section] = V::load(&a2[section][group]);
+            z1[section] = V::load(&s1[section][group]);
+            z2[section] = V::load(&s2[section][group]);
+        }
+        typename V::Register env = V::load(&envelope[group]);
+
+        SampleType* lanes = block + group;
+        for (int index = 0; index < numSamples; ++index, lanes += lane_stride) {
+            typename V::Register x = V::mul(V::load(lanes), group_gain);
+
+            // The two filter sections, in transposed direct form II. First-order sections have no b2, a2 or z2.
+            for (int section = 0; section < 2; ++section) {
+                const typename V::Register y = V::add(V::mul(group_b0[section], x), z1[section]);
+                if (SecondOrder) {
+                    z1[section] = V::add(V::sub(V::mul(group_b1[section], x), V::mul(group_a1[section], y)), z2[section]);
+                    z2[section] = V::sub(V::mul(group_b2[section], x), V::mul(group_a2[section], y));
+                } else {
+                    z1[section] = V::sub(V::mul(group_b1[section], x), V::mul(group_a1[section], y));
+                }
+                x = y;
+            }
+
+            // Rectify, decay, and keep whichever is larger.
+            env = V::max(V::mul(env, group_decay), V::abs(x));
+            V::store(lanes, env);
+        }
+
+        for (int section = 0; section < 2; ++section) {
+            V::store(&s1[section][group], z1[section]);
+            V::store(&s2[section][group], z2[section]);
+        }
+        V::store(&envelope[group], env);
+    }
+}
+
+// The plugin uses both precisions, depending on what the host asks for.
+template class EnvelopeBank<float>;
+template class EnvelopeBank<double>;
@@ -0,0 +1,539 @@
+/*
+  ==============================================================================
+
+    EnvelopeBank.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition for the EnvelopeBank component class and the LaneVector SIMD helpers it is built on.
+    Dependencies:
+    - vector
+    - math.h
+    - immintrin.h / emmintrin.h (when compiled with AVX-512, AVX2 or SSE2 enabled)
+
+  ==============================================================================
+*/
+
+// Ensure that this is only imported at most once. Ignore duplicate imports.
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <vector> // Imports the c++ stdlib vector container used for the lane arrays.
+#include <math.h> // Imports the basic c stdlib math library
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+ #include <immintrin.h> // Imports the AVX-512 and AVX2 intrinsics.
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h> // Imports the SSE2 intrinsics.
+ #define ENVELOPE_BANK_SSE2 1
+#endif
+
+/**
+ * A thin wrapper around the widest register of SampleType the compiler has been told it can use.
+ *
+ * Only declared here. The float and double specializations below hold 16/8/4 floats or 8/4/2 doubles
+ * with AVX-512, AVX2 and SSE2 respectively, and a single lane otherwise.
+ * Only the handful of operations the EnvelopeBank kernel needs are provided.
+ *
+ * Methods
+ * -------
+ * public static Register load(const SampleType* source): Loads width values from (unaligned) memory.
+ * public static void store(SampleType* destination, Register value): Stores width values to (unaligned) memory.
+ * public static Register broadcast(SampleType value): Fills every lane with the same value.
+ * public static Register add(Register a, Register b): Lane-wise a + b.
+ * public static Register sub(Register a, Register b): Lane-wise a - b.
+ * public static Register mul(Register a, Register b): Lane-wise a * b.
+ * public static Register max(Register a, Register b): Lane-wise maximum of a and b.
+ * public static Register abs(Register a): Lane-wise absolute value of a.
+ * public static Register sqrt(Register a): Lane-wise square root of a.
+ * public static Register copySign(Register magnitude, Register sign): Lane-wise magnitude with the sign of sign.
+ *
+ * Used by
+ * - EnvelopeBank
+ * - HilbertEnvelope
+ * - SignalProcessor
+ */
+template <typename SampleType>
+struct LaneVector;
+
+/**
+ * LaneVector for single precision samples.
+ */
+template <>
+struct LaneVector<float> {
+#if defined(__AVX512F__)
+    typedef __m512 Register;
+    static const int width = 16;
+    static Register load(const float* source) { return _mm512_loadu_ps(source); }
+    static void store(float* destination, Register value) { _mm512_storeu_ps(destination, value); }
+    static Register broadcast(float value) { return _mm512_set1_ps(value); }
+    static Register add(Register a, Register b) { return _mm512_add_ps(a, b); }
+    static Register sub(Register a, Register b) { return _mm512_sub_ps(a, b); }
+    static Register mul(Register a, Register b) { return _mm512_mul_ps(a, b); }
+    static Register max(Register a, Register b) { return _mm512_max_ps(a, b); }
+    static Register abs(Register a) { return _mm512_abs_ps(a); }
+    static Register sqrt(Register a) { return _mm512_sqrt_ps(a); }
+    static Register copySign(Register magnitude, Register sign) {
+        const __m512i mask = _mm512_set1_epi32((int) 0x80000000);
+        return _mm512_castsi512_ps(_mm512_or_si512(_mm512_andnot_si512(mask, _mm512_castps_si512(magnitude)), _mm512_and_si512(mask, _mm512_castps_si512(sign))));
+    }
+#elif defined(__AVX2__)
+    typedef __m256 Register;
+    static const int width = 8;
+    static Register load(const float* source) { return _mm256_loadu_ps(source); }
+    static void store(float* destination, Register value) { _mm256_storeu_ps(destination, value); }
+    static Register broadcast(float value) { return _mm256_set1_ps(value); }
+    static Register add(Register a, Register b) { return _mm256_add_ps(a, b); }
+    static Register sub(Register a, Register b) { return _mm256_sub_ps(a, b); }
+    static Register mul(Register a, Register b) { return _mm256_mul_ps(a, b); }
+    static Register max(Register a, Register b) { return _mm256_max_ps(a, b); }
+    static Register abs(Register a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static Register sqrt(Register a) { return _mm256_sqrt_ps(a); }
+    static Register copySign(Register magnitude, Register sign) {
+        const __m256 mask = _mm256_set1_ps(-0.0f);
+        return _mm256_or_ps(_mm256_andnot_ps(mask, magnitude), _mm256_and_ps(mask, sign));
+    }
+#elif defined(ENVELOPE_BANK_SSE2)
+    typedef __m128 Register;
+    static const int width = 4;
+    static Register load(const float* source) { return _mm_loadu_ps(source); }
+    static void store(float* destination, Register value) { _mm_storeu_ps(destination, value); }
+    static Register broadcast(float value) { return _mm_set1_ps(value); }
+    static Register add(Register a, Register b) { return _mm_add_ps(a, b); }
+    static Register sub(Register a, Register b) { return _mm_sub_ps(a, b); }
+    static Register mul(Register a, Register b) { return _mm_mul_ps(a, b); }
+    static Register max(Register a, Register b) { return _mm_max_ps(a, b); }
+    static Register abs(Register a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static Register sqrt(Register a) { return _mm_sqrt_ps(a); }
+    static Register copySign(Register magnitude, Register sign) {
+        const __m128 mask = _mm_set1_ps(-0.0f);
+        return _mm_or_ps(_mm_andnot_ps(mask, magnitude), _mm_and_ps(mask, sign));
+    }
+#else
+    typedef float Register;
+    static const int width = 1;
+    static Register load(const float* source) { return *source; }
+    static void store(float* destination, Register value) { *destination = value; }
+    static Register broadcast(float value) { return value; }
+    static Register add(Register a, Register b) { return a + b; }
+    static Register sub(Register a, Register b) { return a - b; }
+    static Register mul(Register a, Register b) { return a * b; }
+    static Register max(Register a, Register b) { return a > b ? a : b; }
+    static Register abs(Register a) { return fabsf(a); }
+    static Register sqrt(Register a) { return sqrtf(a); }
+    static Register copySign(Register magnitude, Register sign) { return copysignf(magnitude, sign); }
+#endif
+};
+
+/**
+ * LaneVector for double precision samples. Half as many lanes per register as LaneVector<float>.
+ */
+template <>
+struct LaneVector<double> {
+#if defined(__AVX512F__)
+    typedef __m512d Register;
+    static const int width = 8;
+    static Register load(const double* source) { return _mm512_loadu_pd(source); }
+    static void store(double* destination, Register value) { _mm512_storeu_pd(destination, value); }
+    static Register broadcast(double value) { return _mm512_set1_pd(value); }
+    static Register add(Register a, Register b) { return _mm512_add_pd(a, b); }
+    static Register sub(Register a, Register b) { return _mm512_sub_pd(a, b); }
+    static Register mul(Register a, Register b) { return _mm512_mul_pd(a, b); }
+    static Register max(Register a, Register b) { return _mm512_max_pd(a, b); }
+    static Register abs(Register a) { return _mm512_abs_pd(a); }
+    static Register sqrt(Register a) { return _mm512_sqrt_pd(a); }
+    static Register copySign(Register magnitude, Register sign) {
+        const __m512i mask = _mm512_set1_epi64((long long) 0x8000000000000000ULL);
+        return _mm512_castsi512_pd(_mm512_or_si512(_mm512_andnot_si512(mask, _mm512_castpd_si512(magnitude)), _mm512_and_si512(mask, _mm512_castpd_si512(sign))));
+    }
+#elif defined(__AVX2__)
+    typedef __m256d Register;
+    static const int width = 4;
+    static Register load(const double* source) { return _mm256_loadu_pd(source); }
+    static void store(double* destination, Register value) { _mm256_storeu_pd(destination, value); }
+    static Register broadcast(double value) { return _mm256_set1_pd(value); }
+    static Register add(Register a, Register b) { return _mm256_add_pd(a, b); }
+    static Register sub(Register a, Register b) { return _mm256_sub_pd(a, b); }
+    static Register mul(Register a, Register b) { return _mm256_mul_pd(a, b); }
+    static Register max(Register a, Register b) { return _mm256_max_pd(a, b); }
+    static Register abs(Register a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static Register sqrt(Register a) { return _mm256_sqrt_pd(a); }
+    static Register copySign(Register magnitude, Register sign) {
+        const __m256d mask = _mm256_set1_pd(-0.0);
+        return _mm256_or_pd(_mm256_andnot_pd(mask, magnitude), _mm256_and_pd(mask, sign));
+    }
+#elif defined(ENVELOPE_BANK_SSE2)
+    typedef __m128d Register;
+    static const int width = 2;
+    static Register load(const double* source) { return _mm_loadu_pd(source); }
+    static void store(double* destination, Register value) { _mm_storeu_pd(destination, value); }
+    static Register broadcast(double value) { return _mm_set1_pd(value); }
+    static Register add(Register a, Register b) { return _mm_add_pd(a, b); }
+    static Register sub(Register a, Register b) { return _mm_sub_pd(a, b); }
+    static Register mul(Register a, Register b) { return _mm_mul_pd(a, b); }
+    static Register max(Register a, Register b) { return _mm_max_pd(a, b); }
+    static Register abs(Register a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static Register sqrt(Register a) { return _mm_sqrt_pd(a); }
+    static Register copySign(Register magnitude, Register sign) {
+        const __m128d mask = _mm_set1_pd(-0.0);
+        return _mm_or_pd(_mm_andnot_pd(mask, magnitude), _mm_and_pd(mask, sign));
+    }
+#else
+    typedef double Register;
+    static const int width = 1;
+    static Register load(const double* source) { return *source; }
+    static void store(double* destination, Register value) { *destination = value; }
+    static Register broadcast(double value) { return value; }
+    static Register add(Register a, Register b) { return a + b; }
+    static Register sub(Register a, Register b) { return a - b; }
+    static Register mul(Register a, Register b) { return a * b; }
+    static Register max(Register a, Register b) { return a > b ? a : b; }
+    static Register abs(Register a) { return fabs(a); }
+    static Register sqrt(Register a) { return ::sqrt(a); }
+    static Register copySign(Register magnitude, Register sign) { return copysign(magnitude, sign); }
+#endif
+};
+
+/**
+ * A bank of independent gain -> filter -> peak envelope chains, one per lane.
+ *
+ * Each lane's filter is two biquad sections. By default they hold SignalProcessor's one-pole lowpass and highpass
+ * (as first-order sections), so a lane computes what SignalProcessor does for one input. setLaneBandpass turns them
+ * into a fourth-order constant-Q bandpass instead, for lanes that split one signal into bands.
+ * All parameters and state are stored structure-of-arrays, so LaneVector<SampleType>::width chains advance
+ * together with one vector instruction per step instead of one scalar recurrence per chain.
+ * Each lane has its own gain, filter and recovery time, so the lanes can be different
+ * channels of one signal, different instances, or differently filtered copies of the same signal.
+ * Templated on the sample type like SignalProcessor. Explicitly instantiated for float and double in EnvelopeBank.cpp.
+ *
+ * Attributes
+ * ----------
+ * private int num_lanes: The number of chains in the bank.
+ * private int lane_stride: num_lanes rounded up to a whole number of LaneVector<SampleType> registers.
+ * private int active_lanes: The number of lanes processBlock advances. The rest keep their state and are skipped.
+ * private int active_stride: active_lanes rounded up to a whole number of LaneVector<SampleType> registers.
+ * private int max_block_size: The largest block the interleaved buffer has room for.
+ * private double sampling_frequency: The number of input audio samples per second.
+ * private const double pi: An approximation of the irrational consant pi used for calculating the filter coefficients.
+ * private std::vector<float> lowpass_frequency, highpass_frequency, recovery_time: The per-lane user settings, kept so the coefficients can be rebuilt when the sampling frequency changes.
+ * private std::vector<bool> bandpass: Whether each lane's cutoffs are the edges of a bandpass rather than a one-pole pair.
+ * private std::vector<SampleType> gain, decay: The per-lane input scaling and envelope decay.
+ * private std::vector<SampleType> b0[2], b1[2], b2[2], a1[2], a2[2]: The per-lane coefficients of the two filter sections.
+ * private std::vector<SampleType> s1[2], s2[2], envelope: The per-lane state.
+ * private std::vector<SampleType> interleaved: The block of input samples transposed to [sample][lane], overwritten by the envelope trace.
+ *
+ * Methods
+ * -------
+ * public EnvelopeBank(): The constructor for this component. Starts with no lanes.
+ * public void prepare(int num_lanes, int max_block_size): Allocates the lane arrays and the interleaved block buffer.
+ * public void setSamplingFrequency(double freq): Sets the number of input audio samples per second and rebuilds every lane's coefficients.
+ * public void setLaneGain(int lane, float gain): Sets the scaling factor applied to one lane's input.
+ * public void setLaneLowpass(int lane, float lp_val): Sets one lane's lowpass cutoff frequency.
+ * public void setLaneHighpass(int lane, float hp_val): Sets one lane's highpass cutoff frequency.
+ * public void setLaneBandpass(int lane, float lower_edge, float upper_edge): Makes one lane's filter a fourth-order bandpass between two edges.
+ * public void setLaneSettings(int lane, float gain, float lp_val, float hp_val, float recovery_time): Sets all of one lane's one-pole settings at once.
+ * public void setLaneRecoveryTime(int lane, float recovery_time): Sets one lane's envelope half-life in seconds.
+ * public void setActiveLanes(int count): Limits processBlock to the first count lanes.
+ * public void processBlock(const SampleType* const* inputs, int numSamples): Advances every lane by a block of samples.
+ * public SampleType getEnvelope(int lane): Returns one lane's current envelope value.
+ * public void setLaneEnvelope(int lane, SampleType value): Sets one lane's current envelope value.
+ * public SampleType getEnvelopeTrace(int lane, int index): Returns one lane's envelope value after a given sample of the last block.
+ * public const SampleType* getLaneTrace(int lane): Returns where one lane's envelope after the first sample of the last block is.
+ * public int getTraceStride(): Returns the distance between one sample's envelope and the next in a lane's trace.
+ * public int getNumLanes(): Returns the number of chains in the bank.
+ * private void calcLaneFilter(int lane): Rebuilds one lane's filter coefficients from its cutoffs.
+ * private void calcLaneDecay(int lane): Rebuilds one lane's decay from its recovery time.
+ * private void setLaneSection(int lane, int section, double b0, double b1, double b2, double a1, double a2): Sets one filter section's coefficients.
+ * private void processGroups<bool SecondOrder>(SampleType* block, int numSamples): Runs the kernel over the transposed block, with or without the second-order terms.
+ */
+template <typename SampleType>
+class EnvelopeBank
+{
+public:
+    /**
+     * The constructor for the EnvelopeBank component.
+     *
+     * The bank starts with no lanes. Call prepare before processing.
+     */
+    EnvelopeBank();
+
+    /**
+     * Allocates the lane arrays and the interleaved block buffer, and resets every lane to the SignalProcessor defaults.
+     *
+     * Allocates memory, so should only be called from prepareToPlay.
+     *
+     * Arguments
+     * ---------
+     * int num_lanes: The number of independent chains.
+     * int max_block_size: The largest number of samples processBlock will receive at once.
+     */
+    void prepare(int num_lanes, int max_block_size);
+
+    /**
+     * Sets the number of input audio samples this component should expect per second and rebuilds every lane's coefficients.
+     *
+     * Arguments
+     * ---------
+     * double freq: The new number of input audio samples per second.
+     */
+    void setSamplingFrequency(double freq);
+
+    /**
+     * Sets the scaling factor applied to one lane's input samples.
+     *
+     * Arguments
+     * ---------
+     * int lane: The index of the lane to update.
+     * float new_gain: The new linear scaling factor.
+     */
+    void setLaneGain(int lane, float new_gain);
+
+    /**
+     * Sets the cutoff frequency of one lane's lowpass filter, and makes the lane's filter the one-pole pair again.
+     *
+     * Arguments
+     * ---------
+     * int lane: The index of the lane to update.
+     * float lp_val: The new cutoff frequency in Hz.
+     */
+    void setLaneLowpass(int lane, float lp_val);
+
+    /**
+     * Sets the cutoff frequency of one lane's highpass filter, and makes the lane's filter the one-pole pair again.
+     *
+     * Arguments
+     * ---------
+     * int lane: The index of the lane to update.
+     * float hp_val: The new cutoff frequency in Hz.
+     */
+    void setLaneHighpass(int lane, float hp_val);
+
+    /**
+     * Makes one lane's filter a fourth-order bandpass: two identical second-order bandpass sections centred on the
+     * geometric mean of the edges, with the Q that puts the pair 3 dB down at each edge. Neighbouring bands that share
+     * an edge cross there, and a band a whole band width away is about 9 dB down instead of the one-pole pair's 1 or 2.
+     *
+     * Arguments
+     * ---------
+     * int lane: The index of the lane to update.
+     * float lower_edge: The lower -3 dB frequency in Hz.
+     * float upper_edge: The upper -3 dB frequency in Hz. Above lower_edge.
+     */
+    void setLaneBandpass(int lane, float lower_edge, float upper_edge);
+
+    /**
+     * Sets one lane's gain, one-pole cutoffs and recovery time together, rebuilding its coefficients once rather than
+     * once per setting. Makes the lane's filter the one-pole pair.
+     *
+     * Arguments
+     * ---------
+     * int lane: The index of the lane to update.
+     * float new_gain: The new linear scaling factor.
+     * float lp_val: The new lowpass cutoff frequency in Hz.
+     * float hp_val: The new highpass cutoff frequency in Hz.
+     * float new_recovery_time: The new half-life in seconds.
+     */
+    void setLaneSettings(int lane, float new_gain, float lp_val, float hp_val, float new_recovery_time);
+
+    /**
+     * Sets the amount of time one lane's envelope takes to decay to half of its value. At least 1ms, as in SignalProcessor.
+     *
+     * Arguments
+     * ---------
+     * int lane: The index of the lane to update.
+     * float new_recovery_time: The new half-life in seconds.
+     */
+    void setLaneRecoveryTime(int lane, float new_recovery_time);
+
+    /**
+     * Limits processBlock to the first count lanes, so a bank prepared for the most lanes that could be needed
+     * only costs as much as the lanes in use. Never allocates, so it is safe to call while processing audio.
+     *
+     * Arguments
+     * ---------
+     * int count: The number of lanes to advance. Clamped to between 0 and the number of lanes passed to prepare.
+     */
+    void setActiveLanes(int count);
+
+    /**
+     * Advances every lane by a block of input samples.
+     *
+     * Arguments
+     * ---------
+     * const SampleType* const* inputs: One read pointer per active lane. Several lanes may share the same pointer.
+     * int numSamples: The number of samples to read from each input. At most the max_block_size passed to prepare.
+     */
+    void processBlock(const SampleType* const* inputs, int numSamples);
+
+    /**
+     * Returns one lane's current envelope value.
+     *
+     * Arguments
+     * ---------
+     * int lane: The index of the lane.
+     *
+     * Returns
+     * -------
+     * SampleType: The envelope value after the last processed sample.
+     */
+    SampleType getEnvelope(int lane) const { return envelope[lane]; }
+
+    /**
+     * Sets one lane's current envelope value, so a lane can take over from another envelope follower without a jump.
+     *
+     * Arguments
+     * ---------
+     * int lane: The index of the lane.
+     * SampleType value: The envelope value to continue from.
+     */
+    void setLaneEnvelope(int lane, SampleType value) { envelope[lane] = value; }
+
+    /**
+     * Returns one lane's envelope value after a given sample of the last processed block.
+     *
+     * Arguments
+     * ---------
+     * int lane: The index of the lane.
+     * int index: The index of the sample within the last block.
+     *
+     * Returns
+     * -------
+     * SampleType: The envelope value after that sample.
+     */
+    SampleType getEnvelopeTrace(int lane, int index) const { return interleaved[(size_t) index * lane_stride + lane]; }
+
+    /**
+     * Returns where one lane's envelope value after the first sample of the last processed block is. The value after
+     * each later sample is getTraceStride() further on, so a caller can read the trace without copying it out.
+     *
+     * Arguments
+     * ---------
+     * int lane: The index of the lane.
+     *
+     * Returns
+     * -------
+     * const SampleType*: The lane's envelope value after the first sample. Valid until the next processBlock.
+     */
+    const SampleType* getLaneTrace(int lane) const { return interleaved.data() + lane; }
+
+    /**
+     * Returns the distance between one sample's envelope value and the next in a lane's trace.
+     *
+     * Returns
+     * -------
+     * int: The number of lanes rounded up to whole registers.
+     */
+    int getTraceStride() const { return lane_stride; }
+
+    /**
+     * Returns the number of chains in the bank.
+     *
+     * Returns
+     * -------
+     * int: The number of lanes passed to prepare.
+     */
+    int getNumLanes() const { return num_lanes; }
+
+private:
+    /// <summary>
+    ///     The number of independent chains in the bank.
+    /// </summary>
+    int num_lanes = 0;
+    /// <summary>
+    ///     The number of lanes rounded up to a whole number of LaneVector<SampleType> registers. The padding lanes are processed but never read.
+    /// </summary>
+    int lane_stride = 0;
+    /// <summary>
+    ///     The number of lanes processBlock advances. The rest keep their state and are skipped.
+    /// </summary>
+    int active_lanes = 0;
+    /// <summary>
+    ///     The number of active lanes rounded up to a whole number of LaneVector<SampleType> registers.
+    /// </summary>
+    int active_stride = 0;
+    /// <summary>
+    ///     The largest block the interleaved buffer has room for.
+    /// </summary>
+    int max_block_size = 0;
+    /// <summary>
+    ///     The number of input audio samples per second.
+    /// </summary>
+    double sampling_frequency = 44100;
+    /// <summary>
+    ///     An approximation of the pi constant for usage in calculations.
+    /// </summary>
+    const double pi = 3.1415926535;
+
+    /// <summary>
+    ///     The per-lane user settings, kept so the coefficients can be rebuilt when the sampling frequency changes.
+    /// </summary>
+    std::vector<float> lowpass_frequency, highpass_frequency, recovery_time;
+
+    /// <summary>
+    ///     Whether each lane's lowpass_frequency and highpass_frequency are the edges of a bandpass rather than a one-pole pair.
+    /// </summary>
+    std::vector<bool> bandpass;
+
+    /// <summary>
+    ///     The per-lane input scaling and envelope decay.
+    /// </summary>
+    std::vector<SampleType> gain, decay;
+
+    /// <summary>
+    ///     The per-lane coefficients of the two filter sections, normalised so a0 is 1. One vector per coefficient
+    ///     and section. A one-pole lane has b2 = a2 = 0, with the same design as Filter::calculate_lpf and Filter::calculate_hpf.
+    /// </summary>
+    std::vector<SampleType> b0[2], b1[2], b2[2], a1[2], a2[2];
+
+    /// <summary>
+    ///     The per-lane transposed direct form II state of the two filter sections, and the envelope.
+    /// </summary>
+    std::vector<SampleType> s1[2], s2[2], envelope;
+
+    /// <summary>
+    ///     The input block transposed to [sample][lane] so each register load picks up one sample of width lanes.
+    ///     Overwritten in place by the envelope trace.
+    /// </summary>
+    std::vector<SampleType> interleaved;
+
+    /**
+     * Rebuilds one lane's filter coefficients from its cutoffs and the sampling frequency.
+     *
+     * Arguments
+     * ---------
+     * int lane: The index of the lane to update.
+     */
+    void calcLaneFilter(int lane);
+
+    /**
+     * Rebuilds one lane's decay from its recovery time and the sampling frequency.
+     *
+     * Arguments
+     * ---------
+     * int lane: The index of the lane to update.
+     */
+    void calcLaneDecay(int lane);
+
+    /**
+     * Sets the coefficients of one of a lane's filter sections, normalised so that a0 is 1.
+     *
+     * Arguments
+     * ---------
+     * int lane: The index of the lane.
+     * int section: 0 for the first section, 1 for the second.
+     * double nb0, nb1, nb2: The feedforward coefficients.
+     * double na1, na2: The feedback coefficients.
+     */
+    void setLaneSection(int lane, int section, double nb0, double nb1, double nb2, double na1, double na2);
+
+    /**
+     * Runs the filter and envelope kernel over the transposed block, one register of lanes at a time, in place.
+     *
+     * Arguments
+     * ---------
+     * SampleType* block: The input block transposed to [sample][lane]. Overwritten with the envelope trace.
+     * int numSamples: The number of samples in the block.
+     */
+    template <bool SecondOrder>
+    void processGroups(SampleType* block, int numSamples);
+};
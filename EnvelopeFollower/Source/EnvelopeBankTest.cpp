@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+    EnvelopeBankTest.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: A standalone test of the EnvelopeBank bandpass lanes. Lays out bands the way
+                 SignalProcessor::updateBands does, plays a sine at each band's centre, and checks that the band
+                 passes it and its neighbours reject it. Not part of the plugin build. From this directory:
+
+                     g++ -std=c++17 -O2 -o EnvelopeBankTest EnvelopeBankTest.cpp EnvelopeBank.cpp
+
+    Dependencies:
+    - EnvelopeBank.h
+    - algorithm
+    - math.h
+    - stdio.h
+    - vector
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "EnvelopeBank.h" // Import the interface definition for the EnvelopeBank component being tested.
+#include <algorithm> // Imports the c++ stdlib algorithm libarary.
+#include <math.h> // Imports the basic c stdlib math library
+#include <stdio.h> // Imports the c stdlib printf used for the report.
+#include <vector> // Imports the c++ stdlib vector container used for the test signal.
+
+/// <summary>
+///     The sampling frequency of the test signal.
+/// </summary>
+static const double sampling_frequency = 48000;
+/// <summary>
+///     The block size the bank is run with.
+/// </summary>
+static const int block_size = 512;
+/// <summary>
+///     The band layout checked: the most bands, over the default cutoffs.
+/// </summary>
+static const int num_bands = 16;
+static const double lowest = 20, highest = 20000;
+/// <summary>
+///     The limits, in dB relative to the sine's amplitude: the band the sine is centred in must pass it nearly
+///     untouched, the bands next to it must be this far down, and the bands two away further still.
+/// </summary>
+static const double own_band_floor = -1.0;
+static const double adjacent_ceiling = -6.0;
+static const double second_ceiling = -15.0;
+
+/**
+ * Plays a sine at one band's centre through every band and measures each band's settled envelope.
+ *
+ * Arguments
+ * ---------
+ * int centre_band: The band whose centre the sine is at.
+ * std::vector<double>& levels: Filled with each band's envelope peak over the last half second, in dB.
+ */
+template <typename SampleType>
+static void measureBands(int centre_band, std::vector<double>& levels)
+{
+    EnvelopeBank<SampleType> bank;
+    bank.prepare(num_bands, block_size);
+    bank.setSamplingFrequency(sampling_frequency);
+
+    // The same spacing as SignalProcessor::updateBands.
+    const double ratio = pow(highest / lowest, 1.0 / num_bands);
+    double lower_edge = lowest;
+    double centre = 0;
+    for (int band = 0; band < num_bands; ++band) {
+        const double upper_edge = lower_edge * ratio;
+        bank.setLaneBandpass(band, (float) lower_edge, (float) upper_edge);
+        bank.setLaneRecoveryTime(band, 0.05f);
+        if (band == centre_band) {
+            centre = sqrt(lower_edge * upper_edge);
+        }
+        lower_edge = upper_edge;
+    }
+
+    // Two seconds, long enough for the narrowest band to settle. Measure over the last half.
+    const int num_blocks = (int) (2 * sampling_frequency) / block_size;
+    const int first_measured = num_blocks * 3 / 4;
+    std::vector<SampleType> block(block_size);
+    std::vector<const SampleType*> inputs(num_bands, block.data());
+    std::vector<double> peaks(num_bands, 0);
+    long position = 0;
+    for (int index = 0; index < num_blocks; ++index) {
+        for (int sample = 0; sample < block_size; ++sample, ++position) {
+            block[sample] = (SampleType) sin(2 * 3.141592653589793 * centre * position / sampling_frequency);
+        }
+        bank.processBlock(inputs.data(), block_size);
+        if (index >= first_measured) {
+            for (int band = 0; band < num_bands; ++band) {
+                for (int sample = 0; sample < block_size; ++sample) {
+                    peaks[band] = std::max(peaks[band], (double) bank.getEnvelopeTrace(band, sample));
+                }
+            }
+        }
+    }
+    for (int band = 0; band < num_bands; ++band) {
+        levels[band] = 20 * log10(std::max(peaks[band], 1e-12));
+    }
+}
+
+/**
+ * Checks every band for one sample type and prints the report.
+ *
+ * Arguments
+ * ---------
+ * const char* name: The name of the sample type, for the report.
+ *
+ * Returns
+ * -------
+ * bool: True if every band met every limit.
+ */
+template <typename SampleType>
+static bool runTest(const char* name)
+{
+    bool passed = true;
+    std::vector<double> levels(num_bands);
+    printf("%s, %d bands from %g Hz to %g Hz, sine at each band's centre, levels in dB:\n", name, num_bands, lowest, highest);
+    for (int centre_band = 0; centre_band < num_bands; ++centre_band) {
+        measureBands<SampleType>(centre_band, levels);
+        bool band_passed = levels[centre_band] >= own_band_floor;
+        double adjacent = -1000, second = -1000;
+        for (int band = 0; band < num_bands; ++band) {
+            const int distance = std::abs(band - centre_band);
+            if (distance == 1) {
+                adjacent = std::max(adjacent, levels[band]);
+            } else if (distance >= 2) {
+                second = std::max(second, levels[band]);
+            }
+        }
+        band_passed = band_passed && adjacent <= adjacent_ceiling && second <= second_ceiling;
+        passed = passed && band_passed;
+        printf("  band %2d: own %6.2f, loudest adjacent %6.2f, loudest other %6.2f: %s\n",
+               centre_band, levels[centre_band], adjacent, second, band_passed ? "ok" : "FAILED");
+    }
+    return passed;
+}
+
+int main()
+{
+    // Run both, so one failure doesn't hide the other.
+    const bool float_passed = runTest<float>("float");
+    const bool double_passed = runTest<double>("double");
+    return float_passed && double_passed ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+
+    HilbertEnvelope.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the setup and block methods of the HilbertEnvelope component class.
+    Dependencies:
+    - HilbertEnvelope.h
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "HilbertEnvelope.h" // Import the interface definition for the HilbertEnvelope component for implementation.
+
+/**
+ * The constructor for the HilbertEnvelope component.
+ *
+ * Lays the section coefficients of the two chains out in lanes, and clears the state. The padding lanes get a
+ * coefficient of 0, which keeps them at 0.
+ */
+template <typename SampleType>
+HilbertEnvelope<SampleType>::HilbertEnvelope()
+{
+    // The a of each section. The first chain is the one with the extra sample of delay.
+    const double first_chain[num_sections] = { 0.6923878, 0.9360654322959, 0.9882295226860, 0.9987488452737 };
+    const double second_chain[num_sections] = { 0.4021921162426, 0.8561710882420, 0.9722909545651, 0.9952884791278 };
+
+    for (int section = 0; section < num_sections; ++section) {
+        std::fill(coefficients[section], coefficients[section] + lane_stride, (SampleType) 0);
+        coefficients[section][0] = (SampleType) (first_chain[section] * first_chain[section]);
+        coefficients[section][1] = (SampleType) (second_chain[section] * second_chain[section]);
+    }
+    reset();
+}
+
+/**
+ * Clears the state.
+ */
+template <typename SampleType>
+void HilbertEnvelope<SampleType>::reset()
+{
+    for (int bank = 0; bank < 2; ++bank) {
+        for (int signal = 0; signal <= num_sections; ++signal) {
+            std::fill(state[bank][signal], state[bank][signal] + lane_stride, (SampleType) 0);
+        }
+    }
+    std::fill(outputs, outputs + lane_stride, (SampleType) 0);
+    delayed_real = 0;
+    parity = 0;
+}
+
+/**
+ * Replaces each sample of a block with the magnitude of the analytic signal.
+ *
+ * Arguments
+ * ---------
+ * SampleType* samples: The input samples. Overwritten with the instantaneous amplitude.
+ * int numSamples: The number of samples.
+ */
+template <typename SampleType>
+void HilbertEnvelope<SampleType>::process(SampleType* samples, int numSamples)
+{
+    typedef LaneVector<SampleType> V;
+    typedef typename V::Register Register;
+
+    // Without SIMD the two chains take a register each, so go through processSample.
+    if (lane_stride != V::width) {
+        for (int index = 0; index < numSamples; ++index) {
+            samples[index] = processSample(samples[index]);
+        }
+        return;
+    }
+
+    // Hold the coefficients and both state banks in registers for the whole block.
+    Register a[num_sections];
+    Register banks[2][num_sections + 1];
+    for (int section = 0; section < num_sections; ++section) {
+        a[section] = V::load(coefficients[section]);
+    }
+    for (int bank = 0; bank < 2; ++bank) {
+        for (int signal = 0; signal <= num_sections; ++signal) {
+            banks[bank][signal] = V::load(state[bank][signal]);
+        }
+    }
+
+    // Runs one sample through both chains against one bank, and returns the chain outputs.
+    auto tick = [&a](Register (&bank)[num_sections + 1], SampleType sample) {
+        Register signal = V::broadcast(sample);
+        for (int section = 0; section < num_sections; ++section) {
+            const Register output = V::sub(V::mul(a[section], V::add(signal, bank[section + 1])), bank[section]);
+            bank[section] = signal;
+            signal = output;
+        }
+        bank[num_sections] = signal;
+        return signal;
+    };
+
+    SampleType real = delayed_real;
+    int index = 0;
+    // Unroll by the two parities, so each sample in the loop always uses the same bank and both stay in registers.
+    Register (&first)[num_sections + 1] = banks[parity];
+    Register (&second)[num_sections + 1] = banks[parity ^ 1];
+    for (; index + 1 < numSamples; index += 2) {
+        V::store(outputs, tick(first, samples[index]));
+        const SampleType first_real = outputs[0];
+        const SampleType first_imaginary = outputs[1];
+        V::store(outputs, tick(second, samples[index + 1]));
+        samples[index] = (SampleType) sqrt(real * real + first_imaginary * first_imaginary);
+        samples[index + 1] = (SampleType) sqrt(first_real * first_real + outputs[1] * outputs[1]);
+        real = outputs[0];
+    }
+    if (index < numSamples) {
+        V::store(outputs, tick(first, samples[index]));
+        samples[index] = (SampleType) sqrt(real * real + outputs[1] * outputs[1]);
+        real = outputs[0];
+    }
+
+    for (int bank = 0; bank < 2; ++bank) {
+        for (int signal = 0; signal <= num_sections; ++signal) {
+            V::store(state[bank][signal], banks[bank][signal]);
+        }
+    }
+    delayed_real = real;
+    parity = (parity + numSamples) & 1;
+}
+
+// The plugin uses both precisions, depending on what the host asks for.
+template class HilbertEnvelope<float>;
+template class HilbertEnvelope<double>;
@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    HilbertEnvelope.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition and the per-sample implementation of the HilbertEnvelope component
+                 class, the magnitude of the analytic signal from a pair of IIR allpass chains.
+    Dependencies:
+    - algorithm
+    - math.h
+    - EnvelopeBank.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <algorithm> // Imports the c++ stdlib algorithm libarary.
+#include <math.h> // Imports the basic c stdlib math library
+#include "EnvelopeBank.h" // Import the LaneVector SIMD helpers the two allpass chains run on.
+
+/**
+ * The instantaneous amplitude of a signal, as the magnitude of its analytic signal.
+ *
+ * Rectifying a sine gives a signal that swings between 0 and the amplitude twice per cycle, so an envelope that
+ * follows it ripples unless its release is long compared with the period. The analytic signal pairs the input
+ * with a copy shifted 90 degrees, and for a sine the two make sin and cos, whose magnitude is the amplitude itself
+ * with no ripple at all.
+ *
+ * The 90 degree pair comes from two chains of four allpass sections whose phase responses stay 90 degrees apart
+ * (to within 0.7 degrees) from about 0.0005 to 0.4995 of the sampling frequency, as designed by Olli Niemitalo:
+ * - https://yehar.com/blog/?p=368
+ * Each section is a first-order allpass in z^-2: y[n] = a^2 * (x[n] + y[n - 2]) - x[n - 2]. The first chain is
+ * delayed by one more sample, which is applied to its output since the chain is linear.
+ *
+ * The two chains see the same input and are independent of each other, so they run side by side as lanes 0 and 1
+ * of LaneVector<SampleType>, one vector multiply-add per section for both. Because each section only looks two
+ * samples back, the even and odd samples never mix inside a chain, so the state is kept as one bank per parity
+ * holding the values from two samples ago, and each sample reads and overwrites its own bank with no shifting.
+ *
+ * Attributes
+ * ----------
+ * public static const int num_sections: The number of allpass sections in each chain.
+ * private static const int lane_stride: The two chains rounded up to a whole number of LaneVector registers.
+ * private SampleType coefficients[num_sections][lane_stride]: a^2 for each section, one lane per chain.
+ * private SampleType state[2][num_sections + 1][lane_stride]: For each parity, the input and section outputs from two samples ago.
+ * private SampleType outputs[lane_stride]: Scratch for the chain outputs of the latest sample.
+ * private SampleType delayed_real: The output of the first chain one sample ago.
+ * private int parity: Which state bank the next sample uses.
+ *
+ * Methods
+ * -------
+ * public HilbertEnvelope(): Lays the coefficients out in lanes and clears the state.
+ * public void reset(): Clears the state.
+ * public SampleType processSample(SampleType sample): Takes one sample and returns the magnitude of the analytic signal.
+ * public void process(SampleType* samples, int numSamples): Replaces each sample of a block with the magnitude of the analytic signal.
+ *
+ * Owned by
+ * - SignalProcessor
+ */
+template <typename SampleType>
+class HilbertEnvelope
+{
+public:
+    /// <summary>
+    ///     The number of allpass sections in each chain.
+    /// </summary>
+    static const int num_sections = 4;
+
+    /**
+     * The constructor for the HilbertEnvelope component.
+     *
+     * Lays the section coefficients of the two chains out in lanes, and clears the state.
+     */
+    HilbertEnvelope();
+
+    /**
+     * Clears the state.
+     */
+    void reset();
+
+    /**
+     * Takes one input sample, and returns the magnitude of the analytic signal.
+     *
+     * Arguments
+     * ---------
+     * SampleType sample: The next input sample.
+     *
+     * Returns
+     * -------
+     * SampleType: The instantaneous amplitude. Never negative.
+     */
+    SampleType processSample(SampleType sample) {
+        typedef LaneVector<SampleType> V;
+
+        SampleType (&bank)[num_sections + 1][lane_stride] = state[parity];
+        parity ^= 1;
+
+        const typename V::Register input = V::broadcast(sample);
+        for (int lane = 0; lane < lane_stride; lane += V::width) {
+            typename V::Register signal = input;
+            for (int section = 0; section < num_sections; ++section) {
+                // y[n] = a^2 * (x[n] + y[n - 2]) - x[n - 2], where this section's y is the next section's x.
+                const typename V::Register output = V::sub(V::mul(V::load(coefficients[section] + lane),
+                                                                  V::add(signal, V::load(bank[section + 1] + lane))),
+                                                           V::load(bank[section] + lane));
+                V::store(bank[section] + lane, signal);
+                signal = output;
+            }
+            V::store(bank[num_sections] + lane, signal);
+            V::store(outputs + lane, signal);
+        }
+
+        // The first chain carries one extra sample of delay.
+        const SampleType real = delayed_real;
+        const SampleType imaginary = outputs[1];
+        delayed_real = outputs[0];
+        return (SampleType) sqrt(real * real + imaginary * imaginary);
+    };
+
+    /**
+     * Replaces each sample of a block with the magnitude of the analytic signal.
+     *
+     * Gives the same output as calling processSample on every sample, but keeps the coefficients and both state
+     * banks in registers for the whole block.
+     *
+     * Arguments
+     * ---------
+     * SampleType* samples: The input samples. Overwritten with the instantaneous amplitude.
+     * int numSamples: The number of samples.
+     */
+    void process(SampleType* samples, int numSamples);
+
+private:
+    /// <summary>
+    ///     The two chains rounded up to a whole number of LaneVector<SampleType> registers. The padding lanes are processed but never read.
+    /// </summary>
+    static const int lane_stride = LaneVector<SampleType>::width > 2 ? LaneVector<SampleType>::width : 2;
+
+    /// <summary>
+    ///     a^2 for each section, with the first chain in lane 0 and the second in lane 1.
+    /// </summary>
+    SampleType coefficients[num_sections][lane_stride];
+    /// <summary>
+    ///     For each parity, the chain input (index 0) and each section's output from two samples ago.
+    /// </summary>
+    SampleType state[2][num_sections + 1][lane_stride];
+    /// <summary>
+    ///     Scratch for the chain outputs of the latest sample.
+    /// </summary>
+    SampleType outputs[lane_stride];
+    /// <summary>
+    ///     The output of the first chain one sample ago, which is its output after the extra sample of delay.
+    /// </summary>
+    SampleType delayed_real = 0;
+    /// <summary>
+    ///     Which state bank the next sample uses.
+    /// </summary>
+    int parity = 0;
+};
@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+    MidiEncoder.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the setup methods of the MidiEncoder component class.
+    Dependencies:
+    - MidiEncoder.h
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "MidiEncoder.h" // Import the interface definition for the MidiEncoder component for implementation.
+
+/**
+ * Selects the format controller values are written in.
+ *
+ * Arguments
+ * ---------
+ * Format new_format: The controller format.
+ */
+void MidiEncoder::setFormat(Format new_format)
+{
+    format = new_format;
+    size = 0;
+}
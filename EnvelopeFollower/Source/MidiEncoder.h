@@ -0,0 +1,354 @@
+/*
+  ==============================================================================
+
+    MidiEncoder.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition and the inline encoders of the MidiEncoder component class, which writes
+                 the plugin's controller, note and pitch bend messages as raw bytes.
+    Dependencies:
+    - algorithm
+    - cmath
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <algorithm> // Imports the c++ stdlib algorithm libarary.
+#include <cmath> // Imports the c++ stdlib math library, for rounding levels to values.
+
+/**
+ * Writes the plugin's output messages as raw MIDI bytes into a fixed buffer it owns, so the audio thread never
+ * constructs a juce::MidiMessage or allocates to send one.
+ *
+ * A controller is sent as an output level between 0 and 1, quantized straight to the resolution of the selected
+ * format rather than rounded to 7 bits first:
+ * - cc7: one 7-bit CC. 128 steps.
+ * - cc14: the MIDI 1.0 14-bit pair, the coarse value on controller n and the fine value on n + 32, coarse first as
+ *   receivers expect. 16384 steps. Only controllers 0 to 31 have a fine partner, so the others send 7 bits (see below).
+ * - nrpn: a Non-Registered Parameter Number on parameter number n: the parameter select (CC 99 and 98), then data
+ *   entry (CC 6 and 38). 16384 steps on any controller number, at four messages a value.
+ *
+ * Every format is a run of 3-byte channel messages, back to back in the buffer.
+ *
+ * Several outputs can land on the same controller number, or, in cc14, on another output's fine partner. So before
+ * each output is sent it claims the numbers it will use with claimController, in priority order, and the first to
+ * claim a number keeps it for the tick:
+ * - An output whose numbers are already claimed gets Width::none and is skipped, rather than overwriting another output.
+ * - In cc14, an output on 0 to 31 claims both n and n + 32 and gets Width::full. An output on 32 to 127 has no fine
+ *   partner, so it claims n alone and gets Width::coarse: it is quantized, gated and sent as an honest 7-bit CC.
+ * - In cc7 every output is coarse, and in nrpn every output is full, since its numbers have no partners.
+ *
+ * Attributes
+ * ----------
+ * public static const int message_size: The size of every message the encoder writes.
+ * public static const int max_size: The most bytes one encoded value can take.
+ * private Format format: The controller format.
+ * private bool claimed[128]: Which controller numbers an output has claimed since releaseControllers.
+ * private unsigned char bytes[max_size]: The encoded messages.
+ * private int size: The number of bytes in use.
+ *
+ * Methods
+ * -------
+ * public void setFormat(Format new_format): Selects the controller format.
+ * public Format getFormat(): Returns the controller format.
+ * public void releaseControllers(): Frees every controller number for the next tick's outputs to claim.
+ * public int findController(int first): Returns the first controller number from first up that an output could still claim.
+ * public Width claimController(int controller): Claims the numbers an output on a controller uses, and returns how it can be sent.
+ * public long long getMaxValue(Width width): Returns the largest controller value at a width.
+ * public long long getResolution(Width width): Returns the number of controller steps in one 7-bit step at a width.
+ * public long long quantize(double level, Width width): Rounds a level between 0 and 1 to a controller value at a width.
+ * public int encodeController(int channel, int controller, long long value, Width width): Writes a controller value at a width.
+ * public int encodeNote(int channel, int note, int velocity): Writes a note-on or note-off.
+ * public int encodePitchBend(int channel, int value): Writes a 14-bit pitch bend.
+ * public const unsigned char* getData(): Returns the encoded bytes.
+ * public int getSize(): Returns the number of encoded bytes.
+ *
+ * Owned by
+ * - EnvelopeFollowerAudioProcessor
+ */
+class MidiEncoder
+{
+public:
+    /**
+     * The ways a controller value can be sent.
+     */
+    enum class Format {
+        /// One 7-bit control change.
+        cc7,
+        /// A 14-bit control change pair, on controller n and n + 32.
+        cc14,
+        /// A 14-bit Non-Registered Parameter Number.
+        nrpn
+    };
+
+    /**
+     * How an output's value can be sent, once claimController has checked its controller numbers.
+     */
+    enum class Width {
+        /// Another output has claimed the numbers, so nothing is sent.
+        none,
+        /// A single 7-bit CC.
+        coarse,
+        /// The full resolution of the format.
+        full
+    };
+
+    /// <summary>
+    ///     The size of every message the encoder writes. All of them are channel messages with two data bytes.
+    /// </summary>
+    static const int message_size = 3;
+    /// <summary>
+    ///     The most bytes one encoded value can take: the four control changes of an NRPN.
+    /// </summary>
+    static const int max_size = 4 * message_size;
+
+    /**
+     * Selects the format controller values are written in.
+     *
+     * Arguments
+     * ---------
+     * Format new_format: The controller format.
+     */
+    void setFormat(Format new_format);
+
+    /**
+     * Returns the format controller values are written in.
+     *
+     * Returns
+     * -------
+     * Format: The controller format.
+     */
+    Format getFormat() const { return format; };
+
+    /**
+     * Frees every controller number, so the next tick's outputs can claim them again. Called once per tick, before the first output.
+     */
+    void releaseControllers() {
+        std::fill(claimed, claimed + 128, false);
+    };
+
+    /**
+     * Finds the first controller number, from the given one up, whose numbers in the current format no output has claimed.
+     *
+     * Arguments
+     * ---------
+     * int first: The lowest controller number to consider.
+     *
+     * Returns
+     * -------
+     * int: The controller number, or 128 if every one from first up is taken.
+     */
+    int findController(int first) const {
+        for (int controller = first; controller < 128; ++controller) {
+            if (!claimed[controller] && !(format == Format::cc14 && controller < 32 && claimed[controller + 32])) {
+                return controller;
+            }
+        }
+        return 128;
+    };
+
+    /**
+     * Claims the controller numbers an output on the given controller uses in the current format, if no output has claimed them already.
+     *
+     * Arguments
+     * ---------
+     * int controller: The controller (or, for nrpn, parameter) number, from 0 to 127.
+     *
+     * Returns
+     * -------
+     * Width: How the output can be sent: none if its numbers are taken, coarse for a single 7-bit CC, or full.
+     */
+    Width claimController(int controller) {
+        if (claimed[controller]) {
+            return Width::none;
+        }
+        if (format == Format::cc14 && controller < 32) {
+            if (claimed[controller + 32]) {
+                return Width::none;
+            }
+            claimed[controller + 32] = true;
+        }
+        claimed[controller] = true;
+        if (format == Format::cc7 || (format == Format::cc14 && controller >= 32)) {
+            return Width::coarse;
+        }
+        return Width::full;
+    };
+
+    /**
+     * Returns the largest controller value at a width in the current format.
+     *
+     * Arguments
+     * ---------
+     * Width width: The width from claimController.
+     *
+     * Returns
+     * -------
+     * long long: 127 or 16383.
+     */
+    long long getMaxValue(Width width) const {
+        return width == Width::full && format != Format::cc7 ? 16383 : 127;
+    };
+
+    /**
+     * Returns the number of controller steps in one 7-bit step at a width, so a change threshold in 7-bit steps can be applied to any format.
+     *
+     * Arguments
+     * ---------
+     * Width width: The width from claimController.
+     *
+     * Returns
+     * -------
+     * long long: 1 or 128.
+     */
+    long long getResolution(Width width) const { return (getMaxValue(width) + 1) / 128; };
+
+    /**
+     * Rounds an output level to the nearest controller value at a width in the current format.
+     *
+     * Arguments
+     * ---------
+     * double level: The level, from 0 to 1. Clamped.
+     * Width width: The width from claimController.
+     *
+     * Returns
+     * -------
+     * long long: The controller value, from 0 to getMaxValue(width).
+     */
+    long long quantize(double level, Width width) const {
+        return llround(std::min(std::max(level, 0.0), 1.0) * getMaxValue(width));
+    };
+
+    /**
+     * Writes a controller value at a width in the current format, replacing whatever was in the buffer.
+     *
+     * Arguments
+     * ---------
+     * int channel: The MIDI channel, from 1 to 16.
+     * int controller: The controller (or, for nrpn, parameter) number, from 0 to 127.
+     * long long value: The value, from 0 to getMaxValue(width), as returned by quantize.
+     * Width width: The width from claimController. Not none.
+     *
+     * Returns
+     * -------
+     * int: The number of bytes written.
+     */
+    int encodeController(int channel, int controller, long long value, Width width) {
+        const unsigned char status = (unsigned char) (0xB0 | ((channel - 1) & 0x0F));
+        size = 0;
+        if (width == Width::coarse) {
+            write(status, controller, (int) value);
+            return size;
+        }
+        switch (format) {
+            case Format::cc14:
+                // Coarse first: a coarse value resets the receiver's fine value, so the other order would lose it.
+                write(status, controller, (int) (value >> 7));
+                write(status, controller + 32, (int) (value & 0x7F));
+                break;
+            case Format::nrpn:
+                write(status, 99, 0);
+                write(status, 98, controller);
+                write(status, 6, (int) (value >> 7));
+                write(status, 38, (int) (value & 0x7F));
+                break;
+            default:
+                write(status, controller, (int) value);
+                break;
+        }
+        return size;
+    };
+
+    /**
+     * Writes a note-on, or a note-off for a velocity of 0, replacing whatever was in the buffer.
+     *
+     * Arguments
+     * ---------
+     * int channel: The MIDI channel, from 1 to 16.
+     * int note: The note number.
+     * int velocity: The note-on velocity, from 1 to 127, or 0 for a note-off.
+     *
+     * Returns
+     * -------
+     * int: The number of bytes written.
+     */
+    int encodeNote(int channel, int note, int velocity) {
+        size = 0;
+        write((unsigned char) ((velocity > 0 ? 0x90 : 0x80) | ((channel - 1) & 0x0F)), note, velocity);
+        return size;
+    };
+
+    /**
+     * Writes a pitch bend, replacing whatever was in the buffer.
+     *
+     * Arguments
+     * ---------
+     * int channel: The MIDI channel, from 1 to 16.
+     * int value: The 14-bit pitch bend value, from 0 to 16383.
+     *
+     * Returns
+     * -------
+     * int: The number of bytes written.
+     */
+    int encodePitchBend(int channel, int value) {
+        size = 0;
+        // Pitch bend is the one message that sends its fine byte first.
+        write((unsigned char) (0xE0 | ((channel - 1) & 0x0F)), value & 0x7F, value >> 7);
+        return size;
+    };
+
+    /**
+     * Returns the encoded bytes.
+     *
+     * Returns
+     * -------
+     * const unsigned char*: The first byte of the last encoded value. Valid until the next encode.
+     */
+    const unsigned char* getData() const { return bytes; };
+
+    /**
+     * Returns the number of encoded bytes.
+     *
+     * Returns
+     * -------
+     * int: The size of the last encoded value, a multiple of message_size.
+     */
+    int getSize() const { return size; };
+
+private:
+    /// <summary>
+    ///     The format controller values are written in.
+    /// </summary>
+    Format format = Format::cc7;
+    /// <summary>
+    ///     Which controller numbers an output has claimed since releaseControllers.
+    /// </summary>
+    bool claimed[128] = {};
+    /// <summary>
+    ///     The encoded messages. Overwritten by every encode.
+    /// </summary>
+    unsigned char bytes[max_size];
+    /// <summary>
+    ///     The number of bytes of the last encoded value.
+    /// </summary>
+    int size = 0;
+
+    /**
+     * Appends one 3-byte channel message to the buffer.
+     *
+     * Arguments
+     * ---------
+     * unsigned char status: The status byte.
+     * int first: The first data byte. Masked to 7 bits.
+     * int second: The second data byte. Masked to 7 bits.
+     */
+    void write(unsigned char status, int first, int second) {
+        bytes[size++] = status;
+        bytes[size++] = (unsigned char) (first & 0x7F);
+        bytes[size++] = (unsigned char) (second & 0x7F);
+    };
+};
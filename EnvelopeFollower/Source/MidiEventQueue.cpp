@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+    MidiEventQueue.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the setup methods of the MidiEventQueue component class.
+    Dependencies:
+    - MidiEventQueue.h
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "MidiEventQueue.h" // Import the interface definition for the MidiEventQueue component for implementation.
+
+/**
+ * Allocates the ring and clears it, along with the counters.
+ *
+ * Allocates memory and resets both ends, so should only be called while neither thread is using the ring.
+ *
+ * Arguments
+ * ---------
+ * int min_capacity: The fewest messages the ring must hold. Rounded up to a power of 2.
+ */
+void MidiEventQueue::prepare(int min_capacity)
+{
+    int capacity = 2;
+    while (capacity < min_capacity) {
+        capacity *= 2;
+    }
+    slots.assign(capacity, Event {});
+    mask = (unsigned int) capacity - 1;
+    write_position.store(0, std::memory_order_relaxed);
+    read_position.store(0, std::memory_order_relaxed);
+    cached_read_position = 0;
+    cached_write_position = 0;
+    num_dropped.store(0, std::memory_order_relaxed);
+    max_depth.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+    MidiEventQueue.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition and the inline push and pop of the MidiEventQueue component class, a
+                 wait-free single-producer single-consumer ring of short MIDI messages.
+    Dependencies:
+    - algorithm
+    - atomic
+    - vector
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <algorithm> // Imports the c++ stdlib algorithm libarary.
+#include <atomic> // Imports the c++ stdlib atomics the two ends of the ring synchronise with.
+#include <vector> // Imports the c++ stdlib vector container used for the preallocated ring.
+
+/**
+ * A ring of short MIDI messages with one writer (the audio thread) and one reader (the MIDI sender thread).
+ *
+ * Each end owns one position: the writer only stores write_position and the reader only stores read_position, so
+ * neither ever waits for the other. push and pop are a handful of loads and stores with acquire/release ordering, no
+ * locks, no allocation and no system calls, so they are safe on the audio thread. Each end also keeps a cached copy
+ * of the other end's position and only reloads it when the ring looks full (or empty), which keeps the two cache
+ * lines from bouncing between cores on every message.
+ *
+ * A push into a full ring drops the message and counts it rather than waiting, so a stalled reader can never stall
+ * the audio. The depth, the deepest the ring has been and the number of drops can be read from any thread, for
+ * monitoring. The deepest depth is measured by the reader, each time it catches up and reloads write_position, since
+ * that is when it knows exactly how many messages are waiting. The writer's cached read position can be far behind.
+ *
+ * Attributes
+ * ----------
+ * public static const int max_event_size: The most bytes one message can hold.
+ * private std::vector<Event> slots: The ring. Its size is a power of 2.
+ * private unsigned int mask: The size of the ring - 1, to wrap positions.
+ * private std::atomic<unsigned int> write_position: The number of messages ever pushed. Only stored by the writer.
+ * private unsigned int cached_read_position: The writer's last look at read_position.
+ * private std::atomic<unsigned int> read_position: The number of messages ever popped. Only stored by the reader.
+ * private unsigned int cached_write_position: The reader's last look at write_position.
+ * private std::atomic<unsigned long long> num_dropped: The number of messages dropped because the ring was full.
+ * private std::atomic<int> max_depth: The most messages the reader has found waiting at once.
+ *
+ * Methods
+ * -------
+ * public void prepare(int min_capacity): Allocates the ring and clears it.
+ * public bool push(const unsigned char* data, int size): Adds a message, or drops and counts it if the ring is full.
+ * public bool pop(Event& event): Takes the oldest message, if there is one.
+ * public int getCapacity(): Returns the number of messages the ring holds.
+ * public int getDepth(): Returns the number of messages waiting.
+ * public int getMaxDepth(): Returns the most messages that have waited at once.
+ * public unsigned long long getNumDropped(): Returns the number of messages dropped because the ring was full.
+ *
+ * Owned by
+ * - MidiSender
+ */
+class MidiEventQueue
+{
+public:
+    /// <summary>
+    ///     The most bytes one message can hold. Enough for every MIDI 1.0 channel message.
+    /// </summary>
+    static const int max_event_size = 3;
+
+    /**
+     * One MIDI message waiting in the ring.
+     */
+    struct Event {
+        /// The raw bytes of the message, status byte first.
+        unsigned char data[max_event_size];
+        /// The number of bytes used.
+        int size;
+    };
+
+    /**
+     * Allocates the ring and clears it, along with the counters.
+     *
+     * Allocates memory and resets both ends, so should only be called while neither thread is using the ring.
+     *
+     * Arguments
+     * ---------
+     * int min_capacity: The fewest messages the ring must hold. Rounded up to a power of 2.
+     */
+    void prepare(int min_capacity);
+
+    /**
+     * Adds a message to the ring. Only called by the writer.
+     *
+     * Arguments
+     * ---------
+     * const unsigned char* data: The raw bytes of the message.
+     * int size: The number of bytes, from 1 to max_event_size.
+     *
+     * Returns
+     * -------
+     * bool: True if the message was added, False if it was too long or the ring was full, in which case it is counted as dropped.
+     */
+    bool push(const unsigned char* data, int size) {
+        const unsigned int position = write_position.load(std::memory_order_relaxed);
+        if (position - cached_read_position > mask) {
+            // Looks full, so take a fresh look at how far the reader has got.
+            cached_read_position = read_position.load(std::memory_order_acquire);
+        }
+        if (slots.empty() || size < 1 || size > max_event_size || position - cached_read_position > mask) {
+            num_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        Event& event = slots[position & mask];
+        std::copy(data, data + size, event.data);
+        event.size = size;
+        // Release, so the reader sees the message before it sees the new position.
+        write_position.store(position + 1, std::memory_order_release);
+        return true;
+    };
+
+    /**
+     * Takes the oldest message from the ring. Only called by the reader.
+     *
+     * Arguments
+     * ---------
+     * Event& event: Receives the message.
+     *
+     * Returns
+     * -------
+     * bool: True if a message was taken, False if the ring was empty.
+     */
+    bool pop(Event& event) {
+        const unsigned int position = read_position.load(std::memory_order_relaxed);
+        if (position == cached_write_position) {
+            // Looks empty, so take a fresh look at how far the writer has got.
+            cached_write_position = write_position.load(std::memory_order_acquire);
+            if (position == cached_write_position) {
+                return false;
+            }
+            // Everything pushed since the reader last caught up is waiting now.
+            const int depth = (int) (cached_write_position - position);
+            if (depth > max_depth.load(std::memory_order_relaxed)) {
+                max_depth.store(depth, std::memory_order_relaxed);
+            }
+        }
+        event = slots[position & mask];
+        // Release, so the writer can't reuse the slot before it has been copied out.
+        read_position.store(position + 1, std::memory_order_release);
+        return true;
+    };
+
+    /**
+     * Returns the number of messages the ring holds.
+     *
+     * Returns
+     * -------
+     * int: The capacity, a power of 2. 0 until prepare.
+     */
+    int getCapacity() const { return (int) slots.size(); };
+
+    /**
+     * Returns the number of messages waiting to be popped. Safe from any thread, though it may be stale by the time it is used.
+     *
+     * Returns
+     * -------
+     * int: The queue depth.
+     */
+    int getDepth() const {
+        const unsigned int read = read_position.load(std::memory_order_acquire);
+        return (int) (write_position.load(std::memory_order_acquire) - read);
+    };
+
+    /**
+     * Returns the most messages the reader has found waiting at once since prepare. Safe from any thread.
+     *
+     * Returns
+     * -------
+     * int: The high-water mark of the queue depth, as measured each time the reader catches up.
+     */
+    int getMaxDepth() const { return max_depth.load(std::memory_order_relaxed); };
+
+    /**
+     * Returns the number of messages dropped because the ring was full since prepare. Safe from any thread.
+     *
+     * Returns
+     * -------
+     * unsigned long long: The drop count.
+     */
+    unsigned long long getNumDropped() const { return num_dropped.load(std::memory_order_relaxed); };
+
+private:
+    /// <summary>
+    ///     The ring. Its size is a power of 2, so positions wrap with a mask.
+    /// </summary>
+    std::vector<Event> slots;
+    /// <summary>
+    ///     The size of the ring - 1.
+    /// </summary>
+    unsigned int mask = 0;
+    /// <summary>
+    ///     The number of messages ever pushed, wrapping. Only stored by the writer. On its own cache line, away from the reader's position.
+    /// </summary>
+    alignas(64) std::atomic<unsigned int> write_position { 0 };
+    /// <summary>
+    ///     The writer's last look at read_position. Only touched by the writer.
+    /// </summary>
+    unsigned int cached_read_position = 0;
+    /// <summary>
+    ///     The number of messages ever popped, wrapping. Only stored by the reader.
+    /// </summary>
+    alignas(64) std::atomic<unsigned int> read_position { 0 };
+    /// <summary>
+    ///     The reader's last look at write_position. Only touched by the reader.
+    /// </summary>
+    unsigned int cached_write_position = 0;
+    /// <summary>
+    ///     The most messages the reader has found waiting at once. Only stored by the reader, so it shares the reader's cache line.
+    /// </summary>
+    std::atomic<int> max_depth { 0 };
+    /// <summary>
+    ///     The number of messages dropped because the ring was full. Only incremented by the writer.
+    /// </summary>
+    alignas(64) std::atomic<unsigned long long> num_dropped { 0 };
+};
@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    MidiSender.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the MidiSender component class.
+    Dependencies:
+    - MidiSender.h
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "MidiSender.h" // Import the interface definition for the MidiSender component for implementation.
+
+/**
+ * Allocates the queue. The thread isn't started until there is a device to send to.
+ */
+MidiSender::MidiSender()
+    : juce::Thread("Envelope Follower MIDI sender")
+{
+    queue.prepare(default_capacity);
+}
+
+/**
+ * Stops the thread, waiting for it to finish sending, before the device is released.
+ */
+MidiSender::~MidiSender()
+{
+    stopThread(1000);
+}
+
+/**
+ * Replaces the output device, stopping the thread while the device is swapped and starting it again after.
+ *
+ * Arguments
+ * ---------
+ * std::unique_ptr<juce::MidiOutput> new_device: The device to send to. Null leaves the thread stopped.
+ */
+void MidiSender::setOutputDevice(std::unique_ptr<juce::MidiOutput> new_device)
+{
+    stopThread(1000);
+    output_device = std::move(new_device);
+    if (output_device) {
+        startThread();
+    }
+}
+
+/**
+ * The thread's loop. Drains the queue into the device, then sleeps for poll_interval, until asked to stop.
+ *
+ * The queue is drained completely on every pass, so a burst never waits more than one interval.
+ */
+void MidiSender::run()
+{
+    MidiEventQueue::Event event;
+    while (! threadShouldExit()) {
+        while (queue.pop(event)) {
+            output_device->sendMessageNow(juce::MidiMessage(event.data, event.size));
+        }
+        wait(poll_interval);
+    }
+}
@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+    MidiSender.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition for the MidiSender component class, the thread that takes MIDI messages
+                 off the audio thread and sends them to the output device.
+    Dependencies:
+    - JuceHeader.h
+    - MidiEventQueue.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <JuceHeader.h> // Import the JUCE dependencies for the thread and the MIDI output device.
+#include "MidiEventQueue.h" // Import the interface definition for the ring the messages wait in.
+
+/**
+ * Sends the plugin's MIDI messages to the output device from its own thread, so the audio thread never does.
+ *
+ * juce::MidiOutput::sendMessageNow goes straight to the operating system (an ALSA sequencer write on Linux, a
+ * CoreMIDI call on macOS), which is a system call that can block. The audio thread instead posts each message into a
+ * MidiEventQueue, which is wait-free, and this thread drains the queue into the device.
+ *
+ * The audio thread never wakes this thread, since signalling it would itself be a system call. The thread polls
+ * instead, every poll_interval milliseconds, which delays a message by at most that long and costs nothing while the
+ * queue is empty. The output port only sees the time each message is sent in any case, never its place in the block.
+ *
+ * The device is owned here, so it can only be replaced while the thread is stopped.
+ *
+ * Attributes
+ * ----------
+ * public static const int poll_interval: The number of milliseconds the thread sleeps between drains.
+ * public static const int default_capacity: The number of messages the queue holds.
+ * private MidiEventQueue queue: The wait-free ring between the audio thread and this one.
+ * private std::unique_ptr<juce::MidiOutput> output_device: The device the messages are sent to, or null.
+ *
+ * Methods
+ * -------
+ * public MidiSender(): Allocates the queue.
+ * public ~MidiSender(): Stops the thread before the device is released.
+ * public void setOutputDevice(std::unique_ptr<juce::MidiOutput> new_device): Replaces the device and (re)starts the thread.
+ * public bool post(const unsigned char* data, int size): Queues a message from the audio thread.
+ * public int getQueueDepth(): Returns the number of messages waiting.
+ * public int getMaxQueueDepth(): Returns the most messages that have waited at once.
+ * public unsigned long long getNumDropped(): Returns the number of messages dropped because the queue was full.
+ * public void run(): The thread's loop, draining the queue into the device.
+ *
+ * Inherits
+ * - juce::Thread
+ *
+ * Owns
+ * - MidiEventQueue
+ *
+ * Owned by
+ * - EnvelopeFollowerAudioProcessor
+ */
+class MidiSender : public juce::Thread
+{
+public:
+    /// <summary>
+    ///     The number of milliseconds the thread sleeps between drains. The most a message can wait before it is sent.
+    /// </summary>
+    static const int poll_interval = 1;
+    /// <summary>
+    ///     The number of messages the queue holds. A CC on every sample of a 4096-sample block, across every output,
+    ///     would still fit many times over at the rates the plugin sends.
+    /// </summary>
+    static const int default_capacity = 4096;
+
+    /**
+     * Allocates the queue. The thread isn't started until there is a device to send to.
+     */
+    MidiSender();
+
+    /**
+     * Stops the thread, waiting for it to finish sending, before the device is released.
+     */
+    ~MidiSender() override;
+
+    /**
+     * Replaces the output device, stopping the thread while the device is swapped and starting it again after.
+     *
+     * Never called from the audio thread. Any messages still queued are sent to the new device.
+     *
+     * Arguments
+     * ---------
+     * std::unique_ptr<juce::MidiOutput> new_device: The device to send to. Null leaves the thread stopped, and messages queue up and are dropped once the queue is full.
+     */
+    void setOutputDevice(std::unique_ptr<juce::MidiOutput> new_device);
+
+    /**
+     * Queues a message to be sent from the sender thread. Wait-free: no locks, allocation or system calls.
+     *
+     * Arguments
+     * ---------
+     * const unsigned char* data: The raw bytes of a short MIDI message, status byte first.
+     * int size: The number of bytes, at most MidiEventQueue::max_event_size.
+     *
+     * Returns
+     * -------
+     * bool: True if the message was queued, False if it was dropped and counted.
+     */
+    bool post(const unsigned char* data, int size) {
+        return queue.push(data, size);
+    };
+
+    /**
+     * Returns the number of messages waiting to be sent. Safe from any thread.
+     *
+     * Returns
+     * -------
+     * int: The queue depth.
+     */
+    int getQueueDepth() const { return queue.getDepth(); };
+
+    /**
+     * Returns the most messages that have waited at once. Safe from any thread.
+     *
+     * Returns
+     * -------
+     * int: The high-water mark of the queue depth.
+     */
+    int getMaxQueueDepth() const { return queue.getMaxDepth(); };
+
+    /**
+     * Returns the number of messages dropped because the queue was full. Safe from any thread.
+     *
+     * Returns
+     * -------
+     * unsigned long long: The drop count.
+     */
+    unsigned long long getNumDropped() const { return queue.getNumDropped(); };
+
+    /**
+     * The thread's loop. Drains the queue into the device, then sleeps for poll_interval, until asked to stop.
+     */
+    void run() override;
+
+private:
+    /// <summary>
+    ///     The wait-free ring between the audio thread (the writer) and this thread (the reader).
+    /// </summary>
+    MidiEventQueue queue;
+    /// <summary>
+    ///     The device the messages are sent to, or null. Only touched by this thread while it runs.
+    /// </summary>
+    std::unique_ptr<juce::MidiOutput> output_device;
+
+    // A macro that prevents memory leaks and by-value copying of this component from the JUCE framework.
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiSender)
+};
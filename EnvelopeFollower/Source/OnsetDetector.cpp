@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+    OnsetDetector.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the OnsetDetector component class.
+    Dependencies:
+    - OnsetDetector.h
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "OnsetDetector.h" // Import the interface definition for the OnsetDetector component for implementation.
+
+/**
+ * Returns the one-pole coefficient that covers about 63% of a step in the given time.
+ *
+ * Arguments
+ * ---------
+ * double seconds: The time constant.
+ * double freq: The number of samples per second.
+ *
+ * Returns
+ * -------
+ * double: The coefficient, between 0 (instant) and 1 (never moves).
+ */
+static double onePoleCoefficient(double seconds, double freq)
+{
+    return exp(-1.0 / std::max(seconds * freq, 1.0));
+}
+
+/**
+ * Sets the envelope and threshold coefficients for the sampling frequency, and allocates room for the events of the largest block.
+ *
+ * Allocates memory, so should only be called from prepareToPlay.
+ *
+ * Arguments
+ * ---------
+ * double freq: The number of input samples per second.
+ * int max_block_size: The largest number of samples process is expected to receive at once.
+ */
+template <typename SampleType>
+void OnsetDetector<SampleType>::prepare(double freq, int max_block_size)
+{
+    sampling_frequency = freq;
+    fast_attack = 0;
+    fast_release = (SampleType) onePoleCoefficient(0.01, freq);
+    slow_attack = (SampleType) onePoleCoefficient(0.03, freq);
+    slow_release = (SampleType) onePoleCoefficient(0.1, freq);
+    mean_coefficient = (SampleType) onePoleCoefficient(0.5, freq);
+    retrigger_samples = std::max((int) (retrigger_time * freq), 1);
+    setNoteLength(note_time);
+
+    // At most one onset per retrigger_samples, each with a note-off, plus one note-off carried over from the last block.
+    events.resize(2 * (std::max(max_block_size, 1) / retrigger_samples + 1) + 1);
+    reset();
+}
+
+/**
+ * Sets how far above its running mean the detection function must rise to trigger an onset.
+ *
+ * Arguments
+ * ---------
+ * float decibels: The margin in dB. Lower values trigger on softer transients. Clamped to at least 0.5 dB.
+ */
+template <typename SampleType>
+void OnsetDetector<SampleType>::setSensitivity(float decibels)
+{
+    threshold_ratio = (SampleType) pow(10.0, std::max(decibels, 0.5f) / 20.0);
+}
+
+/**
+ * Sets the time from each onset to its note-off. A new onset ends the previous note first.
+ *
+ * Arguments
+ * ---------
+ * float seconds: The note length. Clamped to at least one sample.
+ */
+template <typename SampleType>
+void OnsetDetector<SampleType>::setNoteLength(float seconds)
+{
+    note_time = seconds;
+    note_length = std::max((int) (seconds * sampling_frequency), 1);
+}
+
+/**
+ * Clears the envelopes, the threshold and any note in progress.
+ */
+template <typename SampleType>
+void OnsetDetector<SampleType>::reset()
+{
+    fast = 0;
+    slow = 0;
+    mean = 1;
+    armed = true;
+    since_onset = retrigger_samples;
+    note_sounding = false;
+    num_events = 0;
+}
+
+/**
+ * Finds the onsets and note-offs in a block of multichannel audio.
+ *
+ * The events replace those from the last block, in sample order.
+ *
+ * Arguments
+ * ---------
+ * const SampleType* const* channels: One pointer per input channel to numSamples samples.
+ * int numChannels: The number of input channels. They are averaged.
+ * int numSamples: The number of samples in each channel.
+ */
+template <typename SampleType>
+void OnsetDetector<SampleType>::process(const SampleType* const* channels, int numChannels, int numSamples)
+{
+    num_events = 0;
+    if (numChannels < 1) {
+        return;
+    }
+    const SampleType scale = (SampleType) 1 / numChannels;
+    const SampleType floor = (SampleType) level_floor;
+    // Keeps the ratio finite in silence. Far below level_floor, so it never decides an onset.
+    const SampleType tiny = (SampleType) 1e-9;
+
+    for (int index = 0; index < numSamples; ++index) {
+        SampleType sample = channels[0][index];
+        for (int channel = 1; channel < numChannels; ++channel) {
+            sample += channels[channel][index];
+        }
+        const SampleType level = (SampleType) fabs(sample * scale);
+
+        // The fast and slow envelopes, each with its own attack and release.
+        fast = level + (level > fast ? fast_attack : fast_release) * (fast - level);
+        slow = level + (level > slow ? slow_attack : slow_release) * (slow - level);
+        const SampleType ratio = (fast + tiny) / (slow + tiny);
+
+        if (since_onset < note_length || since_onset < retrigger_samples) {
+            ++since_onset;
+        }
+        if (note_sounding && since_onset >= note_length) {
+            addEvent(index, 0);
+            note_sounding = false;
+        }
+
+        // Re-arm once the detection function has settled back to its background.
+        if (ratio < mean) {
+            armed = true;
+        }
+        if (armed && since_onset >= retrigger_samples && fast > floor && ratio > mean * threshold_ratio) {
+            if (note_sounding) {
+                addEvent(index, 0);
+            }
+            // The velocity follows the fast envelope in dB, from the floor (1) to full scale (127).
+            const double decibels = 20 * log10((double) fast);
+            const double floor_decibels = 20 * log10(level_floor);
+            const int velocity = (int) lround(1 + 126 * (1 - decibels / floor_decibels));
+            addEvent(index, std::min(std::max(velocity, 1), 127));
+            note_sounding = true;
+            armed = false;
+            since_onset = 0;
+        }
+
+        // Onsets themselves are left out of the background, so a hit doesn't raise the bar for the next one.
+        if (armed) {
+            mean = ratio + mean_coefficient * (mean - ratio);
+        }
+    }
+}
+
+// The plugin uses both precisions, depending on what the host asks for.
+template class OnsetDetector<float>;
+template class OnsetDetector<double>;
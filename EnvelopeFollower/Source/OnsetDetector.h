@@ -0,0 +1,262 @@
+/*
+  ==============================================================================
+
+    OnsetDetector.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition for the OnsetDetector component class, which finds transients with an
+                 envelope-derivative detection function and an adaptive threshold, and reports them at their sample.
+    Dependencies:
+    - algorithm
+    - math.h
+    - vector
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <algorithm> // Imports the c++ stdlib algorithm libarary.
+#include <math.h> // Imports the basic c stdlib math library
+#include <vector> // Imports the c++ stdlib vector container used for the preallocated event list.
+
+/**
+ * Finds onsets (the starts of notes and drum hits) and reports each one at the sample it happened on, with a note-off
+ * a fixed time later, so the plugin can play them as sample-accurate MIDI notes.
+ *
+ * The detection function is the ratio of a fast envelope to a slow one. Both follow the rectified input (the mean of
+ * the channels): the fast one rises instantly and falls over 10 ms, the slow one rises over 30 ms and falls over
+ * 100 ms. On a steady signal they agree and the ratio sits near 1, and at a transient the fast one jumps ahead,
+ * so the ratio is a smoothed, level-independent derivative of the envelope in log terms.
+ *
+ * The threshold adapts to the material: a one-pole running mean of the ratio (over about half a second) is multiplied
+ * by the sensitivity, so busy material has to stand out further from its own background to trigger. An onset also has
+ * to clear an absolute level floor, waits for the ratio to fall back below the running mean before it can retrigger,
+ * and can't come within retrigger_time of the last one. Every step is a few multiplies and compares, O(1) per sample,
+ * cheap enough to leave on every drum bus.
+ *
+ * The note-on velocity is the level of the fast envelope at the onset, from level_floor (1) to full scale (127).
+ *
+ * Attributes
+ * ----------
+ * public static constexpr double level_floor: The fast envelope level an onset must reach.
+ * public static constexpr double retrigger_time: The shortest time in seconds between onsets.
+ * private double sampling_frequency: The number of input samples per second.
+ * private SampleType threshold_ratio: How far above its running mean the detection function must rise, as a ratio.
+ * private int note_length: How many samples after an onset its note-off comes.
+ * private int retrigger_samples: The shortest number of samples between onsets.
+ * private SampleType fast_attack, fast_release, slow_attack, slow_release, mean_coefficient: The one-pole coefficients.
+ * private SampleType fast, slow, mean: The fast envelope, the slow envelope and the running mean of their ratio.
+ * private bool armed: Whether the detection function has fallen back since the last onset, so another can trigger.
+ * private int since_onset: The number of samples since the last onset.
+ * private bool note_sounding: Whether a note-off is still due for the last onset.
+ * private std::vector<Event> events: The events found in the last block.
+ * private int num_events: The number of events found in the last block.
+ *
+ * Methods
+ * -------
+ * public void prepare(double freq, int max_block_size): Sets the coefficients and allocates the event list.
+ * public void setSensitivity(float decibels): Sets how far above its running mean the detection function must rise.
+ * public void setNoteLength(float seconds): Sets the time from each onset to its note-off.
+ * public void reset(): Clears the envelopes, the threshold and any note in progress.
+ * public bool isNoteSounding(): Returns whether a note-off is still due for the last onset.
+ * public void process(const SampleType* const* channels, int numChannels, int numSamples): Finds the onsets and note-offs in a block.
+ * public int getNumEvents(): Returns the number of events found in the last block.
+ * public const Event& getEvent(int index): Returns one of the events found in the last block.
+ * private void addEvent(int sample, int velocity): Adds an event to the list, if there is room.
+ *
+ * Owned by
+ * - EnvelopeFollowerAudioProcessor
+ */
+template <typename SampleType>
+class OnsetDetector
+{
+public:
+    /**
+     * One note-on or note-off, at the sample in the block it belongs on.
+     */
+    struct Event {
+        /// The index of the sample in the block.
+        int sample;
+        /// The note-on velocity, from 1 to 127, or 0 for a note-off.
+        int velocity;
+    };
+
+    /// <summary>
+    ///     The fast envelope level (about -50 dBFS) an onset must reach, so noise and reverb tails don't trigger.
+    /// </summary>
+    static constexpr double level_floor = 0.003;
+    /// <summary>
+    ///     The shortest time in seconds between onsets, so one hit with a ragged attack only triggers once.
+    /// </summary>
+    static constexpr double retrigger_time = 0.03;
+
+    /**
+     * Sets the envelope and threshold coefficients for the sampling frequency, and allocates room for the events of the largest block.
+     *
+     * Allocates memory, so should only be called from prepareToPlay.
+     *
+     * Arguments
+     * ---------
+     * double freq: The number of input samples per second.
+     * int max_block_size: The largest number of samples process is expected to receive at once.
+     */
+    void prepare(double freq, int max_block_size);
+
+    /**
+     * Sets how far above its running mean the detection function must rise to trigger an onset.
+     *
+     * Arguments
+     * ---------
+     * float decibels: The margin in dB. Lower values trigger on softer transients. Clamped to at least 0.5 dB.
+     */
+    void setSensitivity(float decibels);
+
+    /**
+     * Sets the time from each onset to its note-off. A new onset ends the previous note first.
+     *
+     * Arguments
+     * ---------
+     * float seconds: The note length. Clamped to at least one sample.
+     */
+    void setNoteLength(float seconds);
+
+    /**
+     * Clears the envelopes, the threshold and any note in progress.
+     */
+    void reset();
+
+    /**
+     * Finds the onsets and note-offs in a block of multichannel audio.
+     *
+     * The events replace those from the last block, in sample order.
+     *
+     * Arguments
+     * ---------
+     * const SampleType* const* channels: One pointer per input channel to numSamples samples.
+     * int numChannels: The number of input channels. They are averaged.
+     * int numSamples: The number of samples in each channel.
+     */
+    void process(const SampleType* const* channels, int numChannels, int numSamples);
+
+    /**
+     * Returns whether a note-off is still due for the last onset, so the plugin can end the note itself when the detector is switched off.
+     *
+     * Returns
+     * -------
+     * bool: True if the last onset's note-off hasn't been reported yet.
+     */
+    bool isNoteSounding() const { return note_sounding; };
+
+    /**
+     * Returns the number of events found in the last block.
+     *
+     * Returns
+     * -------
+     * int: The number of events.
+     */
+    int getNumEvents() const { return num_events; };
+
+    /**
+     * Returns one of the events found in the last block.
+     *
+     * Arguments
+     * ---------
+     * int index: The event, from 0 to getNumEvents() - 1, in sample order.
+     *
+     * Returns
+     * -------
+     * const Event&: The event.
+     */
+    const Event& getEvent(int index) const { return events[index]; };
+
+private:
+    /**
+     * Adds an event to the list. Drops it if the list is full, which only happens if process is given more than the max_block_size passed to prepare.
+     *
+     * Arguments
+     * ---------
+     * int sample: The index of the sample in the block.
+     * int velocity: The note-on velocity, or 0 for a note-off.
+     */
+    void addEvent(int sample, int velocity) {
+        if (num_events < (int) events.size()) {
+            events[num_events++] = { sample, velocity };
+        }
+    };
+
+    /// <summary>
+    ///     The number of input samples per second.
+    /// </summary>
+    double sampling_frequency = 44100;
+    /// <summary>
+    ///     How far above its running mean the detection function must rise, as a ratio. 6 dB by default.
+    /// </summary>
+    SampleType threshold_ratio = (SampleType) 2;
+    /// <summary>
+    ///     The time from each onset to its note-off, in seconds.
+    /// </summary>
+    float note_time = 0.05f;
+    /// <summary>
+    ///     How many samples after an onset its note-off comes.
+    /// </summary>
+    int note_length = 2205;
+    /// <summary>
+    ///     The shortest number of samples between onsets.
+    /// </summary>
+    int retrigger_samples = 1323;
+    /// <summary>
+    ///     The one-pole coefficient of the fast envelope while it rises.
+    /// </summary>
+    SampleType fast_attack = 0;
+    /// <summary>
+    ///     The one-pole coefficient of the fast envelope while it falls.
+    /// </summary>
+    SampleType fast_release = 0;
+    /// <summary>
+    ///     The one-pole coefficient of the slow envelope while it rises.
+    /// </summary>
+    SampleType slow_attack = 0;
+    /// <summary>
+    ///     The one-pole coefficient of the slow envelope while it falls.
+    /// </summary>
+    SampleType slow_release = 0;
+    /// <summary>
+    ///     The one-pole coefficient of the running mean of the detection function.
+    /// </summary>
+    SampleType mean_coefficient = 0;
+    /// <summary>
+    ///     The fast envelope.
+    /// </summary>
+    SampleType fast = 0;
+    /// <summary>
+    ///     The slow envelope.
+    /// </summary>
+    SampleType slow = 0;
+    /// <summary>
+    ///     The running mean of the detection function. Starts at 1, a steady signal.
+    /// </summary>
+    SampleType mean = 1;
+    /// <summary>
+    ///     Whether the detection function has fallen back below its running mean since the last onset.
+    /// </summary>
+    bool armed = true;
+    /// <summary>
+    ///     The number of samples since the last onset. Saturates, so it never overflows.
+    /// </summary>
+    int since_onset = 0;
+    /// <summary>
+    ///     Whether a note-off is still due for the last onset.
+    /// </summary>
+    bool note_sounding = false;
+    /// <summary>
+    ///     The events found in the last block. Sized in prepare.
+    /// </summary>
+    std::vector<Event> events;
+    /// <summary>
+    ///     The number of events found in the last block.
+    /// </summary>
+    int num_events = 0;
+};
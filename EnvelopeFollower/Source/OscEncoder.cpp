@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    OscEncoder.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the setup methods of the OscEncoder component class.
+    Dependencies:
+    - OscEncoder.h
+    - cmath
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "OscEncoder.h" // Import the interface definition for the OscEncoder component for implementation.
+#include <cmath> // Imports the c++ stdlib math library, for splitting a time into seconds and a fraction.
+
+/**
+ * Starts a new packet in the given buffer, forgetting anything written before.
+ *
+ * Arguments
+ * ---------
+ * unsigned char* destination: The buffer to write into. Must stay valid while the packet is written.
+ * int new_capacity: The size of the buffer.
+ */
+void OscEncoder::begin(unsigned char* destination, int new_capacity)
+{
+    buffer = destination;
+    capacity = destination != nullptr ? new_capacity : 0;
+    size = 0;
+    overflowed = false;
+    depth = 0;
+}
+
+/**
+ * Forgets everything written after the given size, and clears the overflow.
+ *
+ * Arguments
+ * ---------
+ * int mark: A size returned by getSize.
+ */
+void OscEncoder::rollback(int mark)
+{
+    size = mark < size ? mark : size;
+    overflowed = false;
+}
+
+/**
+ * Converts a time in seconds since 1970 to an NTP time tag: seconds since 1900 in the top 32 bits and the fraction in the bottom 32.
+ *
+ * Arguments
+ * ---------
+ * double seconds: The time, in seconds since 1970.
+ *
+ * Returns
+ * -------
+ * unsigned long long: The time tag.
+ */
+unsigned long long OscEncoder::toTimeTag(double seconds)
+{
+    // The 70 years from 1900 to 1970, 17 of them leap years.
+    const double ntp_epoch_offset = 2208988800.0;
+    const double ntp_seconds = seconds + ntp_epoch_offset;
+    const double whole = floor(ntp_seconds);
+    const unsigned long long fraction = (unsigned long long) ((ntp_seconds - whole) * 4294967296.0);
+    return ((unsigned long long) whole << 32) | (fraction & 0xFFFFFFFFULL);
+}
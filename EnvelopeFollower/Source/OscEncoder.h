@@ -0,0 +1,343 @@
+/*
+  ==============================================================================
+
+    OscEncoder.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition and the inline writers of the OscEncoder component class, which writes
+                 OSC 1.0 messages and time-tagged bundles into a caller's buffer.
+    Dependencies:
+    - cstring
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <cstring> // Imports the c++ stdlib memcpy, for the bits of a float, and strlen.
+
+/**
+ * Writes OSC 1.0 packets straight into a buffer it is given, one field at a time, without allocating anything.
+ *
+ * A packet is either a single message or a bundle: the "#bundle" header, a 64-bit NTP time tag, and a series of
+ * elements, each a big-endian size followed by a message or another bundle. Every value the plugin sends is a single
+ * float, so each message is an address, the type tag ",f" and the float, all padded to 4 bytes as OSC requires.
+ *
+ * Bundles nest, up to max_depth deep. The size of each bundle element is only known once it has been written, so
+ * its place is reserved first and filled in when the element ends.
+ *
+ * A write that doesn't fit in the buffer is skipped and marks the encoder as overflowed, rather than writing past the
+ * end. The caller can check after writing a group of messages, rollback to where the group started, send what fits
+ * and write the group again into a fresh buffer.
+ *
+ * Attributes
+ * ----------
+ * public static const int max_depth: The most bundles that can be open at once.
+ * public static const unsigned long long immediately: The time tag that asks the receiver to act on the bundle at once.
+ * public static const int bundle_header_size: The size of a bundle with nothing in it.
+ * private unsigned char* buffer: The buffer being written.
+ * private int capacity: The size of the buffer.
+ * private int size: The number of bytes written.
+ * private bool overflowed: Whether a write has been skipped for lack of room.
+ * private int open_bundles[max_depth]: The position of the size of each open bundle, or -1 for one that isn't an element.
+ * private int depth: The number of open bundles.
+ *
+ * Methods
+ * -------
+ * public void begin(unsigned char* destination, int new_capacity): Starts a new packet in the given buffer.
+ * public void beginBundle(unsigned long long time_tag): Opens a bundle.
+ * public void endBundle(): Closes the innermost open bundle.
+ * public void addMessage(const char* address, float value): Writes a message carrying one float.
+ * public void addMessage(const char* address, int index, float value): Writes a message carrying one float to address/index.
+ * public void rollback(int mark): Forgets everything written after a size returned by getSize.
+ * public int getSize(): Returns the number of bytes written.
+ * public bool hasOverflowed(): Returns whether a write has been skipped for lack of room.
+ * public static unsigned long long toTimeTag(double seconds): Converts a time in seconds since 1970 to an NTP time tag.
+ *
+ * Owned by
+ * - EnvelopeFollowerAudioProcessor
+ */
+class OscEncoder
+{
+public:
+    /// <summary>
+    ///     The most bundles that can be open at once.
+    /// </summary>
+    static const int max_depth = 4;
+    /// <summary>
+    ///     The time tag that asks the receiver to act on a bundle as soon as it arrives.
+    /// </summary>
+    static const unsigned long long immediately = 1;
+    /// <summary>
+    ///     The size of a bundle with nothing in it: the padded "#bundle" and the time tag.
+    /// </summary>
+    static const int bundle_header_size = 16;
+
+    /**
+     * Starts a new packet in the given buffer, forgetting anything written before.
+     *
+     * Arguments
+     * ---------
+     * unsigned char* destination: The buffer to write into. Must stay valid while the packet is written.
+     * int new_capacity: The size of the buffer.
+     */
+    void begin(unsigned char* destination, int new_capacity);
+
+    /**
+     * Opens a bundle. Everything written until the matching endBundle goes in it.
+     *
+     * Arguments
+     * ---------
+     * unsigned long long time_tag: When the receiver should act on the bundle, as an NTP time tag from toTimeTag, or immediately.
+     */
+    void beginBundle(unsigned long long time_tag) {
+        if (depth == max_depth) {
+            overflowed = true;
+            return;
+        }
+        open_bundles[depth++] = beginElement();
+        writeString("#bundle");
+        writeInt((unsigned int) (time_tag >> 32));
+        writeInt((unsigned int) time_tag);
+    };
+
+    /**
+     * Closes the innermost open bundle, filling in its size if it is an element of another bundle.
+     */
+    void endBundle() {
+        if (depth > 0) {
+            endElement(open_bundles[--depth]);
+        }
+    };
+
+    /**
+     * Writes a message carrying one float, as an element of the innermost open bundle if there is one.
+     *
+     * Arguments
+     * ---------
+     * const char* address: The OSC address pattern, starting with '/'.
+     * float value: The value.
+     */
+    void addMessage(const char* address, float value) {
+        const int element = beginElement();
+        writeString(address);
+        writeFloatMessageBody(value);
+        endElement(element);
+    };
+
+    /**
+     * Writes a message carrying one float to an address with a number on the end, such as /band/3.
+     *
+     * Arguments
+     * ---------
+     * const char* address: The OSC address pattern the number is appended to, starting with '/'.
+     * int index: The number to append after a '/'. Must not be negative.
+     * float value: The value.
+     */
+    void addMessage(const char* address, int index, float value) {
+        const int element = beginElement();
+        const int start = size;
+        writeBytes(address, (int) strlen(address));
+        writeByte('/');
+        // The digits come out lowest first, so write them into a scratch and reverse them.
+        char digits[12];
+        int num_digits = 0;
+        do {
+            digits[num_digits++] = (char) ('0' + index % 10);
+            index /= 10;
+        } while (index > 0 && num_digits < 12);
+        while (num_digits > 0) {
+            writeByte(digits[--num_digits]);
+        }
+        pad(size - start);
+        writeFloatMessageBody(value);
+        endElement(element);
+    };
+
+    /**
+     * Forgets everything written after the given size, and clears the overflow.
+     *
+     * Only call it where the bundles opened and closed since the mark balance out.
+     *
+     * Arguments
+     * ---------
+     * int mark: A size returned by getSize.
+     */
+    void rollback(int mark);
+
+    /**
+     * Returns the number of bytes written.
+     *
+     * Returns
+     * -------
+     * int: The size of the packet so far.
+     */
+    int getSize() const { return size; };
+
+    /**
+     * Returns whether a write has been skipped for lack of room since begin or the last rollback.
+     *
+     * Returns
+     * -------
+     * bool: True if the packet is incomplete, False otherwise.
+     */
+    bool hasOverflowed() const { return overflowed; };
+
+    /**
+     * Converts a time in seconds since 1970 to an NTP time tag: seconds since 1900 in the top 32 bits and the fraction in the bottom 32.
+     *
+     * Arguments
+     * ---------
+     * double seconds: The time, in seconds since 1970.
+     *
+     * Returns
+     * -------
+     * unsigned long long: The time tag.
+     */
+    static unsigned long long toTimeTag(double seconds);
+
+private:
+    /// <summary>
+    ///     The buffer being written. Not owned.
+    /// </summary>
+    unsigned char* buffer = nullptr;
+    /// <summary>
+    ///     The size of the buffer.
+    /// </summary>
+    int capacity = 0;
+    /// <summary>
+    ///     The number of bytes written.
+    /// </summary>
+    int size = 0;
+    /// <summary>
+    ///     Whether a write has been skipped for lack of room.
+    /// </summary>
+    bool overflowed = false;
+    /// <summary>
+    ///     The position of the size of each open bundle, or -1 for the packet's outermost bundle, which has no size.
+    /// </summary>
+    int open_bundles[max_depth];
+    /// <summary>
+    ///     The number of open bundles.
+    /// </summary>
+    int depth = 0;
+
+    /**
+     * Reserves the size of a bundle element, if a bundle is open.
+     *
+     * Returns
+     * -------
+     * int: The position of the reserved size, or -1 if the element is the whole packet.
+     */
+    int beginElement() {
+        if (depth == 0) {
+            return -1;
+        }
+        const int position = size;
+        writeInt(0);
+        return position;
+    };
+
+    /**
+     * Fills in the size reserved by beginElement, now that the element has been written.
+     *
+     * Arguments
+     * ---------
+     * int position: The position returned by beginElement.
+     */
+    void endElement(int position) {
+        if (position >= 0 && !overflowed) {
+            const unsigned int length = (unsigned int) (size - position - 4);
+            for (int byte = 0; byte < 4; ++byte) {
+                buffer[position + byte] = (unsigned char) (length >> (24 - 8 * byte));
+            }
+        }
+    };
+
+    /**
+     * Writes the type tag and the argument of a message carrying one float.
+     *
+     * Arguments
+     * ---------
+     * float value: The value.
+     */
+    void writeFloatMessageBody(float value) {
+        writeString(",f");
+        unsigned int bits;
+        memcpy(&bits, &value, sizeof(bits));
+        writeInt(bits);
+    };
+
+    /**
+     * Writes a string with its terminating zero, padded to 4 bytes.
+     *
+     * Arguments
+     * ---------
+     * const char* text: The string.
+     */
+    void writeString(const char* text) {
+        const int length = (int) strlen(text);
+        writeBytes(text, length);
+        pad(length);
+    };
+
+    /**
+     * Writes the terminating zero of a string and pads it to 4 bytes.
+     *
+     * Arguments
+     * ---------
+     * int length: The length of the string written, without its terminating zero.
+     */
+    void pad(int length) {
+        for (int index = length; index < (length / 4 + 1) * 4; ++index) {
+            writeByte(0);
+        }
+    };
+
+    /**
+     * Writes a 32-bit integer, most significant byte first.
+     *
+     * Arguments
+     * ---------
+     * unsigned int value: The integer.
+     */
+    void writeInt(unsigned int value) {
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            writeByte((unsigned char) (value >> shift));
+        }
+    };
+
+    /**
+     * Writes a run of bytes, or marks the overflow if they don't fit.
+     *
+     * Arguments
+     * ---------
+     * const char* bytes: The bytes.
+     * int length: The number of bytes.
+     */
+    void writeBytes(const char* bytes, int length) {
+        if (overflowed || size + length > capacity) {
+            overflowed = true;
+            return;
+        }
+        memcpy(buffer + size, bytes, length);
+        size += length;
+    };
+
+    /**
+     * Writes one byte, or marks the overflow if it doesn't fit.
+     *
+     * Arguments
+     * ---------
+     * unsigned char byte: The byte.
+     */
+    void writeByte(unsigned char byte) {
+        if (overflowed || size == capacity) {
+            overflowed = true;
+            return;
+        }
+        buffer[size++] = byte;
+    };
+};
@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    OscSender.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the OscSender component class.
+    Dependencies:
+    - OscSender.h
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "OscSender.h" // Import the interface definition for the OscSender component for implementation.
+
+/**
+ * Allocates the queue. The thread isn't started until setActive(true).
+ */
+OscSender::OscSender()
+    : juce::Thread("Envelope Follower OSC sender")
+{
+    queue.prepare(num_packets, max_packet_size);
+}
+
+/**
+ * Stops the thread, waiting for it to finish sending.
+ */
+OscSender::~OscSender()
+{
+    stopSending();
+}
+
+/**
+ * Replaces the host and port the packets are sent to. A running thread is stopped while they are swapped and started again after.
+ *
+ * Arguments
+ * ---------
+ * const juce::String& host: The host name or IP address to send to.
+ * int port: The UDP port to send to. 0 stops the thread until a valid target is set.
+ */
+void OscSender::setTarget(const juce::String& host, int port)
+{
+    stopSending();
+    target_host = host;
+    target_port = port;
+    startSending();
+}
+
+/**
+ * Starts the thread, if there is a target to send to, or stops it and discards any packets still queued.
+ *
+ * Arguments
+ * ---------
+ * bool should_be_active: True to send packets, False to stop sending.
+ */
+void OscSender::setActive(bool should_be_active)
+{
+    if (should_be_active == active) {
+        return;
+    }
+    active = should_be_active;
+    if (active) {
+        startSending();
+        return;
+    }
+    stopSending();
+    // The thread is stopped, so this thread can stand in as the reader. Whatever was left is stale by the time the output is back on.
+    int size = 0;
+    while (queue.front(size) != nullptr) {
+        queue.pop();
+    }
+}
+
+/**
+ * Starts the thread, if it should be active and there is a target to send to.
+ */
+void OscSender::startSending()
+{
+    if (active && target_port > 0 && target_host.isNotEmpty()) {
+        startThread();
+    }
+}
+
+/**
+ * Stops the thread, waiting for it to finish its current drain. Does nothing if it isn't running.
+ */
+void OscSender::stopSending()
+{
+    stopThread(1000);
+}
+
+/**
+ * The thread's loop. Drains the queue into the socket, then sleeps for poll_interval, until asked to stop.
+ *
+ * The queue is drained completely on every pass, so a burst never waits more than one interval. A datagram the
+ * socket refuses is dropped, as UDP would drop it anyway.
+ */
+void OscSender::run()
+{
+    int size = 0;
+    while (! threadShouldExit()) {
+        while (const unsigned char* packet = queue.front(size)) {
+            socket.write(target_host, target_port, packet, size);
+            queue.pop();
+        }
+        wait(poll_interval);
+    }
+}
@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+
+    OscSender.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition for the OscSender component class, the thread that takes OSC packets
+                 off the audio thread and sends them as UDP datagrams.
+    Dependencies:
+    - JuceHeader.h
+    - PacketQueue.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <JuceHeader.h> // Import the JUCE dependencies for the thread and the UDP socket.
+#include "PacketQueue.h" // Import the interface definition for the ring the packets wait in.
+
+/**
+ * Sends the plugin's OSC packets to a host and port over UDP from its own thread, so the audio thread never does.
+ *
+ * The audio thread encodes each packet straight into a slot of a PacketQueue, which is wait-free, and this thread
+ * writes every queued packet to the socket as one datagram each. Only this thread touches the socket, so writing to
+ * it, a system call, never happens on the audio thread. As in MidiSender, the audio thread never wakes this thread,
+ * since signalling it would take a lock: the thread polls every poll_interval milliseconds instead.
+ *
+ * The thread only runs between setActive(true) and setActive(false), so a plugin with its OSC output switched off has
+ * no sender thread at all. The target can only be changed while the thread is stopped, so setTarget stops a running
+ * thread, swaps the target and starts it again.
+ *
+ * Attributes
+ * ----------
+ * public static const int poll_interval: The number of milliseconds the thread sleeps between drains.
+ * public static const int num_packets: The number of packets the queue holds.
+ * public static const int max_packet_size: The most bytes one packet can hold.
+ * private PacketQueue queue: The wait-free ring between the audio thread and this one.
+ * private juce::DatagramSocket socket: The UDP socket the packets are sent from.
+ * private juce::String target_host: The host name or address the packets are sent to.
+ * private int target_port: The UDP port the packets are sent to.
+ * private bool active: Whether the thread should be running, whenever there is a target to send to.
+ *
+ * Methods
+ * -------
+ * public OscSender(): Allocates the queue.
+ * public ~OscSender(): Stops the thread.
+ * public void setTarget(const juce::String& host, int port): Replaces the target, restarting the thread if it is running.
+ * public void setActive(bool should_be_active): Starts or stops the thread.
+ * public unsigned char* beginPacket(): Returns a slot for the audio thread to encode a packet into.
+ * public void endPacket(int size): Queues the packet encoded since beginPacket.
+ * public int getMaxPacketSize(): Returns the most bytes one packet can hold.
+ * public unsigned long long getNumDropped(): Returns the number of packets dropped because the queue was full.
+ * public void run(): The thread's loop, draining the queue into the socket every poll_interval.
+ * private void startSending(): Starts the thread, if there is a target to send to.
+ * private void stopSending(): Stops the thread.
+ *
+ * Inherits
+ * - juce::Thread
+ *
+ * Owns
+ * - PacketQueue
+ *
+ * Owned by
+ * - EnvelopeFollowerAudioProcessor
+ */
+class OscSender : public juce::Thread
+{
+public:
+    /// <summary>
+    ///     The number of milliseconds the thread sleeps between drains. The most a packet can wait before it is sent.
+    /// </summary>
+    static const int poll_interval = 1;
+    /// <summary>
+    ///     The number of packets the queue holds. At one packet per block or less, this is over a second of audio at any block size.
+    /// </summary>
+    static const int num_packets = 128;
+    /// <summary>
+    ///     The most bytes one packet can hold. Room for a tick of every per-channel envelope, or of every band and spectral feature,
+    ///     with plenty to spare. Larger than one Ethernet frame, which only matters off the local machine, where the datagram is fragmented.
+    /// </summary>
+    static const int max_packet_size = 4096;
+
+    /**
+     * Allocates the queue. The thread isn't started until setActive(true).
+     */
+    OscSender();
+
+    /**
+     * Stops the thread, waiting for it to finish sending.
+     */
+    ~OscSender() override;
+
+    /**
+     * Replaces the host and port the packets are sent to. A running thread is stopped while they are swapped and started again after;
+     * a stopped one is left stopped.
+     *
+     * Never called from the audio thread. Any packets still queued are sent to the new target.
+     *
+     * Arguments
+     * ---------
+     * const juce::String& host: The host name or IP address to send to, such as "127.0.0.1".
+     * int port: The UDP port to send to. 0 stops the thread until a valid target is set.
+     */
+    void setTarget(const juce::String& host, int port);
+
+    /**
+     * Starts the thread, if there is a target to send to, or stops it and discards any packets still queued.
+     *
+     * Never called from the audio thread, as starting and stopping a thread can block.
+     *
+     * Arguments
+     * ---------
+     * bool should_be_active: True to send packets, False to stop sending.
+     */
+    void setActive(bool should_be_active);
+
+    /**
+     * Returns a free slot for the audio thread to encode a packet into. Wait-free: no locks, allocation or system calls.
+     *
+     * Returns
+     * -------
+     * unsigned char*: A buffer of max_packet_size bytes, or null if the queue is full, in which case the packet is counted as dropped.
+     */
+    unsigned char* beginPacket() { return queue.beginPush(); };
+
+    /**
+     * Queues the packet encoded into the slot from beginPacket, for the thread to send on its next drain. Wait-free.
+     *
+     * Arguments
+     * ---------
+     * int size: The number of bytes encoded. 0 gives the slot back unsent.
+     */
+    void endPacket(int size) { queue.endPush(size); };
+
+    /**
+     * Returns the most bytes one packet can hold.
+     *
+     * Returns
+     * -------
+     * int: max_packet_size.
+     */
+    int getMaxPacketSize() const { return queue.getSlotSize(); };
+
+    /**
+     * Returns the number of packets dropped because the queue was full. Safe from any thread.
+     *
+     * Returns
+     * -------
+     * unsigned long long: The drop count.
+     */
+    unsigned long long getNumDropped() const { return queue.getNumDropped(); };
+
+    /**
+     * The thread's loop. Drains the queue into the socket, then sleeps for poll_interval, until asked to stop.
+     */
+    void run() override;
+
+private:
+    /// <summary>
+    ///     The wait-free ring between the audio thread (the writer) and this thread (the reader).
+    /// </summary>
+    PacketQueue queue;
+    /// <summary>
+    ///     The UDP socket the packets are sent from. Only written to by this thread.
+    /// </summary>
+    juce::DatagramSocket socket;
+    /// <summary>
+    ///     The host name or address the packets are sent to. Only changed while the thread is stopped.
+    /// </summary>
+    juce::String target_host;
+    /// <summary>
+    ///     The UDP port the packets are sent to. Only changed while the thread is stopped.
+    /// </summary>
+    int target_port = 0;
+    /// <summary>
+    ///     Whether the thread should be running, whenever there is a target to send to. Only touched off the audio thread.
+    /// </summary>
+    bool active = false;
+
+    /**
+     * Starts the thread, if it should be active and there is a target to send to.
+     */
+    void startSending();
+
+    /**
+     * Stops the thread, waiting for it to finish its current drain.
+     */
+    void stopSending();
+
+    // A macro that prevents memory leaks and by-value copying of this component from the JUCE framework.
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OscSender)
+};
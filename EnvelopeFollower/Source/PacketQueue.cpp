@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    PacketQueue.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the setup methods of the PacketQueue component class.
+    Dependencies:
+    - PacketQueue.h
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "PacketQueue.h" // Import the interface definition for the PacketQueue component for implementation.
+
+/**
+ * Allocates the slots and clears the ring, along with the drop count.
+ *
+ * Allocates memory and resets both ends, so should only be called while neither thread is using the ring.
+ *
+ * Arguments
+ * ---------
+ * int min_slots: The fewest packets the ring must hold. Rounded up to a power of 2.
+ * int new_slot_size: The most bytes one packet can hold.
+ */
+void PacketQueue::prepare(int min_slots, int new_slot_size)
+{
+    int num_slots = 2;
+    while (num_slots < min_slots) {
+        num_slots *= 2;
+    }
+    slot_size = new_slot_size;
+    storage.assign((std::size_t) num_slots * slot_size, 0);
+    sizes.assign(num_slots, 0);
+    mask = (unsigned int) num_slots - 1;
+    write_position.store(0, std::memory_order_relaxed);
+    read_position.store(0, std::memory_order_relaxed);
+    cached_read_position = 0;
+    cached_write_position = 0;
+    num_dropped.store(0, std::memory_order_relaxed);
+}
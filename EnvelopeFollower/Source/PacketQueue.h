@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+    PacketQueue.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition and the inline push and pop of the PacketQueue component class, a
+                 wait-free single-producer single-consumer ring of preallocated datagram buffers.
+    Dependencies:
+    - atomic
+    - vector
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <atomic> // Imports the c++ stdlib atomics the two ends of the ring synchronise with.
+#include <vector> // Imports the c++ stdlib vector container used for the preallocated slots.
+
+/**
+ * A ring of fixed-size packet buffers with one writer (the audio thread) and one reader (the OSC sender thread).
+ *
+ * Works like MidiEventQueue, with one difference: a packet is written in place rather than copied in. The writer
+ * asks for the next free slot with beginPush, encodes straight into it, and publishes it with endPush. The reader
+ * gets the oldest published slot with front and hands it back with pop once it has been sent. Nothing is copied or
+ * allocated on either side after prepare.
+ *
+ * A beginPush with no free slot counts a dropped packet and returns null, so a stalled reader can never stall the
+ * audio.
+ *
+ * Attributes
+ * ----------
+ * private std::vector<unsigned char> storage: Every slot, back to back.
+ * private std::vector<int> sizes: The number of bytes published in each slot.
+ * private int slot_size: The most bytes one packet can hold.
+ * private unsigned int mask: The number of slots - 1, to wrap positions.
+ * private std::atomic<unsigned int> write_position: The number of packets ever published. Only stored by the writer.
+ * private unsigned int cached_read_position: The writer's last look at read_position.
+ * private std::atomic<unsigned int> read_position: The number of packets ever popped. Only stored by the reader.
+ * private unsigned int cached_write_position: The reader's last look at write_position.
+ * private std::atomic<unsigned long long> num_dropped: The number of packets dropped because the ring was full.
+ *
+ * Methods
+ * -------
+ * public void prepare(int min_slots, int new_slot_size): Allocates the slots and clears the ring.
+ * public unsigned char* beginPush(): Returns the next free slot to write a packet into, or null if the ring is full.
+ * public void endPush(int size): Publishes the packet written since beginPush.
+ * public const unsigned char* front(int& size): Returns the oldest published packet, if there is one.
+ * public void pop(): Frees the packet returned by front.
+ * public int getSlotSize(): Returns the most bytes one packet can hold.
+ * public int getDepth(): Returns the number of packets waiting.
+ * public unsigned long long getNumDropped(): Returns the number of packets dropped because the ring was full.
+ *
+ * Owned by
+ * - OscSender
+ */
+class PacketQueue
+{
+public:
+    /**
+     * Allocates the slots and clears the ring, along with the drop count.
+     *
+     * Allocates memory and resets both ends, so should only be called while neither thread is using the ring.
+     *
+     * Arguments
+     * ---------
+     * int min_slots: The fewest packets the ring must hold. Rounded up to a power of 2.
+     * int new_slot_size: The most bytes one packet can hold.
+     */
+    void prepare(int min_slots, int new_slot_size);
+
+    /**
+     * Returns the next free slot to write a packet into. Only called by the writer.
+     *
+     * Returns
+     * -------
+     * unsigned char*: The slot, getSlotSize() bytes long, or null if the ring is full, in which case the packet is counted as dropped.
+     */
+    unsigned char* beginPush() {
+        const unsigned int position = write_position.load(std::memory_order_relaxed);
+        if (position - cached_read_position > mask) {
+            // Looks full, so take a fresh look at how far the reader has got.
+            cached_read_position = read_position.load(std::memory_order_acquire);
+        }
+        if (sizes.empty() || position - cached_read_position > mask) {
+            num_dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return storage.data() + (std::size_t) (position & mask) * slot_size;
+    };
+
+    /**
+     * Publishes the packet written into the slot from beginPush. Only called by the writer, and only after a beginPush that returned a slot.
+     *
+     * Arguments
+     * ---------
+     * int size: The number of bytes written. 0 abandons the slot without publishing anything.
+     */
+    void endPush(int size) {
+        if (size <= 0) {
+            return;
+        }
+        const unsigned int position = write_position.load(std::memory_order_relaxed);
+        sizes[position & mask] = size;
+        // Release, so the reader sees the packet before it sees the new position.
+        write_position.store(position + 1, std::memory_order_release);
+    };
+
+    /**
+     * Returns the oldest published packet without removing it. Only called by the reader.
+     *
+     * Arguments
+     * ---------
+     * int& size: Receives the number of bytes in the packet.
+     *
+     * Returns
+     * -------
+     * const unsigned char*: The packet, valid until pop, or null if the ring is empty.
+     */
+    const unsigned char* front(int& size) {
+        const unsigned int position = read_position.load(std::memory_order_relaxed);
+        if (position == cached_write_position) {
+            // Looks empty, so take a fresh look at how far the writer has got.
+            cached_write_position = write_position.load(std::memory_order_acquire);
+            if (position == cached_write_position) {
+                return nullptr;
+            }
+        }
+        size = sizes[position & mask];
+        return storage.data() + (std::size_t) (position & mask) * slot_size;
+    };
+
+    /**
+     * Frees the packet returned by front, so the writer can reuse its slot. Only called by the reader, after a front that returned a packet.
+     */
+    void pop() {
+        // Release, so the writer can't reuse the slot before the packet has been sent.
+        read_position.store(read_position.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    };
+
+    /**
+     * Returns the most bytes one packet can hold.
+     *
+     * Returns
+     * -------
+     * int: The slot size. 0 until prepare.
+     */
+    int getSlotSize() const { return slot_size; };
+
+    /**
+     * Returns the number of packets waiting to be popped. Safe from any thread, though it may be stale by the time it is used.
+     *
+     * Returns
+     * -------
+     * int: The queue depth.
+     */
+    int getDepth() const {
+        const unsigned int read = read_position.load(std::memory_order_acquire);
+        return (int) (write_position.load(std::memory_order_acquire) - read);
+    };
+
+    /**
+     * Returns the number of packets dropped because the ring was full since prepare. Safe from any thread.
+     *
+     * Returns
+     * -------
+     * unsigned long long: The drop count.
+     */
+    unsigned long long getNumDropped() const { return num_dropped.load(std::memory_order_relaxed); };
+
+private:
+    /// <summary>
+    ///     Every slot, back to back, slot_size bytes each.
+    /// </summary>
+    std::vector<unsigned char> storage;
+    /// <summary>
+    ///     The number of bytes published in each slot.
+    /// </summary>
+    std::vector<int> sizes;
+    /// <summary>
+    ///     The most bytes one packet can hold.
+    /// </summary>
+    int slot_size = 0;
+    /// <summary>
+    ///     The number of slots - 1.
+    /// </summary>
+    unsigned int mask = 0;
+    /// <summary>
+    ///     The number of packets ever published, wrapping. Only stored by the writer. On its own cache line, away from the reader's position.
+    /// </summary>
+    alignas(64) std::atomic<unsigned int> write_position { 0 };
+    /// <summary>
+    ///     The writer's last look at read_position. Only touched by the writer.
+    /// </summary>
+    unsigned int cached_read_position = 0;
+    /// <summary>
+    ///     The number of packets ever popped, wrapping. Only stored by the reader.
+    /// </summary>
+    alignas(64) std::atomic<unsigned int> read_position { 0 };
+    /// <summary>
+    ///     The reader's last look at write_position. Only touched by the reader.
+    /// </summary>
+    unsigned int cached_write_position = 0;
+    /// <summary>
+    ///     The number of packets dropped because the ring was full. Only incremented by the writer.
+    /// </summary>
+    alignas(64) std::atomic<unsigned long long> num_dropped { 0 };
+};
@@ -0,0 +1,239 @@
+/*
+  ==============================================================================
+
+    PitchTracker.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the PitchTracker component class.
+    Dependencies:
+    - PitchTracker.h
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "PitchTracker.h" // Import the interface definition for the PitchTracker component for implementation.
+
+/**
+ * Sizes the decimation, lag range, window and FFT for the sampling frequency, allocates every analysis buffer and
+ * clears the history.
+ *
+ * Allocates memory, so should only be called from prepareToPlay.
+ *
+ * Arguments
+ * ---------
+ * double freq: The number of input samples per second.
+ * int new_hop_size: The number of input samples between analyses. Rounded to whole decimated samples, at least 1.
+ */
+template <typename SampleType>
+void PitchTracker<SampleType>::prepare(double freq, int new_hop_size)
+{
+    decimation_factor = std::max((int) floor(freq / analysis_frequency), 1);
+    sampling_frequency = freq / decimation_factor;
+    anti_alias.setSmoothingLength(0);
+    anti_alias.setOrder(8);
+    anti_alias.setSamplingFrequency(freq);
+    anti_alias.setHighpass(20);
+    anti_alias.setLowpass(0.3 * sampling_frequency);
+
+    // One lag either side of the search range, for the parabola through the neighbours of a dip at either end.
+    min_lag = std::max((int) floor(sampling_frequency / max_frequency), 2);
+    max_lag = (int) ceil(sampling_frequency / min_frequency) + 1;
+    window_length = max_lag;
+    frame_length = window_length + max_lag;
+    hop_size = std::max(new_hop_size / decimation_factor, 1);
+
+    fft.prepare(frame_length);
+    fft_size = fft.getSize();
+    const int bins = fft_size / 2 + 1;
+
+    ring.assign(frame_length, (SampleType) 0);
+    frame.assign(fft_size, (SampleType) 0);
+    head.assign(fft_size, (SampleType) 0);
+    frame_real.assign(bins, (SampleType) 0);
+    frame_imaginary.assign(bins, (SampleType) 0);
+    head_real.assign(bins, (SampleType) 0);
+    head_imaginary.assign(bins, (SampleType) 0);
+    correlation.assign(fft_size, (SampleType) 0);
+    energy.assign(frame_length + 1, 0.0);
+    difference.assign(max_lag + 1, (SampleType) 1);
+    reset();
+}
+
+/**
+ * Starts or stops the tracking. Starting clears the history, so a stale pitch isn't reported.
+ *
+ * Arguments
+ * ---------
+ * bool should_be_enabled: Whether process should gather and analyse the input.
+ */
+template <typename SampleType>
+void PitchTracker<SampleType>::setEnabled(bool should_be_enabled)
+{
+    if (should_be_enabled && ! enabled) {
+        reset();
+    }
+    enabled = should_be_enabled;
+}
+
+/**
+ * Sets how deep a dip in the normalised difference must be to count as the period.
+ *
+ * Arguments
+ * ---------
+ * float new_threshold: The threshold, where 0 is a perfectly periodic signal. Clamped to between 0.01 and 1.
+ */
+template <typename SampleType>
+void PitchTracker<SampleType>::setThreshold(float new_threshold)
+{
+    threshold = (SampleType) std::min(std::max(new_threshold, 0.01f), 1.0f);
+}
+
+/**
+ * Clears the history and forgets the pitch.
+ */
+template <typename SampleType>
+void PitchTracker<SampleType>::reset()
+{
+    anti_alias.reset();
+    decimation_phase = 0;
+    std::fill(ring.begin(), ring.end(), (SampleType) 0);
+    write_index = 0;
+    since_analysis = 0;
+    voiced = false;
+    frequency = 0;
+}
+
+/**
+ * Filters, decimates and gathers a block of multichannel audio, and analyses it every hop_size decimated samples.
+ *
+ * Does nothing while disabled, or before prepare.
+ *
+ * Arguments
+ * ---------
+ * const SampleType* const* channels: One pointer per input channel to numSamples samples.
+ * int numChannels: The number of input channels. They are averaged.
+ * int numSamples: The number of samples in each channel.
+ */
+template <typename SampleType>
+void PitchTracker<SampleType>::process(const SampleType* const* channels, int numChannels, int numSamples)
+{
+    if (! enabled || frame_length == 0 || numChannels < 1) {
+        return;
+    }
+    const SampleType scale = (SampleType) 1 / numChannels;
+    int index = 0;
+    while (index < numSamples) {
+        // Mix and filter a chunk at a time, so the filter can run its block path.
+        const int length = std::min(numSamples - index, chunk_length);
+        std::copy(channels[0] + index, channels[0] + index + length, chunk);
+        for (int channel = 1; channel < numChannels; ++channel) {
+            const SampleType* source = channels[channel] + index;
+            for (int offset = 0; offset < length; ++offset) {
+                chunk[offset] += source[offset];
+            }
+        }
+        if (numChannels > 1) {
+            for (int offset = 0; offset < length; ++offset) {
+                chunk[offset] *= scale;
+            }
+        }
+        anti_alias.process(chunk, length);
+        index += length;
+
+        // Every input sample went through the filter, so its state stays continuous, but only every decimation_factor-th is kept.
+        for (int offset = decimation_factor - 1 - decimation_phase; offset < length; offset += decimation_factor) {
+            ring[write_index] = chunk[offset];
+            if (++write_index == frame_length) {
+                write_index = 0;
+            }
+            if (++since_analysis == hop_size) {
+                since_analysis = 0;
+                analyse();
+            }
+        }
+        decimation_phase = (decimation_phase + length) % decimation_factor;
+    }
+}
+
+/**
+ * Computes the cumulative mean normalised difference of the last frame, and picks the period.
+ *
+ * The cross-correlation r(tau) = sum over j < window_length of x[j] x[j + tau] is the inverse FFT of conj(H) F, for
+ * H and F the spectra of the zero padded first window and frame. Since j + tau < frame_length <= fft_size, the
+ * circular correlation never wraps, so it is exact for every lag.
+ */
+template <typename SampleType>
+void PitchTracker<SampleType>::analyse()
+{
+    // Unroll the ring from its oldest sample. The zero padding past frame_length was cleared in prepare and stays clear.
+    std::copy(ring.begin() + write_index, ring.end(), frame.begin());
+    std::copy(ring.begin(), ring.begin() + write_index, frame.begin() + (frame_length - write_index));
+    std::copy(frame.begin(), frame.begin() + window_length, head.begin());
+
+    energy[0] = 0;
+    for (int index = 0; index < frame_length; ++index) {
+        energy[index + 1] = energy[index] + (double) frame[index] * frame[index];
+    }
+    const double head_energy = energy[window_length];
+    if (head_energy < level_floor * level_floor * window_length) {
+        voiced = false;
+        return;
+    }
+
+    fft.forward(frame.data(), frame_real.data(), frame_imaginary.data());
+    fft.forward(head.data(), head_real.data(), head_imaginary.data());
+    for (int bin = 0; bin <= fft_size / 2; ++bin) {
+        // conj(H) F, written over the frame's spectrum.
+        const SampleType real = head_real[bin] * frame_real[bin] + head_imaginary[bin] * frame_imaginary[bin];
+        const SampleType imaginary = head_real[bin] * frame_imaginary[bin] - head_imaginary[bin] * frame_real[bin];
+        frame_real[bin] = real;
+        frame_imaginary[bin] = imaginary;
+    }
+    fft.inverse(frame_real.data(), frame_imaginary.data(), correlation.data());
+
+    // d(tau) = e(0) + e(tau) - 2 r(tau), normalised by its mean over lags 1 to tau.
+    difference[0] = 1;
+    double running_sum = 0;
+    for (int lag = 1; lag <= max_lag; ++lag) {
+        const double lag_energy = energy[lag + window_length] - energy[lag];
+        // Rounding in the correlation can take a near-perfect match just below 0.
+        const double value = std::max(head_energy + lag_energy - 2.0 * correlation[lag], 0.0);
+        // The correlation of this lag isn't needed again, so its slot keeps the raw difference for the interpolation.
+        correlation[lag] = (SampleType) value;
+        running_sum += value;
+        difference[lag] = running_sum > 0 ? (SampleType) (value * lag / running_sum) : (SampleType) 1;
+    }
+
+    // The first dip below the threshold, followed down to its floor. Taking the first rather than the deepest is
+    // what stops YIN jumping down an octave to a period that is a multiple of the true one.
+    int period = 0;
+    for (int lag = min_lag; lag < max_lag; ++lag) {
+        if (difference[lag] < threshold) {
+            while (lag + 1 < max_lag && difference[lag + 1] < difference[lag]) {
+                ++lag;
+            }
+            period = lag;
+            break;
+        }
+    }
+    if (period == 0) {
+        voiced = false;
+        return;
+    }
+
+    // The vertex of the parabola through the dip and its neighbours, between -0.5 and 0.5 samples away. Fitted to the
+    // raw difference, since the normalisation tilts the short lags enough to pull the vertex sideways.
+    const double before = correlation[period - 1];
+    const double at = correlation[period];
+    const double after = correlation[period + 1];
+    const double curvature = before - 2 * at + after;
+    const double shift = curvature > 0 ? std::min(std::max(0.5 * (before - after) / curvature, -0.5), 0.5) : 0.0;
+    frequency = (SampleType) (sampling_frequency / (period + shift));
+    voiced = true;
+}
+
+// The plugin uses both precisions, depending on what the host asks for.
+template class PitchTracker<float>;
+template class PitchTracker<double>;
@@ -0,0 +1,362 @@
+/*
+  ==============================================================================
+
+    PitchTracker.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition for the PitchTracker component class, a YIN fundamental frequency
+                 estimator whose difference function comes from an FFT cross-correlation, run at control rate.
+    Dependencies:
+    - algorithm
+    - math.h
+    - vector
+    - BiquadCascade.h
+    - RealFft.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <algorithm> // Imports the c++ stdlib algorithm libarary.
+#include <math.h> // Imports the basic c stdlib math library
+#include <vector> // Imports the c++ stdlib vector container used for the preallocated analysis buffers.
+#include "BiquadCascade.h" // Imports the bandpass used as the anti-aliasing filter ahead of the decimation.
+#include "RealFft.h" // Imports the real FFT the cross-correlation is computed with.
+
+/**
+ * Tracks the fundamental frequency of the input (the mean of the channels) with the YIN algorithm, so the plugin can
+ * send pitch as well as level.
+ *
+ * Nothing above a few kHz matters for a fundamental of at most max_frequency, so the input is bandpassed (which also
+ * removes DC) and decimated to about analysis_frequency first. Everything after that runs at the decimated rate,
+ * which makes each analysis about decimation_factor times shorter and the search about decimation_factor times smaller.
+ *
+ * Every hop_size decimated samples YIN looks at the last window_length + max_lag of them. For each lag tau up to max_lag the
+ * difference function d(tau) = sum over j < window_length of (x[j] - x[j + tau])^2 measures how unlike itself the
+ * signal is one period later. It is normalised by its own running mean (the cumulative mean normalised difference),
+ * the first dip below the threshold is taken as the period, and a parabola through the dip and its neighbours places
+ * it between samples.
+ *
+ * Computed directly, d costs window_length * max_lag multiplies per analysis, about 90000 even after decimation. Expanding
+ * the square, d(tau) = e(0) + e(tau) - 2 r(tau), where e(tau) is the energy of the window starting at tau (a
+ * difference of prefix sums) and r(tau) is the cross-correlation of the first window with the whole frame. The
+ * cross-correlation of every lag at once is one product of spectra, so the whole function costs three real FFTs of
+ * fft_size, the smallest power of 2 that holds the frame without the correlation wrapping around (1024 at every
+ * common sampling frequency). The anti-aliasing filter is the only per-sample cost, so the whole tracker stays far
+ * below one percent of a core.
+ *
+ * A window quieter than level_floor, or with no dip below the threshold, is unvoiced. The last voiced frequency is
+ * held through unvoiced stretches, so a pitch CC doesn't drop to 0 between notes.
+ *
+ * Attributes
+ * ----------
+ * public static constexpr double min_frequency: The lowest fundamental frequency tracked, in Hz.
+ * public static constexpr double max_frequency: The highest fundamental frequency tracked, in Hz.
+ * public static constexpr double level_floor: The RMS level below which a window is unvoiced.
+ * public static constexpr double analysis_frequency: The lowest sampling frequency the input is decimated to.
+ * private double sampling_frequency: The number of decimated samples per second.
+ * private int decimation_factor: The number of input samples per decimated sample.
+ * private int decimation_phase: The number of input samples since the last decimated sample.
+ * private BiquadCascade<SampleType> anti_alias: The bandpass ahead of the decimation.
+ * private static const int chunk_length: The number of input samples mixed and filtered at a time.
+ * private SampleType chunk[chunk_length]: The mixed and filtered input samples of the current chunk.
+ * private int min_lag, max_lag: The shortest and longest periods searched, in samples.
+ * private int window_length: The number of samples each lag's difference is summed over.
+ * private int frame_length: The number of samples each analysis looks at, window_length + max_lag.
+ * private int fft_size: The length of the cross-correlation FFTs. A power of 2 of at least frame_length.
+ * private int hop_size: The number of decimated samples between analyses.
+ * private SampleType threshold: The normalised difference a dip must fall below to count as the period.
+ * private bool enabled: Whether process gathers and analyses anything.
+ * private std::vector<SampleType> ring: The last frame_length decimated samples.
+ * private int write_index: The ring index the next sample is written to.
+ * private int since_analysis: The number of decimated samples since the last analysis.
+ * private RealFft<SampleType> fft: The FFT used for the cross-correlation.
+ * private std::vector<SampleType> frame, head: The frame unrolled from the ring, and its first window, both zero padded to fft_size.
+ * private std::vector<SampleType> frame_real, frame_imaginary, head_real, head_imaginary: Their spectra.
+ * private std::vector<SampleType> correlation: The cross-correlation of the first window with the frame, then the raw difference of each lag.
+ * private std::vector<double> energy: The prefix sums of the squared frame.
+ * private std::vector<SampleType> difference: The cumulative mean normalised difference of each lag.
+ * private bool voiced: Whether the last analysis found a period.
+ * private SampleType frequency: The last voiced fundamental frequency.
+ *
+ * Methods
+ * -------
+ * public void prepare(double freq, int new_hop_size): Sizes and allocates the analysis for the sampling frequency.
+ * public void setEnabled(bool should_be_enabled): Starts or stops the tracking.
+ * public void setThreshold(float new_threshold): Sets how deep a dip must be to count as the period.
+ * public void reset(): Clears the history and forgets the pitch.
+ * public void process(const SampleType* const* channels, int numChannels, int numSamples): Filters, decimates and gathers a block, and analyses it every hop.
+ * public bool isEnabled(): Returns whether the tracking is running.
+ * public bool isVoiced(): Returns whether the last analysis found a period.
+ * public SampleType getFrequency(): Returns the last voiced fundamental frequency.
+ * public SampleType getNote(): Returns the last voiced fundamental as a fractional MIDI note number.
+ * public int getNoteMidiValue(): Returns the nearest MIDI note number, as a 7 bit value.
+ * public int getPitchBendValue(): Returns the fractional MIDI note number as a 14 bit value.
+ * private void analyse(): Computes the difference function and picks the period.
+ *
+ * Owns
+ * - BiquadCascade
+ * - RealFft
+ *
+ * Owned by
+ * - EnvelopeFollowerAudioProcessor
+ */
+template <typename SampleType>
+class PitchTracker
+{
+public:
+    /// <summary>
+    ///     The lowest fundamental frequency tracked, in Hz. Just below the low E of a bass guitar.
+    /// </summary>
+    static constexpr double min_frequency = 40;
+    /// <summary>
+    ///     The highest fundamental frequency tracked, in Hz. Above the top of most voices and melodic instruments.
+    /// </summary>
+    static constexpr double max_frequency = 2000;
+    /// <summary>
+    ///     The RMS level (about -60 dBFS) below which a window is unvoiced, so noise floors and reverb tails don't get a pitch.
+    /// </summary>
+    static constexpr double level_floor = 0.001;
+    /// <summary>
+    ///     The lowest sampling frequency the input is decimated to, in Hz. Leaves room for the second harmonic of max_frequency.
+    /// </summary>
+    static constexpr double analysis_frequency = 11025;
+
+    /**
+     * Sizes the lag range, window and FFT for the sampling frequency, allocates every analysis buffer and clears the history.
+     *
+     * Allocates memory, so should only be called from prepareToPlay.
+     *
+     * Arguments
+     * ---------
+     * double freq: The number of input samples per second.
+     * int new_hop_size: The number of input samples between analyses. Rounded to whole decimated samples, at least 1.
+     */
+    void prepare(double freq, int new_hop_size);
+
+    /**
+     * Starts or stops the tracking. Starting clears the history, so a stale pitch isn't reported.
+     *
+     * Arguments
+     * ---------
+     * bool should_be_enabled: Whether process should gather and analyse the input.
+     */
+    void setEnabled(bool should_be_enabled);
+
+    /**
+     * Sets how deep a dip in the normalised difference must be to count as the period.
+     *
+     * Arguments
+     * ---------
+     * float new_threshold: The threshold, where 0 is a perfectly periodic signal. YIN suggests 0.1 to 0.15.
+     *                      Higher values find a pitch in noisier material but make octave errors more likely.
+     */
+    void setThreshold(float new_threshold);
+
+    /**
+     * Clears the history and forgets the pitch.
+     */
+    void reset();
+
+    /**
+     * Filters, decimates and gathers a block of multichannel audio, and analyses it every hop_size decimated samples.
+     *
+     * Does nothing while disabled, or before prepare.
+     *
+     * Arguments
+     * ---------
+     * const SampleType* const* channels: One pointer per input channel to numSamples samples.
+     * int numChannels: The number of input channels. They are averaged.
+     * int numSamples: The number of samples in each channel.
+     */
+    void process(const SampleType* const* channels, int numChannels, int numSamples);
+
+    /**
+     * Returns whether the tracking is running.
+     *
+     * Returns
+     * -------
+     * bool: True if process gathers and analyses the input.
+     */
+    bool isEnabled() const { return enabled; };
+
+    /**
+     * Returns whether the last analysis found a period.
+     *
+     * Returns
+     * -------
+     * bool: True if the last window was loud enough and periodic enough to have a pitch.
+     */
+    bool isVoiced() const { return voiced; };
+
+    /**
+     * Returns the last voiced fundamental frequency, held through unvoiced analyses.
+     *
+     * Returns
+     * -------
+     * SampleType: The frequency in Hz, or 0 if nothing has been voiced since the last reset.
+     */
+    SampleType getFrequency() const { return frequency; };
+
+    /**
+     * Returns the last voiced fundamental frequency as a fractional MIDI note number, where 69 is A4 at 440 Hz.
+     *
+     * Returns
+     * -------
+     * SampleType: The note number, between 0 and 127, or 0 if nothing has been voiced since the last reset.
+     */
+    SampleType getNote() const {
+        if (frequency <= 0) {
+            return 0;
+        }
+        const SampleType note = (SampleType) (69 + 12 * log2(frequency / 440.0));
+        return std::min(std::max(note, (SampleType) 0), (SampleType) 127);
+    };
+
+    /**
+     * Returns the nearest MIDI note number as a 7 bit value, so a CC carries the note directly (60 is middle C).
+     *
+     * Returns
+     * -------
+     * int: The note number rounded to between 0 and 127.
+     */
+    int getNoteMidiValue() const { return (int) lround(getNote()); };
+
+    /**
+     * Returns the fractional MIDI note number as a 14 bit value, for a pitch bend message.
+     *
+     * Notes 0 to 127 span the whole pitch bend range, so each semitone is 129 steps, well under a cent each.
+     *
+     * Returns
+     * -------
+     * int: The pitch, from 0 to 16383.
+     */
+    int getPitchBendValue() const { return (int) lround(getNote() / 127 * 16383); };
+
+private:
+    /**
+     * Computes the cumulative mean normalised difference of the last frame, and picks the period.
+     */
+    void analyse();
+
+    /// <summary>
+    ///     The number of decimated samples per second.
+    /// </summary>
+    double sampling_frequency = 11025;
+    /// <summary>
+    ///     The number of input samples per decimated sample.
+    /// </summary>
+    int decimation_factor = 1;
+    /// <summary>
+    ///     The number of input samples since the last decimated sample.
+    /// </summary>
+    int decimation_phase = 0;
+    /// <summary>
+    ///     The bandpass ahead of the decimation: an 8th order Butterworth from 20 Hz to 0.3 of the decimated rate.
+    /// </summary>
+    BiquadCascade<SampleType> anti_alias;
+    /// <summary>
+    ///     The number of input samples mixed and filtered at a time.
+    /// </summary>
+    static const int chunk_length = 64;
+    /// <summary>
+    ///     The mixed and filtered input samples of the current chunk.
+    /// </summary>
+    SampleType chunk[chunk_length];
+    /// <summary>
+    ///     The shortest period searched, in samples, from max_frequency.
+    /// </summary>
+    int min_lag = 2;
+    /// <summary>
+    ///     The longest period searched, in samples, from min_frequency.
+    /// </summary>
+    int max_lag = 0;
+    /// <summary>
+    ///     The number of samples each lag's difference is summed over. One longest period, so every lag sees a whole cycle.
+    /// </summary>
+    int window_length = 0;
+    /// <summary>
+    ///     The number of samples each analysis looks at, window_length + max_lag.
+    /// </summary>
+    int frame_length = 0;
+    /// <summary>
+    ///     The length of the cross-correlation FFTs. A power of 2 of at least frame_length, so no lag wraps around.
+    /// </summary>
+    int fft_size = 0;
+    /// <summary>
+    ///     The number of decimated samples between analyses.
+    /// </summary>
+    int hop_size = 1;
+    /// <summary>
+    ///     The normalised difference a dip must fall below to count as the period.
+    /// </summary>
+    SampleType threshold = (SampleType) 0.15;
+    /// <summary>
+    ///     Whether process gathers and analyses anything.
+    /// </summary>
+    bool enabled = false;
+
+    /// <summary>
+    ///     The last frame_length decimated samples, as a ring.
+    /// </summary>
+    std::vector<SampleType> ring;
+    /// <summary>
+    ///     The ring index the next sample is written to, which is also the oldest sample.
+    /// </summary>
+    int write_index = 0;
+    /// <summary>
+    ///     The number of decimated samples since the last analysis.
+    /// </summary>
+    int since_analysis = 0;
+    /// <summary>
+    ///     The FFT used for the cross-correlation.
+    /// </summary>
+    RealFft<SampleType> fft;
+    /// <summary>
+    ///     The frame unrolled from the ring, oldest first, zero padded to fft_size.
+    /// </summary>
+    std::vector<SampleType> frame;
+    /// <summary>
+    ///     The first window_length samples of the frame, zero padded to fft_size.
+    /// </summary>
+    std::vector<SampleType> head;
+    /// <summary>
+    ///     The real part of the spectrum of the frame.
+    /// </summary>
+    std::vector<SampleType> frame_real;
+    /// <summary>
+    ///     The imaginary part of the spectrum of the frame.
+    /// </summary>
+    std::vector<SampleType> frame_imaginary;
+    /// <summary>
+    ///     The real part of the spectrum of the first window.
+    /// </summary>
+    std::vector<SampleType> head_real;
+    /// <summary>
+    ///     The imaginary part of the spectrum of the first window.
+    /// </summary>
+    std::vector<SampleType> head_imaginary;
+    /// <summary>
+    ///     The cross-correlation of the first window with the frame, for every lag. Overwritten with the raw difference d(tau).
+    /// </summary>
+    std::vector<SampleType> correlation;
+    /// <summary>
+    ///     The prefix sums of the squared frame, in double precision so the differences of large sums stay exact enough.
+    /// </summary>
+    std::vector<double> energy;
+    /// <summary>
+    ///     The cumulative mean normalised difference of each lag up to max_lag.
+    /// </summary>
+    std::vector<SampleType> difference;
+    /// <summary>
+    ///     Whether the last analysis found a period.
+    /// </summary>
+    bool voiced = false;
+    /// <summary>
+    ///     The last voiced fundamental frequency in Hz, or 0.
+    /// </summary>
+    SampleType frequency = 0;
+};
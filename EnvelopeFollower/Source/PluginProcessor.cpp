@@ -23,6 +23,7 @@
 #include "PluginProcessor.h" // Import the interface definition for the implementations in this file.
 #include "PluginEditor.h" // Import the interface definition for the GUI manager component so it can be reference by the implementation.
 #include <math.h> // Import the standard math library for usage in the implementation.
+#include <chrono> // Import the c++ stdlib clocks, for the wall-clock time the OSC bundles are tagged with.
 
 
 /*
@@ -80,6 +81,37 @@ EnvelopeFollowerAudioProcessor::EnvelopeFollowerAudioProcessor()
     low_pass_user_param = new juce::AudioParameterFloat("low pass", "low pass", juce::NormalisableRange<float> (0.0, 20000.0), 20000.0);
     hi_pass_user_param = new juce::AudioParameterFloat("high pass", "high pass", juce::NormalisableRange<float> (0.0, 20000.0), 0.0);
     recovery_user_param = new juce::AudioParameterFloat("recovery time", "recovery time", juce::NormalisableRange<float>(0.0, 1.0), 0.0);
+    filter_order_user_param = new juce::AudioParameterChoice("filter order", "filter order", juce::StringArray { "6 dB/oct", "12 dB/oct", "24 dB/oct", "48 dB/oct", "12 dB/oct SVF" }, 0);
+    filter_alignment_user_param = new juce::AudioParameterChoice("filter alignment", "filter alignment", juce::StringArray { "Butterworth", "Linkwitz-Riley" }, 0);
+    detector_user_param = new juce::AudioParameterChoice("detector", "detector", juce::StringArray { "Peak", "RMS", "True peak", "Analytic" }, 0);
+    rms_window_user_param = new juce::AudioParameterFloat("rms window", "rms window", juce::NormalisableRange<float> (1.0, 2000.0), 50.0);
+    hold_user_param = new juce::AudioParameterFloat("hold", "hold", juce::NormalisableRange<float> (0.0, 1000.0), 0.0);
+    attack_user_param = new juce::AudioParameterFloat("attack time", "attack time", juce::NormalisableRange<float>(0.0, 1.0), 0.0);
+    channel_mode_user_param = new juce::AudioParameterChoice("channel mode", "channel mode", juce::StringArray { "Downmix", "Per channel" }, 0);
+    downmix_user_param = new juce::AudioParameterChoice("downmix", "downmix", juce::StringArray { "Mean", "Max abs", "Mid", "Side", "Power sum" }, 0);
+    lookahead_user_param = new juce::AudioParameterFloat("lookahead", "lookahead", juce::NormalisableRange<float> (0.0, 50.0), 0.0);
+    bands_user_param = new juce::AudioParameterInt("bands", "bands", 0, SignalProcessor<float>::max_bands, 0);
+    band_cc_user_param = new juce::AudioParameterInt("band cc", "band cc", 0, 127, 64);
+    centroid_user_param = new juce::AudioParameterBool("centroid", "centroid", false);
+    rolloff_user_param = new juce::AudioParameterBool("rolloff", "rolloff", false);
+    flatness_user_param = new juce::AudioParameterBool("flatness", "flatness", false);
+    flux_user_param = new juce::AudioParameterBool("flux", "flux", false);
+    spectral_bands_user_param = new juce::AudioParameterInt("spectral bands", "spectral bands", 0, SpectralFeatures<float>::max_bands, 0);
+    spectral_cc_user_param = new juce::AudioParameterInt("spectral cc", "spectral cc", 0, 127, 80);
+    onsets_user_param = new juce::AudioParameterBool("onsets", "onsets", false);
+    onset_sensitivity_user_param = new juce::AudioParameterFloat("onset sensitivity", "onset sensitivity", juce::NormalisableRange<float> (1.0, 24.0), 6.0);
+    onset_note_user_param = new juce::AudioParameterInt("onset note", "onset note", 0, 127, 36);
+    pitch_output_user_param = new juce::AudioParameterChoice("pitch output", "pitch output", juce::StringArray { "Off", "CC", "Pitch bend" }, 0);
+    pitch_threshold_user_param = new juce::AudioParameterFloat("pitch threshold", "pitch threshold", juce::NormalisableRange<float> (0.05, 0.5), 0.15);
+    midi_output_user_param = new juce::AudioParameterChoice("midi output", "midi output", juce::StringArray { "Device", "Host", "Device and host" }, 0);
+    cc_clock_user_param = new juce::AudioParameterChoice("cc clock", "cc clock", juce::StringArray { "Rate", "Every block", "Every sample" }, 0);
+    // Skewed so the slider spends as much travel below 30 Hz as above it.
+    cc_rate_user_param = new juce::AudioParameterFloat("cc rate", "cc rate", juce::NormalisableRange<float> (1.0, 1000.0, 0.0, 0.3), 10.0);
+    cc_delta_user_param = new juce::AudioParameterInt("cc delta", "cc delta", 0, 16, 0);
+    cc_interval_user_param = new juce::AudioParameterFloat("cc interval", "cc interval", juce::NormalisableRange<float> (0.0, 1000.0), 0.0);
+    cc_format_user_param = new juce::AudioParameterChoice("cc format", "cc format", juce::StringArray { "7-bit", "14-bit", "NRPN" }, 0);
+    osc_output_user_param = new juce::AudioParameterBool("osc output", "osc output", false);
+    detector_rate_user_param = new juce::AudioParameterChoice("detector rate", "detector rate", juce::StringArray { "Full rate", "4 kHz", "2 kHz", "1 kHz" }, 0);
 
     // Register each user managed parameter to be deleted when this processor is deleted.
     addParameter(gain_user_param);
@@ -88,14 +120,51 @@ EnvelopeFollowerAudioProcessor::EnvelopeFollowerAudioProcessor()
     addParameter(low_pass_user_param);
     addParameter(hi_pass_user_param);
     addParameter(recovery_user_param);
+    addParameter(filter_order_user_param);
+    addParameter(filter_alignment_user_param);
+    addParameter(detector_user_param);
+    addParameter(rms_window_user_param);
+    addParameter(hold_user_param);
+    addParameter(attack_user_param);
+    addParameter(detector_rate_user_param);
+    addParameter(channel_mode_user_param);
+    addParameter(downmix_user_param);
+    addParameter(lookahead_user_param);
+    addParameter(bands_user_param);
+    addParameter(band_cc_user_param);
+    addParameter(centroid_user_param);
+    addParameter(rolloff_user_param);
+    addParameter(flatness_user_param);
+    addParameter(flux_user_param);
+    addParameter(spectral_bands_user_param);
+    addParameter(spectral_cc_user_param);
+    addParameter(onsets_user_param);
+    addParameter(onset_sensitivity_user_param);
+    addParameter(onset_note_user_param);
+    addParameter(pitch_output_user_param);
+    addParameter(pitch_threshold_user_param);
+    addParameter(midi_output_user_param);
+    addParameter(cc_clock_user_param);
+    addParameter(cc_rate_user_param);
+    addParameter(cc_delta_user_param);
+    addParameter(cc_interval_user_param);
+    addParameter(cc_format_user_param);
+    addParameter(osc_output_user_param);
 
-    // Set the number of MIDI messages output per second to ten.
-    midi_message_rate = 10;
+    // Listen for changes to every parameter so updateMathParams only rebuilds what moved.
+    for (auto* param : getParameters())
+        param->addListener(this);
+
+    // Only the target for now. The sender thread isn't started until timerCallback sees the OSC output switched on.
+    osc_sender.setTarget(osc_host, osc_port);
+    startTimer(100);
 }
 
 EnvelopeFollowerAudioProcessor::~EnvelopeFollowerAudioProcessor()
 {
-    
+    for (auto* param : getParameters())
+        param->removeListener(this);
+    stopTimer();
 }
 
 /**
@@ -268,14 +337,50 @@ void EnvelopeFollowerAudioProcessor::changeProgramName (int index, const juce::S
  */
 void EnvelopeFollowerAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    // Set the number of audio samples the audio processing pipeline should expect per second.
+    // Set the number of audio samples the audio processing pipelines should expect per second.
     signalProcessor.setSamplingFrequency(sampleRate);
+    doubleSignalProcessor.setSamplingFrequency(sampleRate);
+    // Preallocate the envelope traces and display buffers so that processBlock doesn't allocate on the audio thread.
+    signalProcessor.setMaximumBlockSize(samplesPerBlock);
+    doubleSignalProcessor.setMaximumBlockSize(samplesPerBlock);
+    // Likewise the lookahead delay, which needs room for every input channel.
+    signalProcessor.setNumChannels(getTotalNumInputChannels());
+    doubleSignalProcessor.setNumChannels(getTotalNumInputChannels());
+    // One processor per input channel for the per-channel mode. Only the precision in use gets them, since each holds its own history.
+    if (isUsingDoublePrecision()) {
+        prepareChannelProcessors(double_channel_processors, double_channel_bank, getTotalNumInputChannels(), sampleRate, samplesPerBlock);
+        prepareChannelProcessors(channel_processors, channel_bank, 0, sampleRate, samplesPerBlock);
+    } else {
+        prepareChannelProcessors(channel_processors, channel_bank, getTotalNumInputChannels(), sampleRate, samplesPerBlock);
+        prepareChannelProcessors(double_channel_processors, double_channel_bank, 0, sampleRate, samplesPerBlock);
+    }
+    // The processors start from silence, so there is no envelope to hand over to the bank.
+    channel_bank_active = false;
+    // The spectral feature engines are small enough to prepare in both precisions.
+    spectral_features.prepare(sampleRate, spectral_fft_size, spectral_hop_size);
+    double_spectral_features.prepare(sampleRate, spectral_fft_size, spectral_hop_size);
+    onset_detector.prepare(sampleRate, samplesPerBlock);
+    double_onset_detector.prepare(sampleRate, samplesPerBlock);
+    pitch_tracker.prepare(sampleRate, pitch_hop_size);
+    double_pitch_tracker.prepare(sampleRate, pitch_hop_size);
+    vis_samples.setSize(1, samplesPerBlock);
+    vis_input.setSize(getTotalNumInputChannels(), samplesPerBlock);
+    // processBlock splits any bigger block into chunks of this size.
+    prepared_block_size = samplesPerBlock;
+    // Reapply every parameter on the next block, in case anything depends on the sampling frequency.
+    dirty_params = ~(juce::uint64) 0;
     
-    // Set the number of audio samples that should be processed per produced MIDI message.
-    samples_per_midi_message = (int) (sampleRate / midi_message_rate);
+    // The number of audio samples per CC tick is set from the rate on the next block, with everything else.
     // Reset the number of audio samples that have been processed since the last MIDI output/GUI state update.
     elapsed_since_midi = 0;
     elapsed_since_drawer = 0;
+    // The receiver may have been reset too, so send every value once more.
+    send_gate.reset();
+    // Any OSC packet left open belongs to the old stream, so let it go unsent.
+    if (osc_packet != nullptr) {
+        osc_sender.endPacket(0);
+        osc_packet = nullptr;
+    }
 
     // Clear the rolling buffers for both the envelope and the input waveform displays.
     EnvVisualiser.clear();
@@ -287,6 +392,37 @@ void EnvelopeFollowerAudioProcessor::prepareToPlay (double sampleRate, int sampl
     makeMIDIOutputDevice();
 }
 
+/**
+ * Allocates and prepares one SignalProcessor per input channel for the per-channel mode, and the envelope bank with a lane for each.
+ *
+ * Allocates memory, so should only be called from prepareToPlay. Their parameters are applied on the next block, as prepareToPlay marks every parameter dirty.
+ *
+ * Arguments
+ * ---------
+ * std::vector<SignalProcessor<SampleType>>& channelProcessors: The per-channel processors to resize and prepare.
+ * EnvelopeBank<SampleType>& channelBank: The per-channel envelope bank to prepare, with one lane per channel.
+ * int num_channels: The number of input channels. 0 releases the processors.
+ * double sampleRate: The number of audio samples per second.
+ * int samplesPerBlock: The largest block the host will send.
+ */
+template <typename SampleType>
+void EnvelopeFollowerAudioProcessor::prepareChannelProcessors(std::vector<SignalProcessor<SampleType>>& channelProcessors, EnvelopeBank<SampleType>& channelBank, int num_channels, double sampleRate, int samplesPerBlock)
+{
+    if (num_channels == 0) {
+        // Release the histories rather than just emptying the vector.
+        std::vector<SignalProcessor<SampleType>>().swap(channelProcessors);
+        channelBank.prepare(0, 0);
+        return;
+    }
+    channelProcessors.resize(juce::jmin(num_channels, (int) max_channels));
+    for (SignalProcessor<SampleType>& channelProcessor : channelProcessors) {
+        channelProcessor.setSamplingFrequency(sampleRate);
+        channelProcessor.setMaximumBlockSize(samplesPerBlock);
+    }
+    channelBank.prepare((int) channelProcessors.size(), samplesPerBlock);
+    channelBank.setSamplingFrequency(sampleRate);
+}
+
 /**
  * Creates a MIDI output device for us to send MIDI to. This proved to work more consistently than sending to the IAC driver bus.
  */
@@ -299,13 +435,16 @@ void EnvelopeFollowerAudioProcessor::makeMIDIOutputDevice()
     const juce::MessageManagerLock mmLock;
     // In case multiple instances of the plugin are running, each one
     // needs to have its own unique Midi Device, with a unique name.
-    output_device = nullptr;
+    // Stop the sender thread and release our old device first, so its name is free to be taken again.
+    midi_sender.setOutputDevice(nullptr);
     std::string name;
     std::string base_name = "Envelope Follower Midi Device ";
     for (int i = 0; i < MAX_INSTANCES; i++) {
         name = base_name + std::to_string(i);
-        output_device = juce::MidiOutput::createNewDevice(name);
+        std::unique_ptr<juce::MidiOutput> output_device = juce::MidiOutput::createNewDevice(name);
         if (output_device) {
+            // The sender thread owns the device from here, and is the only thread that sends to it.
+            midi_sender.setOutputDevice(std::move(output_device));
             return;
         }
     }
@@ -327,7 +466,7 @@ void EnvelopeFollowerAudioProcessor::releaseResources() { }
 /**
  * Checks whether a given arrangement of input, output and throughput audio and MIDI buffers can be processed by this plugin.
  *
- * Only returns true if the input layout is mono (one buffer) or stereo (two buffers) and the output layout matches the input layout as that is all this plugin supports.
+ * Only returns true if the input layout has between 1 and max_channels (64) channels and the output layout matches the input layout, as that is all this plugin supports.
  * All other inputs return false.
  *
  * Arguments
@@ -344,9 +483,9 @@ bool EnvelopeFollowerAudioProcessor::isBusesLayoutSupported (const BusesLayout&
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // Reject the layout if the input isn't mono (one channel) or stereo (two channels).
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Reject the layout if it has no channels, or more than the per-channel mode can follow.
+    const int num_channels = layouts.getMainOutputChannelSet().size();
+    if (num_channels < 1 || num_channels > max_channels)
         return false;
 
    #if ! JucePlugin_IsSynth
@@ -362,7 +501,54 @@ bool EnvelopeFollowerAudioProcessor::isBusesLayoutSupported (const BusesLayout&
 #endif
 
 /**
- * Updates the parameters of the SignalProcessor component from locally held values.
+ * Updates the parameters of the SignalProcessor, SpectralFeatures, OnsetDetector and PitchTracker components from locally held values.
+ *
+ * Takes the set of parameters that changed since the last call and applies it to the downmix processor, to every per-channel processor
+ * and lane of the per-channel envelope bank, to the spectral feature engine, to the onset detector, to the pitch tracker and to the CC clock.
+ *
+ * Arguments
+ * ---------
+ * SignalProcessor<SampleType>& processor: The signal processor of the precision currently in use.
+ * std::vector<SignalProcessor<SampleType>>& channelProcessors: The per-channel signal processors of the same precision.
+ * EnvelopeBank<SampleType>& channelBank: The per-channel envelope bank of the same precision.
+ * SpectralFeatures<SampleType>& spectral: The spectral feature engine of the same precision.
+ * OnsetDetector<SampleType>& onsets: The onset detector of the same precision.
+ * PitchTracker<SampleType>& pitch: The pitch tracker of the same precision.
+ */
+template <typename SampleType>
+void EnvelopeFollowerAudioProcessor::updateMathParams(SignalProcessor<SampleType>& processor, std::vector<SignalProcessor<SampleType>>& channelProcessors, EnvelopeBank<SampleType>& channelBank, SpectralFeatures<SampleType>& spectral, OnsetDetector<SampleType>& onsets, PitchTracker<SampleType>& pitch)
+{
+    // Take the set of parameters that changed since the last block, and clear it.
+    const juce::uint64 dirty = dirty_params.exchange(0);
+    // Nothing moved, so there is nothing to recompute.
+    if (dirty == 0)
+        return;
+
+    applyMathParams(processor, dirty);
+    // The per-channel processors get the same settings, so switching modes doesn't need a catch-up.
+    for (SignalProcessor<SampleType>& channelProcessor : channelProcessors) {
+        applyMathParams(channelProcessor, dirty);
+    }
+    // The bank lanes only take the gain, cutoffs, recovery time and downmix, and rebuilding them costs a tan() and pow() or two each.
+    if (isParamDirty(dirty, gain_user_param) || isParamDirty(dirty, low_pass_user_param) || isParamDirty(dirty, hi_pass_user_param)
+        || isParamDirty(dirty, recovery_user_param) || isParamDirty(dirty, downmix_user_param)) {
+        for (int lane = 0; lane < channelBank.getNumLanes(); ++lane) {
+            processor.configureBankLane(channelBank, lane);
+        }
+    }
+    applySpectralParams(spectral, dirty);
+    applyOnsetParams(onsets, dirty);
+    applyPitchParams(pitch, dirty);
+    applyMidiParams(dirty);
+}
+
+/**
+ * Applies the changed parameters to one SignalProcessor component.
+ *
+ * Arguments
+ * ---------
+ * SignalProcessor<SampleType>& processor: The signal processor to update.
+ * juce::uint64 dirty: The snapshot of dirty_params taken by updateMathParams.
  *
  * Responsible for updating:
  * - SignalProcessor::min_val
@@ -371,28 +557,385 @@ bool EnvelopeFollowerAudioProcessor::isBusesLayoutSupported (const BusesLayout&
  * - SignalProcessor::lowFilter::cutoff_frequency
  * - SignalProcessor::highFilter::cutoff_frequency
  * - SignalProcessor::recovery_time and SignalProcessor::decay
+ * - SignalProcessor::filter_order, SignalProcessor::state_variable and the alignment of SignalProcessor::cascade
+ * - SignalProcessor::detector_mode and SignalProcessor::rms_window_time
+ * - SignalProcessor::hold_time
+ * - SignalProcessor::attack_time and SignalProcessor::attack
+ * - SignalProcessor::detector_rate and SignalProcessor::decimation
+ * - SignalProcessor::num_bands
+ * - SignalProcessor::lookahead_time, and the latency reported to the host
+ * - SignalProcessor::downmix_mode
  */
-void EnvelopeFollowerAudioProcessor::updateMathParams()
+template <typename SampleType>
+void EnvelopeFollowerAudioProcessor::applyMathParams(SignalProcessor<SampleType>& processor, juce::uint64 dirty)
 {
     // TODO: Don't use the user param values: those are in units like
     // decibels and percents. Instead, we need to first convert them
     // to linear gain and midi scaled values (i.e. 0-127 instead of 0-100).
-    
-    // Fetch the values of the user-managed parameters rescaled to be functional.    
-    float amp_gain = pow(10.0, (gain_user_param->get() / 20.0)); // source: https://en.wikipedia.org/wiki/Decibel
-    float min_value_scaled = (min_pos_user_param->get() / 100.0) * 127.0;
-    float max_value_scaled = (max_pos_user_param->get() / 100.0) * 127.0;
-    float lowpass_value = low_pass_user_param->get();
-    float highpass_value = hi_pass_user_param->get();
-    float recovery_time = recovery_user_param->get();
-    
-    // Update the values of the parameters on the signal processing pipeline.
-    signalProcessor.setMaxValue(max_value_scaled);
-    signalProcessor.setMinValue(min_value_scaled);
-    signalProcessor.setGainValue(amp_gain);
-    signalProcessor.setLowpassValue(lowpass_value);
-    signalProcessor.setHighpassValue(highpass_value);
-    signalProcessor.setRecoveryTimeValue(recovery_time);
+
+    // Fetch the values of the changed user-managed parameters rescaled to be functional,
+    // and update them on the signal processing pipeline.
+    if (isParamDirty(dirty, gain_user_param)) {
+        float amp_gain = pow(10.0, (gain_user_param->get() / 20.0)); // source: https://en.wikipedia.org/wiki/Decibel
+        processor.setGainValue(amp_gain);
+    }
+    if (isParamDirty(dirty, min_pos_user_param)) {
+        float min_value_scaled = (min_pos_user_param->get() / 100.0) * 127.0;
+        processor.setMinValue(min_value_scaled);
+    }
+    if (isParamDirty(dirty, max_pos_user_param)) {
+        float max_value_scaled = (max_pos_user_param->get() / 100.0) * 127.0;
+        processor.setMaxValue(max_value_scaled);
+    }
+    if (isParamDirty(dirty, low_pass_user_param)) {
+        processor.setLowpassValue(low_pass_user_param->get());
+    }
+    if (isParamDirty(dirty, hi_pass_user_param)) {
+        processor.setHighpassValue(hi_pass_user_param->get());
+    }
+    if (isParamDirty(dirty, recovery_user_param)) {
+        processor.setRecoveryTimeValue(recovery_user_param->get());
+    }
+    if (isParamDirty(dirty, filter_alignment_user_param)) {
+        processor.setFilterAlignment((typename BiquadCascade<SampleType>::Alignment) filter_alignment_user_param->getIndex());
+    }
+    if (isParamDirty(dirty, filter_order_user_param)) {
+        // The last choice is the state variable filter, which has a fixed 12 dB/octave slope.
+        const int filter_choice = filter_order_user_param->getIndex();
+        const bool state_variable = filter_choice == filter_order_user_param->choices.size() - 1;
+        processor.setStateVariableMode(state_variable);
+        if (!state_variable) {
+            // The other choices are 6, 12, 24 and 48 dB/octave, so the order is 1, 2, 4 or 8.
+            processor.setFilterOrder(1 << filter_choice);
+        }
+    }
+    if (isParamDirty(dirty, detector_user_param)) {
+        processor.setDetectorMode((typename SignalProcessor<SampleType>::DetectorMode) detector_user_param->getIndex());
+    }
+    if (isParamDirty(dirty, rms_window_user_param)) {
+        processor.setRmsWindowTime(rms_window_user_param->get() / 1000.0f);
+    }
+    if (isParamDirty(dirty, hold_user_param)) {
+        processor.setHoldTime(hold_user_param->get() / 1000.0f);
+    }
+    if (isParamDirty(dirty, attack_user_param)) {
+        processor.setAttackTimeValue(attack_user_param->get());
+    }
+    if (isParamDirty(dirty, detector_rate_user_param)) {
+        // The choices after full rate are 4, 2 and 1 kHz.
+        const int rate_choice = detector_rate_user_param->getIndex();
+        processor.setDetectorRate(rate_choice == 0 ? 0.0f : 8000.0f / (1 << rate_choice));
+    }
+    if (isParamDirty(dirty, lookahead_user_param)) {
+        processor.setLookaheadTime(lookahead_user_param->get() / 1000.0f);
+        // The audio is delayed by the lookahead, so the host has to compensate for it.
+        if (getLatencySamples() != processor.getLookaheadSamples()) {
+            setLatencySamples(processor.getLookaheadSamples());
+        }
+    }
+    if (isParamDirty(dirty, downmix_user_param)) {
+        processor.setDownmixMode((typename SignalProcessor<SampleType>::DownmixMode) downmix_user_param->getIndex());
+    }
+    if (isParamDirty(dirty, bands_user_param)) {
+        processor.setNumBands(bands_user_param->get());
+    }
+}
+
+/**
+ * Applies the changed parameters to the SpectralFeatures component.
+ *
+ * Responsible for updating:
+ * - SpectralFeatures::enabled_features
+ * - SpectralFeatures::num_bands
+ *
+ * Arguments
+ * ---------
+ * SpectralFeatures<SampleType>& spectral: The spectral feature engine to update.
+ * juce::uint64 dirty: The snapshot of dirty_params taken by updateMathParams.
+ */
+template <typename SampleType>
+void EnvelopeFollowerAudioProcessor::applySpectralParams(SpectralFeatures<SampleType>& spectral, juce::uint64 dirty)
+{
+    typedef typename SpectralFeatures<SampleType>::Feature Feature;
+    if (isParamDirty(dirty, centroid_user_param) || isParamDirty(dirty, rolloff_user_param)
+        || isParamDirty(dirty, flatness_user_param) || isParamDirty(dirty, flux_user_param)) {
+        int mask = 0;
+        mask |= centroid_user_param->get() ? 1 << (int) Feature::centroid : 0;
+        mask |= rolloff_user_param->get() ? 1 << (int) Feature::rolloff : 0;
+        mask |= flatness_user_param->get() ? 1 << (int) Feature::flatness : 0;
+        mask |= flux_user_param->get() ? 1 << (int) Feature::flux : 0;
+        spectral.setEnabledFeatures(mask);
+    }
+    if (isParamDirty(dirty, spectral_bands_user_param)) {
+        spectral.setNumBands(spectral_bands_user_param->get());
+    }
+}
+
+/**
+ * Applies the changed parameters to the OnsetDetector component.
+ *
+ * Responsible for updating:
+ * - OnsetDetector::threshold_ratio
+ *
+ * Arguments
+ * ---------
+ * OnsetDetector<SampleType>& onsets: The onset detector to update.
+ * juce::uint64 dirty: The snapshot of dirty_params taken by updateMathParams.
+ */
+template <typename SampleType>
+void EnvelopeFollowerAudioProcessor::applyOnsetParams(OnsetDetector<SampleType>& onsets, juce::uint64 dirty)
+{
+    if (isParamDirty(dirty, onset_sensitivity_user_param)) {
+        onsets.setSensitivity(onset_sensitivity_user_param->get());
+    }
+    if (isParamDirty(dirty, onsets_user_param) && onsets_user_param->get()) {
+        // Start from silence rather than from whatever was playing when it was last switched off.
+        onsets.reset();
+    }
+}
+
+/**
+ * Applies the changed parameters to the PitchTracker component.
+ *
+ * Responsible for updating:
+ * - PitchTracker::enabled
+ * - PitchTracker::threshold
+ *
+ * Arguments
+ * ---------
+ * PitchTracker<SampleType>& pitch: The pitch tracker to update.
+ * juce::uint64 dirty: The snapshot of dirty_params taken by updateMathParams.
+ */
+template <typename SampleType>
+void EnvelopeFollowerAudioProcessor::applyPitchParams(PitchTracker<SampleType>& pitch, juce::uint64 dirty)
+{
+    if (isParamDirty(dirty, pitch_threshold_user_param)) {
+        pitch.setThreshold(pitch_threshold_user_param->get());
+    }
+    if (isParamDirty(dirty, pitch_output_user_param)) {
+        // Either output needs the same tracking, so only switching it off stops the analysis.
+        pitch.setEnabled(pitch_output_user_param->getIndex() != 0);
+    }
+}
+
+/**
+ * Applies the changed CC clock, send-on-delta and CC format parameters.
+ *
+ * Responsible for updating:
+ * - EnvelopeFollowerAudioProcessor::samples_per_midi_message
+ * - SendOnDelta::delta
+ * - SendOnDelta::min_interval
+ * - MidiEncoder::format
+ *
+ * Arguments
+ * ---------
+ * juce::uint64 dirty: The snapshot of dirty_params taken by updateMathParams.
+ */
+void EnvelopeFollowerAudioProcessor::applyMidiParams(juce::uint64 dirty)
+{
+    // Both depend on the sampling frequency, which prepareToPlay marks every parameter dirty for.
+    if (isParamDirty(dirty, cc_rate_user_param)) {
+        samples_per_midi_message = juce::jmax((int) (getSampleRate() / cc_rate_user_param->get()), 1);
+    }
+    if (isParamDirty(dirty, cc_interval_user_param)) {
+        send_gate.setMinInterval((long long) (getSampleRate() * cc_interval_user_param->get() / 1000.0));
+    }
+    if (isParamDirty(dirty, cc_delta_user_param)) {
+        send_gate.setDelta(cc_delta_user_param->get());
+    }
+    if (isParamDirty(dirty, cc_format_user_param)) {
+        // The choices line up with the first three formats. Packets have no MIDI 1.0 transport to go out on, so they aren't offered.
+        midi_encoder.setFormat((MidiEncoder::Format) cc_format_user_param->getIndex());
+    }
+    if (isParamDirty(dirty, midi_output_user_param) || isParamDirty(dirty, cc_format_user_param)) {
+        // A destination that has just been switched on, or a receiver listening for the new format, hasn't seen any of the values sent so far.
+        send_gate.reset();
+    }
+}
+
+/**
+ * Rescales an envelope value into the level a CC sends.
+ *
+ * The 7-bit format goes through getEnvelopePosition, so it keeps the truncation it has always had and sends the values it always has.
+ * The finer formats take the unrounded level, so they get every step of their resolution.
+ *
+ * Arguments
+ * ---------
+ * SignalProcessor<SampleType>& processor: The signal processor whose output range applies.
+ * SampleType envelope_position: The envelope value to rescale.
+ *
+ * Returns
+ * -------
+ * double: The level, from 0 to 1.
+ */
+template <typename SampleType>
+double EnvelopeFollowerAudioProcessor::getOutputLevel(SignalProcessor<SampleType>& processor, SampleType envelope_position) const
+{
+    if (midi_encoder.getFormat() == MidiEncoder::Format::cc7) {
+        return processor.getEnvelopePosition(envelope_position) / 127.0;
+    }
+    return processor.getEnvelopeLevel(envelope_position);
+}
+
+/**
+ * Writes one CC tick's values into the open OSC packet, as a bundle time-tagged with the moment of the tick's sample.
+ *
+ * Every value goes out unrounded, as a float from 0 to 1, whatever the CC format. The addresses are fixed, so a receiver
+ * doesn't need to know the CC numbers:
+ * - /envelope: the main envelope.
+ * - /channel/n: the envelope of input channel n, counting from 1, in the per-channel mode.
+ * - /band/n: the envelope of band n, counting from 1, while the bands are on.
+ * - /centroid, /rolloff, /flatness and /flux: each spectral feature that is on.
+ * - /spectrum/n: the energy in spectral band n, counting from 1.
+ * - /pitch: the fractional MIDI note number, once the pitch output is on and has heard a voiced note. Not rescaled.
+ *
+ * If the bundle doesn't fit in what is left of the packet, the packet is sent as it is and the bundle is written again into a fresh one.
+ *
+ * Arguments
+ * ---------
+ * int index: The index of the sample within the block that the tick falls on.
+ * unsigned long long time_tag: The time of that sample, as an NTP time tag.
+ * SignalProcessor<SampleType>& processor: The signal processor of the precision in use.
+ * const SampleType* const* envelope_traces: The envelope after every sample, one trace per envelope.
+ * int trace_stride: The distance between one sample's envelope and the next in each trace.
+ * int num_envelopes: The number of traces.
+ * bool per_channel: Whether the traces are the per-channel envelopes rather than the downmix.
+ * SpectralFeatures<SampleType>& spectral: The spectral feature engine of the same precision.
+ * PitchTracker<SampleType>& pitch: The pitch tracker of the same precision.
+ */
+template <typename SampleType>
+void EnvelopeFollowerAudioProcessor::writeOscTick(int index, unsigned long long time_tag, SignalProcessor<SampleType>& processor, const SampleType* const* envelope_traces, int trace_stride, int num_envelopes, bool per_channel, SpectralFeatures<SampleType>& spectral, PitchTracker<SampleType>& pitch)
+{
+    // In the order of SpectralFeatures<SampleType>::Feature.
+    static const char* const feature_addresses[] = { "/centroid", "/rolloff", "/flatness", "/flux" };
+    // A second try, into an empty packet, is all a bundle gets. One that doesn't fit in an empty packet never will.
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (!openOscPacket()) {
+            return;
+        }
+        const int mark = osc_encoder.getSize();
+        osc_encoder.beginBundle(time_tag);
+        osc_encoder.addMessage("/envelope", (float) processor.getEnvelopeLevel(envelope_traces[0][index * trace_stride]));
+        if (per_channel) {
+            for (int channel = 0; channel < num_envelopes; ++channel) {
+                osc_encoder.addMessage("/channel", channel + 1, (float) processor.getEnvelopeLevel(envelope_traces[channel][index * trace_stride]));
+            }
+        } else {
+            for (int band = 0; band < processor.getNumBands(); ++band) {
+                osc_encoder.addMessage("/band", band + 1, (float) processor.getBandEnvelopeLevel(band, index));
+            }
+        }
+        for (int feature = 0; feature < SpectralFeatures<SampleType>::num_features; ++feature) {
+            const auto spectral_feature = (typename SpectralFeatures<SampleType>::Feature) feature;
+            if (spectral.isEnabled(spectral_feature)) {
+                osc_encoder.addMessage(feature_addresses[feature], (float) spectral.getFeature(spectral_feature));
+            }
+        }
+        for (int band = 0; band < spectral.getNumBands(); ++band) {
+            osc_encoder.addMessage("/spectrum", band + 1, (float) spectral.getBandEnergy(band));
+        }
+        if (pitch_output_user_param->getIndex() != 0 && pitch.getFrequency() > 0) {
+            osc_encoder.addMessage("/pitch", (float) pitch.getNote());
+        }
+        osc_encoder.endBundle();
+        if (!osc_encoder.hasOverflowed()) {
+            return;
+        }
+        // Take the bundle back out, send what came before it, and go round again with a fresh packet.
+        osc_encoder.rollback(mark);
+        flushOscPacket();
+    }
+}
+
+/**
+ * Starts filling a new OSC packet, if none is open: takes a slot from osc_sender and opens the outer bundle that holds each tick's bundle.
+ *
+ * The outer bundle is tagged immediately, which is never later than the ticks inside it, as OSC requires of nested bundles.
+ *
+ * Returns
+ * -------
+ * bool: True if a packet is open, False if the sender thread's queue is full and the tick has to be dropped.
+ */
+bool EnvelopeFollowerAudioProcessor::openOscPacket()
+{
+    if (osc_packet == nullptr) {
+        osc_packet = osc_sender.beginPacket();
+        if (osc_packet == nullptr) {
+            return false;
+        }
+        osc_encoder.begin(osc_packet, OscSender::max_packet_size);
+        osc_encoder.beginBundle(OscEncoder::immediately);
+    }
+    return true;
+}
+
+/**
+ * Closes the outer bundle of the OSC packet being filled and queues it for the sender thread.
+ * Does nothing if no packet is open, and queues nothing if no tick was written into it.
+ */
+void EnvelopeFollowerAudioProcessor::flushOscPacket()
+{
+    if (osc_packet == nullptr) {
+        return;
+    }
+    osc_encoder.endBundle();
+    osc_sender.endPacket(osc_encoder.getSize() > OscEncoder::bundle_header_size ? osc_encoder.getSize() : 0);
+    osc_packet = nullptr;
+}
+
+/**
+ * Marks a parameter as needing to be reapplied to the SignalProcessor.
+ *
+ * Called by JUCE whenever a parameter changes, from whichever thread changed it.
+ *
+ * Arguments
+ * ---------
+ * int parameterIndex: The index of the parameter that changed.
+ * float newValue: The new normalised value of the parameter. (unused)
+ */
+void EnvelopeFollowerAudioProcessor::parameterValueChanged(int parameterIndex, float newValue)
+{
+    dirty_params.fetch_or((juce::uint64) 1 << parameterIndex);
+}
+
+/**
+ * Starts the OSC sender thread when the OSC output is switched on, and stops it when it is switched off,
+ * so an instance with the output off has no thread waking up to send.
+ *
+ * Called by JUCE on the message thread every 100 milliseconds. setActive does nothing unless the switch has moved.
+ */
+void EnvelopeFollowerAudioProcessor::timerCallback()
+{
+    osc_sender.setActive(osc_output_user_param->get());
+}
+
+/**
+ * Required by juce::AudioProcessorParameter::Listener. Does nothing.
+ *
+ * Arguments
+ * ---------
+ * int parameterIndex: The index of the parameter. (unused)
+ * bool gestureIsStarting: Whether the gesture is starting or ending. (unused)
+ */
+void EnvelopeFollowerAudioProcessor::parameterGestureChanged(int parameterIndex, bool gestureIsStarting)
+{
+}
+
+/**
+ * Checks whether a parameter's bit is set in a snapshot of dirty_params.
+ *
+ * Arguments
+ * ---------
+ * juce::uint64 dirty: The snapshot of dirty_params.
+ * const juce::AudioProcessorParameter* param: The parameter to check.
+ *
+ * Returns
+ * -------
+ * bool: True if the parameter has changed since the last update, False otherwise.
+ */
+bool EnvelopeFollowerAudioProcessor::isParamDirty(juce::uint64 dirty, const juce::AudioProcessorParameter* param)
+{
+    return (dirty >> param->getParameterIndex()) & 1;
 }
 
 /**
@@ -409,6 +952,55 @@ void EnvelopeFollowerAudioProcessor::updateMathParams()
  * juce::MidiBuffer&: The set of MIDI message buffers used for DAW IO.
  */
 void EnvelopeFollowerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processBlockInternal(buffer, midiMessages, signalProcessor, channel_processors, channel_bank, spectral_features, onset_detector, pitch_tracker);
+}
+
+/**
+ * Takes a set of double precision audio sample buffers and converts them into a series of MIDI messages posted to the network interface.
+ *
+ * Used instead of the float overload when the host has enabled double precision processing.
+ *
+ * Arguments
+ * ---------
+ * juce::AudioBuffer<double>&: The set of audio sample buffers used for DAW IO.
+ * juce::MidiBuffer&: The set of MIDI message buffers used for DAW IO.
+ */
+void EnvelopeFollowerAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processBlockInternal(buffer, midiMessages, doubleSignalProcessor, double_channel_processors, double_channel_bank, double_spectral_features, double_onset_detector, double_pitch_tracker);
+}
+
+/**
+ * Returns whether this plugin can process double precision audio.
+ *
+ * Returns True, as the whole signal processing pipeline is templated on the sample type.
+ *
+ * Returns
+ * -------
+ * bool: True if this plugin can process double precision audio, False otherwise. (Always True for this implementation)
+ */
+bool EnvelopeFollowerAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
+/**
+ * The shared implementation of both processBlock overloads.
+ *
+ * Arguments
+ * ---------
+ * juce::AudioBuffer<SampleType>& buffer: The set of audio sample buffers used for DAW IO.
+ * juce::MidiBuffer& midiMessages: The set of MIDI message buffers used for DAW IO.
+ * SignalProcessor<SampleType>& processor: The signal processor of the matching precision.
+ * std::vector<SignalProcessor<SampleType>>& channelProcessors: The per-channel signal processors of the matching precision.
+ * EnvelopeBank<SampleType>& channelBank: The per-channel envelope bank of the matching precision.
+ * SpectralFeatures<SampleType>& spectral: The spectral feature engine of the matching precision.
+ * OnsetDetector<SampleType>& onsets: The onset detector of the matching precision.
+ * PitchTracker<SampleType>& pitch: The pitch tracker of the matching precision.
+ */
+template <typename SampleType>
+void EnvelopeFollowerAudioProcessor::processBlockInternal (juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages, SignalProcessor<SampleType>& processor, std::vector<SignalProcessor<SampleType>>& channelProcessors, EnvelopeBank<SampleType>& channelBank, SpectralFeatures<SampleType>& spectral, OnsetDetector<SampleType>& onsets, PitchTracker<SampleType>& pitch)
 {
     /*juce::String id = juce::MidiOutput::getDefaultDevice().identifier;
     output_device = juce::MidiOutput::openDevice(id);
@@ -417,7 +1009,8 @@ void EnvelopeFollowerAudioProcessor::processBlock (juce::AudioBuffer<float>& buf
         std::cout<<"Unable to create output device\n";
     }*/
     
-    updateMathParams();
+    updateMathParams(processor, channelProcessors, channelBank, spectral, onsets, pitch);
+    // The plugin takes no MIDI in, so the host buffer only carries what postMessage adds to it.
     midiMessages.clear();
     
     juce::ScopedNoDenormals noDenormals;
@@ -437,77 +1030,404 @@ void EnvelopeFollowerAudioProcessor::processBlock (juce::AudioBuffer<float>& buf
     // Alternatively, you can process the samples with the channels
     // interleaved by keeping the same state.
     const int num_samples = buffer.getNumSamples();
-    float sample;
+    if (midi_channel != gated_channel) {
+        // The values sent so far went to the old channel, so the new one gets every value once.
+        send_gate.reset();
+        gated_channel = midi_channel;
+    }
+    // The wall-clock time of the block's first sample, read once a block. Each OSC tick is tagged with this plus its offset in the block,
+    // so the receiver can schedule the values with the spacing they were measured at, however the host's blocks arrive.
+    double block_time = 0.0;
+#if SEND_OSC
+    if (osc_output_user_param->get()) {
+        block_time = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+#endif
 
-    // Build the buffer for storing the envelope waveform.
-    juce::AudioBuffer<float> vis_samples;
-    vis_samples.setSize(1, num_samples); // The buffer must be large enough to hold all of the MIDI message values produced. There are at most as many MIDI messages as input audio samples.
-    vis_samples.clear(); // Clear any junk data that may have populated the buffer.
-    // 
-    int vis_index = 0;
+    // Every buffer in the pipeline was sized for the block size announced in prepareToPlay. A host that sends a bigger
+    // block anyway gets it processed in chunks of that size, rather than having buffers regrown on the audio thread.
+    const int chunk_size = juce::jmax(prepared_block_size, 1);
+    // Whether the main CC went out this block, so the GUI's description only has to be rebuilt once.
+    bool main_cc_sent = false;
+    for (int start_sample = 0; start_sample < num_samples; start_sample += chunk_size) {
+        const int chunk_samples = juce::jmin(chunk_size, num_samples - start_sample);
+        main_cc_sent |= processChunk(buffer, midiMessages, start_sample, chunk_samples, block_time, processor, channelProcessors, channelBank, spectral, onsets, pitch);
+    }
 
-    // Iterate over each sample in the audio buffers:
-    for (int index = 0; index < num_samples; index++) {
-        // Calculate the average sample value across the input channels.
-        sample = 0;
-        // - sum over all of the input channels to get the total
-        for (int channel = 0; channel < totalNumInputChannels; ++channel)
-        {
-            sample += buffer.getSample(channel, index);
-            // note: it may be faster to use buffer.getReadPointer outside the loop,
-            // and loop through that, instead of using getSample every time.
+    if (main_cc_sent) {
+        // Update the MIDI descriprion string for the GUI. Once a block at most, as the faster CC clocks would otherwise build it on every sample.
+        midi_info = std::to_string(midi_channel) + " " +
+                    std::to_string(midi_controller_type) + " " +
+                    std::to_string(midi_value);
+    }
+    // Move the sample clock on past this block, for send_gate's minimum interval.
+    sample_clock += num_samples;
+#if SEND_OSC
+    // Every tick of the block goes out in as few datagrams as fit, rather than one per tick.
+    flushOscPacket();
+#endif
+}
+
+/**
+ * Runs the signal processing pipeline over one chunk of a block, and sends the MIDI and OSC ticks that fall in it.
+ *
+ * A chunk is never longer than the block size announced in prepareToPlay, so nothing in the pipeline has to grow.
+ * Sample numbers sent to the outputs count from the start of the host's block, not the chunk.
+ *
+ * Arguments
+ * ---------
+ * juce::AudioBuffer<SampleType>& buffer: The host's whole block.
+ * juce::MidiBuffer& midiMessages: The host's MIDI buffer for the block.
+ * int start_sample: The index of the chunk's first sample within the block.
+ * int num_samples: The length of the chunk.
+ * double block_time: The wall-clock time of the block's first sample in seconds since 1970, for the OSC time tags.
+ * SignalProcessor<SampleType>& processor: The signal processor of the matching precision.
+ * std::vector<SignalProcessor<SampleType>>& channelProcessors: The per-channel signal processors of the matching precision.
+ * EnvelopeBank<SampleType>& channelBank: The per-channel envelope bank of the matching precision.
+ * SpectralFeatures<SampleType>& spectral: The spectral feature engine of the matching precision.
+ * OnsetDetector<SampleType>& onsets: The onset detector of the matching precision.
+ * PitchTracker<SampleType>& pitch: The pitch tracker of the matching precision.
+ *
+ * Returns
+ * -------
+ * bool: True if the main CC was sent during the chunk, False otherwise.
+ */
+template <typename SampleType>
+bool EnvelopeFollowerAudioProcessor::processChunk(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages, int start_sample, int num_samples, double block_time, SignalProcessor<SampleType>& processor, std::vector<SignalProcessor<SampleType>>& channelProcessors, EnvelopeBank<SampleType>& channelBank, SpectralFeatures<SampleType>& spectral, OnsetDetector<SampleType>& onsets, PitchTracker<SampleType>& pitch)
+{
+    const int totalNumInputChannels = getTotalNumInputChannels();
+    const int block_samples = buffer.getNumSamples();
+    // The chunk of every input channel. isBusesLayoutSupported caps the inputs at max_channels.
+    const SampleType* inputs[max_channels];
+    SampleType* outputs[max_channels];
+    for (int channel = 0; channel < totalNumInputChannels; ++channel) {
+        inputs[channel] = buffer.getReadPointer(channel, start_sample);
+        outputs[channel] = buffer.getWritePointer(channel, start_sample);
+    }
+
+    // In the per-channel mode every input channel has its own processor and CC, so opposite-polarity content can't cancel.
+    const bool per_channel = channel_mode_user_param->getIndex() == 1 && ! channelProcessors.empty();
+    const int num_envelopes = per_channel ? juce::jmin(totalNumInputChannels, (int) channelProcessors.size()) : 1;
+    // The envelope after every sample, one trace per envelope, trace_stride apart. Channel 0's trace drives the GUI.
+    const SampleType* envelope_traces[max_channels];
+    int trace_stride = 1;
+    if (per_channel && processor.fitsEnvelopeBank()) {
+        // The common settings need nothing the bank doesn't have, so every channel advances at once, one lane each.
+        if (!channel_bank_active) {
+            // Carry on from where the processors left off, so the CCs don't jump.
+            for (int channel = 0; channel < num_envelopes; ++channel) {
+                channelBank.setLaneEnvelope(channel, channelProcessors[channel].getEnvelope());
+            }
+            channel_bank_active = true;
+        }
+        channelBank.setActiveLanes(num_envelopes);
+        channelBank.processBlock(inputs, num_samples);
+        for (int channel = 0; channel < num_envelopes; ++channel) {
+            envelope_traces[channel] = channelBank.getLaneTrace(channel);
         }
-        // - divide by the number of input channels to rescale back to the average
-        sample /= totalNumInputChannels;
+        trace_stride = channelBank.getTraceStride();
+    } else if (per_channel) {
+        if (channel_bank_active) {
+            // Likewise hand the envelopes back when a setting needs a stage only the processors have.
+            for (int channel = 0; channel < num_envelopes; ++channel) {
+                channelProcessors[channel].setEnvelope(channelBank.getEnvelope(channel));
+            }
+            channel_bank_active = false;
+        }
+        // Channel-major: each processor runs over one contiguous channel.
+        for (int channel = 0; channel < num_envelopes; ++channel) {
+            envelope_traces[channel] = channelProcessors[channel].processBlock(&inputs[channel], 1, num_samples);
+        }
+    } else {
+        // Feed the whole chunk through the audio processing pipeline. The channels are combined
+        // inside the signal processor by the selected downmix, and we get back the envelope after every sample.
+        envelope_traces[0] = processor.processBlock(inputs, totalNumInputChannels, num_samples);
+    }
+    const SampleType* envelope_trace = envelope_traces[0];
+    // Gather the chunk for the spectral features, which analyse it every hop. Does nothing while they are all off.
+    spectral.process(inputs, totalNumInputChannels, num_samples);
+    // Gather the chunk for the pitch tracker, which analyses it every hop. Does nothing while the pitch output is off.
+    pitch.process(inputs, totalNumInputChannels, num_samples);
+    const int pitch_output = pitch_output_user_param->getIndex();
+    // Play a note on every onset, at the sample it happened on rather than on the next CC tick.
+    if (onsets_user_param->get()) {
+        onsets.process(inputs, totalNumInputChannels, num_samples);
+        for (int event = 0; event < onsets.getNumEvents(); ++event) {
+            const auto& onset = onsets.getEvent(event);
+            if (onset.velocity > 0) {
+                sounding_onset_note = onset_note_user_param->get();
+                sendNoteMessage(midiMessages, start_sample + onset.sample, sounding_onset_note, onset.velocity);
+            } else if (sounding_onset_note >= 0) {
+                sendNoteMessage(midiMessages, start_sample + onset.sample, sounding_onset_note, 0);
+                sounding_onset_note = -1;
+            }
+        }
+    } else if (sounding_onset_note >= 0) {
+        // Switched off mid-note, so end the note here rather than leave it hanging.
+        sendNoteMessage(midiMessages, start_sample, sounding_onset_note, 0);
+        sounding_onset_note = -1;
+    }
+    // Hold the audio back by the lookahead, so it lines up with the envelope once the host compensates for the latency.
+    processor.delayBlock(outputs, totalNumInputChannels, num_samples);
+
+    // The buffer for storing the envelope waveform. Preallocated in prepareToPlay for a whole chunk.
+    int vis_index = 0;
+    // "Rate" ticks every samples_per_midi_message samples, "Every block" on the last sample of the host's block and "Every sample" on all of them.
+    const int cc_clock = cc_clock_user_param->getIndex();
+    // Whether the main CC went out this chunk.
+    bool main_cc_sent = false;
+#if SEND_OSC
+    const bool send_osc = osc_output_user_param->get();
+#endif
 
-        // Feed the sample into the audio procesing pipeline.
-        signalProcessor.takeInSample(sample);
+    // Iterate over the envelope value after each sample in the chunk:
+    for (int index = 0; index < num_samples; index++) {
+        // The envelope value after this sample, rescaled to a MIDI value.
+        const int envelope_position = processor.getEnvelopePosition(envelope_trace[index * trace_stride]);
+        // Where the sample falls in the host's block, which is what the outputs are timed against.
+        const int sample = start_sample + index;
 
         // Increment the number of samples that have been processde since the last produced MIDI message and GUI update.
         elapsed_since_midi++;
         elapsed_since_drawer++; // (depricated)
+        // The rate can drop below the count while it runs, so catch up with >= rather than waiting for the count to wrap.
+        const bool tick = cc_clock == 0 ? elapsed_since_midi >= samples_per_midi_message
+                        : cc_clock == 2 || sample == block_samples - 1;
         // If we have processed enough samples for another MIDI output...
-        if (elapsed_since_midi == samples_per_midi_message) {
+        if (tick) {
             // Start counting to the next message.
             elapsed_since_midi = 0;
-            // Fetch the value of the output MIDI message from the signal processing component.
-            midi_value = signalProcessor.getEnvelopePosition();
-            // Post the new MIDI meesage to the network interface.
-            sendCCMessage(index);
-            // Update the MIDI descriprion string for the GUI.
-            midi_info = std::to_string(midi_channel) + " " +
-                        std::to_string(midi_controller_type) + " " +
-                        std::to_string(midi_value);
+            // Every output gets to claim its CC numbers afresh each tick.
+            midi_encoder.releaseControllers();
+            // Fetch the level of the output MIDI message from the signal processing component,
+            // or the note number from the pitch tracker when the pitch takes over the main CC.
+            midi_level = pitch_output == 1 ? pitch.getNote() / 127.0 : getOutputLevel(processor, envelope_trace[index * trace_stride]);
+            midi_value = (int) lround(midi_level * 127);
+            // Post the new MIDI meesage to the network interface, if it has moved far enough since the last one.
+            main_cc_sent |= sendCCMessage(midiMessages, sample);
+            // The pitch holds through unvoiced stretches, but there is nothing to send until the first voiced analysis.
+            if (pitch_output == 2 && pitch.getFrequency() > 0) {
+                sendPitchBendMessage(midiMessages, sample, pitch.getPitchBendValue());
+            }
+            if (per_channel) {
+                // Each further channel sends the next free CC number up from midi_controller_type, stepping over the 14-bit fine bytes, as far as CC 127.
+                // Every processor has the same output range, so any of them can rescale the traces.
+                int channel_cc = midi_controller_type;
+                for (int channel = 1; channel < num_envelopes; ++channel) {
+                    channel_cc = midi_encoder.findController(channel_cc + 1);
+                    if (channel_cc > 127) {
+                        break;
+                    }
+                    sendCCMessage(midiMessages, sample, channel_cc, getOutputLevel(processor, envelope_traces[channel][index * trace_stride]));
+                }
+            } else {
+                // Each band sends the next CC number up from band_cc_user_param, as far as CC 127.
+                const int num_bands = std::min(processor.getNumBands(), 128 - band_cc_user_param->get());
+                const bool seven_bit = midi_encoder.getFormat() == MidiEncoder::Format::cc7;
+                for (int band = 0; band < num_bands; ++band) {
+                    const double band_level = seven_bit ? processor.getBandEnvelopePosition(band, index) / 127.0 : processor.getBandEnvelopeLevel(band, index);
+                    sendCCMessage(midiMessages, sample, band_cc_user_param->get() + band, band_level);
+                }
+            }
+            // Each spectral feature has a fixed CC offset from spectral_cc_user_param, so turning one off doesn't move the others.
+            // They hold their value from the last analysis, at most one hop old.
+            const int spectral_cc = spectral_cc_user_param->get();
+            const int num_features = SpectralFeatures<SampleType>::num_features;
+            for (int feature = 0; feature < num_features && spectral_cc + feature < 128; ++feature) {
+                const auto spectral_feature = (typename SpectralFeatures<SampleType>::Feature) feature;
+                if (spectral.isEnabled(spectral_feature)) {
+                    sendCCMessage(midiMessages, sample, spectral_cc + feature, spectral.getFeature(spectral_feature));
+                }
+            }
+            for (int band = 0; band < spectral.getNumBands() && spectral_cc + num_features + band < 128; ++band) {
+                sendCCMessage(midiMessages, sample, spectral_cc + num_features + band, spectral.getBandEnergy(band));
+            }
+#if SEND_OSC
+            if (send_osc) {
+                writeOscTick(index, OscEncoder::toTimeTag(block_time + sample / getSampleRate()), processor, envelope_traces, trace_stride, num_envelopes, per_channel, spectral, pitch);
+            }
+#endif
         }
         // Update the MIDI waveform buffer with the new MIDI value from the audio processing pipeline
-        float mappedValue = juce::jmap((float)signalProcessor.getEnvelopePosition(), 0.0f, 127.0f, 0.0f, 1.0f);
+        float mappedValue = juce::jmap((float)envelope_position, 0.0f, 127.0f, 0.0f, 1.0f);
         vis_samples.setSample(0, vis_index++, mappedValue);
     }
 
     // Update the GUI elements that display the input waveform and output envelope.
-    EnvVisualiser.pushBuffer(vis_samples);
-    AudioVisualiser.pushBuffer(buffer);
+    EnvVisualiser.pushBuffer(vis_samples.getArrayOfReadPointers(), 1, num_samples);
+    pushInputToVisualiser(inputs, totalNumInputChannels, num_samples);
+    return main_cc_sent;
+}
+
+/**
+ * Pushes a chunk of single precision input audio to the input waveform display.
+ *
+ * Arguments
+ * ---------
+ * const float** channels: One read pointer per input channel.
+ * int numChannels: The number of input channels.
+ * int numSamples: The number of samples in each channel.
+ */
+void EnvelopeFollowerAudioProcessor::pushInputToVisualiser (const float** channels, int numChannels, int numSamples)
+{
+    AudioVisualiser.pushBuffer(channels, numChannels, numSamples);
+}
+
+/**
+ * Pushes a chunk of double precision input audio to the input waveform display.
+ *
+ * The display only draws floats, so the chunk is copied into a preallocated float buffer first.
+ * This is only for drawing; the signal processing pipeline never sees the converted copy.
+ *
+ * Arguments
+ * ---------
+ * const double** channels: One read pointer per input channel.
+ * int numChannels: The number of input channels.
+ * int numSamples: The number of samples in each channel. At most the block size announced in prepareToPlay.
+ */
+void EnvelopeFollowerAudioProcessor::pushInputToVisualiser (const double** channels, int numChannels, int numSamples)
+{
+    const int num_channels = juce::jmin(numChannels, vis_input.getNumChannels());
+    for (int channel = 0; channel < num_channels; ++channel) {
+        float* destination = vis_input.getWritePointer(channel);
+        for (int index = 0; index < numSamples; ++index) {
+            destination[index] = (float) channels[channel][index];
+        }
+    }
+    AudioVisualiser.pushBuffer(vis_input.getArrayOfReadPointers(), num_channels, numSamples);
+}
 
+/**
+ * Sends the main CC (midi_controller_type, carrying midi_value) to wherever midi_output_user_param points, unless send_gate skips it.
+ *
+ * Arguments
+ * ---------
+ * juce::MidiBuffer& midiMessages: The host's MIDI buffer for this block.
+ * int sample_number: The index of the audio sample in the block that prompted the message.
+ *
+ * Returns
+ * -------
+ * bool: True if the CC was sent, False if send_gate skipped it.
+ */
+bool EnvelopeFollowerAudioProcessor::sendCCMessage(juce::MidiBuffer& midiMessages, int sample_number)
+{
+    return sendCCMessage(midiMessages, sample_number, midi_controller_type, midi_level);
 }
 
 /**
- * Posts a produced MIDI message to one of the hardware's output ports.
+ * Sends a CC for the given controller to wherever midi_output_user_param points, unless send_gate skips it.
  *
  * Arguments
  * ---------
- * int sample_number: The index of the audio sample that prompted the message to be produced. (unused)
+ * juce::MidiBuffer& midiMessages: The host's MIDI buffer for this block.
+ * int sample_number: The index of the audio sample in the block that prompted the message.
+ * int controller: The CC (or NRPN) number to send.
+ * double level: The level to send, from 0 to 1. Quantized to the resolution the controller can be sent at.
+ *
+ * Returns
+ * -------
+ * bool: True if the CC was sent, False if an earlier output this tick already has its CC numbers or send_gate skipped it.
  */
-void EnvelopeFollowerAudioProcessor::sendCCMessage(int sample_number)
+bool EnvelopeFollowerAudioProcessor::sendCCMessage(juce::MidiBuffer& midiMessages, int sample_number, int controller, double level)
 {
-    /* Instead of adding midi messages to the buffer, what we need to do is send
-     the midi messages out into hardware-land.*/
-    juce::MidiMessage message;
-    //std::cout<<"sending midi message "<<value<<"\n";
+    // Outputs claim their CC numbers in send order, so one whose number (or 14-bit fine partner) is taken is dropped rather than garbling another.
+    const MidiEncoder::Width width = midi_encoder.claimController(controller);
+    if (width == MidiEncoder::Width::none) {
+        return false;
+    }
+    // Quantized once, straight to the resolution it goes out at, so the gate compares exactly what would be sent.
+    const long long value = midi_encoder.quantize(level, width);
+    if (!send_gate.shouldSend(controller, value, sample_clock + sample_number, midi_encoder.getResolution(width))) {
+        return false;
+    }
     // https://www.songstuff.com/recording/article/midi_message_format/
-    message = juce::MidiMessage::controllerEvent(midi_channel, midi_controller_type, midi_value);
-    // Post the MIDI message to the attatched MIDI device (IAC driver bus).
-    output_device->sendMessageNow(message);
-    
+    midi_encoder.encodeController(midi_channel, controller, value, width);
+    postEncoded(midiMessages, sample_number);
+    return true;
+}
+
+/**
+ * Sends a note-on or note-off to wherever midi_output_user_param points.
+ *
+ * Arguments
+ * ---------
+ * juce::MidiBuffer& midiMessages: The host's MIDI buffer for this block.
+ * int sample_number: The index of the audio sample in the block the note belongs on.
+ * int note: The note number.
+ * int velocity: The note-on velocity, from 1 to 127, or 0 for a note-off.
+ */
+void EnvelopeFollowerAudioProcessor::sendNoteMessage(juce::MidiBuffer& midiMessages, int sample_number, int note, int velocity)
+{
+    midi_encoder.encodeNote(midi_channel, note, velocity);
+    postEncoded(midiMessages, sample_number);
+}
+
+/**
+ * Sends a pitch bend message on midi_channel to wherever midi_output_user_param points, unless send_gate skips it.
+ *
+ * Arguments
+ * ---------
+ * juce::MidiBuffer& midiMessages: The host's MIDI buffer for this block.
+ * int sample_number: The index of the audio sample in the block that prompted the message.
+ * int value: The 14-bit pitch bend value, from 0 to 16383.
+ *
+ * Returns
+ * -------
+ * bool: True if the pitch bend was sent, False if send_gate skipped it.
+ */
+bool EnvelopeFollowerAudioProcessor::sendPitchBendMessage(juce::MidiBuffer& midiMessages, int sample_number, int value)
+{
+    // 128 pitch bend steps to one CC step, so cc_delta_user_param means the same movement for both.
+    if (!send_gate.shouldSend(SendOnDelta::pitch_bend_slot, value, sample_clock + sample_number, 128)) {
+        return false;
+    }
+    midi_encoder.encodePitchBend(midi_channel, value);
+    postEncoded(midiMessages, sample_number);
+    return true;
+}
+
+/**
+ * Routes every message midi_encoder holds through postMessage, in order, all on the same sample.
+ *
+ * Arguments
+ * ---------
+ * juce::MidiBuffer& midiMessages: The host's MIDI buffer for this block.
+ * int sample_number: The index of the audio sample in the block the messages belong on.
+ */
+void EnvelopeFollowerAudioProcessor::postEncoded(juce::MidiBuffer& midiMessages, int sample_number)
+{
+    // Every MIDI 1.0 message the encoder writes is the same size, so the buffer splits evenly.
+    const unsigned char* data = midi_encoder.getData();
+    for (int offset = 0; offset < midi_encoder.getSize(); offset += MidiEncoder::message_size) {
+        postMessage(midiMessages, sample_number, data + offset, MidiEncoder::message_size);
+    }
+}
+
+/**
+ * Routes one produced MIDI message by midi_output_user_param: queued for the output device, added to the host's
+ * buffer at its sample, or both.
+ *
+ * The host buffer keeps the exact position in the block, so host CCs are free of jitter and identical on every
+ * offline bounce. The output device only ever sees the time the sender thread got to the message.
+ *
+ * Arguments
+ * ---------
+ * juce::MidiBuffer& midiMessages: The host's MIDI buffer for this block.
+ * int sample_number: The index of the audio sample in the block the message belongs on.
+ * const unsigned char* data: The raw bytes of one short MIDI message, status byte first.
+ * int size: The number of bytes.
+ */
+void EnvelopeFollowerAudioProcessor::postMessage(juce::MidiBuffer& midiMessages, int sample_number, const unsigned char* data, int size)
+{
+    const int destination = midi_output_user_param->getIndex();
+    if (destination != 1) {
+        // Queue the MIDI message for the attatched MIDI device (IAC driver bus). Dropped and counted if the sender thread has fallen behind.
+        midi_sender.post(data, size);
+    }
+    if (destination != 0) {
+        // clear() keeps the buffer's storage, so once it has grown to a typical block's worth of events this no longer allocates.
+        midiMessages.addEvent(data, size, sample_number);
+    }
 }
 
 /**
@@ -556,8 +1476,40 @@ void EnvelopeFollowerAudioProcessor::getStateInformation (juce::MemoryBlock& des
     xml->setAttribute("lo", (double) low_pass_user_param->get());
     xml->setAttribute("hi", (double) hi_pass_user_param->get());
     xml->setAttribute("recovery", (double) recovery_user_param->get());
+    xml->setAttribute("filterOrder", filter_order_user_param->getIndex());
+    xml->setAttribute("filterAlignment", filter_alignment_user_param->getIndex());
+    xml->setAttribute("detector", detector_user_param->getIndex());
+    xml->setAttribute("rmsWindow", (double) rms_window_user_param->get());
+    xml->setAttribute("hold", (double) hold_user_param->get());
+    xml->setAttribute("attack", (double) attack_user_param->get());
+    xml->setAttribute("detectorRate", detector_rate_user_param->getIndex());
+    xml->setAttribute("channelMode", channel_mode_user_param->getIndex());
+    xml->setAttribute("downmix", downmix_user_param->getIndex());
+    xml->setAttribute("lookahead", (double) lookahead_user_param->get());
+    xml->setAttribute("bands", bands_user_param->get());
+    xml->setAttribute("bandCC", band_cc_user_param->get());
+    xml->setAttribute("centroid", centroid_user_param->get());
+    xml->setAttribute("rolloff", rolloff_user_param->get());
+    xml->setAttribute("flatness", flatness_user_param->get());
+    xml->setAttribute("flux", flux_user_param->get());
+    xml->setAttribute("spectralBands", spectral_bands_user_param->get());
+    xml->setAttribute("spectralCC", spectral_cc_user_param->get());
+    xml->setAttribute("onsets", onsets_user_param->get());
+    xml->setAttribute("onsetSensitivity", (double) onset_sensitivity_user_param->get());
+    xml->setAttribute("onsetNote", onset_note_user_param->get());
+    xml->setAttribute("pitchOutput", pitch_output_user_param->getIndex());
+    xml->setAttribute("pitchThreshold", (double) pitch_threshold_user_param->get());
+    xml->setAttribute("midiOutput", midi_output_user_param->getIndex());
+    xml->setAttribute("ccClock", cc_clock_user_param->getIndex());
+    xml->setAttribute("ccRate", (double) cc_rate_user_param->get());
+    xml->setAttribute("ccDelta", cc_delta_user_param->get());
+    xml->setAttribute("ccInterval", (double) cc_interval_user_param->get());
+    xml->setAttribute("ccFormat", cc_format_user_param->getIndex());
+    xml->setAttribute("oscOutput", osc_output_user_param->get());
     xml->setAttribute("channel", midi_channel);
     xml->setAttribute("type", midi_controller_type);
+    xml->setAttribute("oscHost", osc_host);
+    xml->setAttribute("oscPort", osc_port);
     // Write the XML data to a block of RAM.
     copyXmlToBinary(*xml, destData);
 }
@@ -572,8 +1524,39 @@ void EnvelopeFollowerAudioProcessor::getStateInformation (juce::MemoryBlock& des
  * - EnvelopeFollowerAudioProcessor::low_pass_user_param from the XML tag "lo"
  * - EnvelopeFollowerAudioProcessor::hi_pass_user_param from the XML tag "hi"
  * - EnvelopeFollowerAudioProcessor::recovery_user_param from the XML tag "recovery"
+ * - EnvelopeFollowerAudioProcessor::filter_order_user_param from the XML attribute "filterOrder"
+ * - EnvelopeFollowerAudioProcessor::filter_alignment_user_param from the XML attribute "filterAlignment"
+ * - EnvelopeFollowerAudioProcessor::detector_user_param from the XML attribute "detector"
+ * - EnvelopeFollowerAudioProcessor::rms_window_user_param from the XML attribute "rmsWindow"
+ * - EnvelopeFollowerAudioProcessor::hold_user_param from the XML attribute "hold"
+ * - EnvelopeFollowerAudioProcessor::attack_user_param from the XML attribute "attack"
+ * - EnvelopeFollowerAudioProcessor::detector_rate_user_param from the XML attribute "detectorRate"
+ * - EnvelopeFollowerAudioProcessor::channel_mode_user_param from the XML attribute "channelMode"
+ * - EnvelopeFollowerAudioProcessor::downmix_user_param from the XML attribute "downmix"
+ * - EnvelopeFollowerAudioProcessor::lookahead_user_param from the XML attribute "lookahead"
+ * - EnvelopeFollowerAudioProcessor::bands_user_param from the XML attribute "bands"
+ * - EnvelopeFollowerAudioProcessor::band_cc_user_param from the XML attribute "bandCC"
+ * - EnvelopeFollowerAudioProcessor::centroid_user_param from the XML attribute "centroid"
+ * - EnvelopeFollowerAudioProcessor::rolloff_user_param from the XML attribute "rolloff"
+ * - EnvelopeFollowerAudioProcessor::flatness_user_param from the XML attribute "flatness"
+ * - EnvelopeFollowerAudioProcessor::flux_user_param from the XML attribute "flux"
+ * - EnvelopeFollowerAudioProcessor::spectral_bands_user_param from the XML attribute "spectralBands"
+ * - EnvelopeFollowerAudioProcessor::spectral_cc_user_param from the XML attribute "spectralCC"
+ * - EnvelopeFollowerAudioProcessor::onsets_user_param from the XML attribute "onsets"
+ * - EnvelopeFollowerAudioProcessor::onset_sensitivity_user_param from the XML attribute "onsetSensitivity"
+ * - EnvelopeFollowerAudioProcessor::onset_note_user_param from the XML attribute "onsetNote"
+ * - EnvelopeFollowerAudioProcessor::pitch_output_user_param from the XML attribute "pitchOutput"
+ * - EnvelopeFollowerAudioProcessor::pitch_threshold_user_param from the XML attribute "pitchThreshold"
+ * - EnvelopeFollowerAudioProcessor::midi_output_user_param from the XML attribute "midiOutput"
+ * - EnvelopeFollowerAudioProcessor::cc_clock_user_param from the XML attribute "ccClock"
+ * - EnvelopeFollowerAudioProcessor::cc_rate_user_param from the XML attribute "ccRate"
+ * - EnvelopeFollowerAudioProcessor::cc_delta_user_param from the XML attribute "ccDelta"
+ * - EnvelopeFollowerAudioProcessor::cc_interval_user_param from the XML attribute "ccInterval"
+ * - EnvelopeFollowerAudioProcessor::cc_format_user_param from the XML attribute "ccFormat"
+ * - EnvelopeFollowerAudioProcessor::osc_output_user_param from the XML attribute "oscOutput"
  * - EnvelopeFollowerAudioProcessor::midi_channel from the XML tag "channel"
  * - EnvelopeFollowerAudioProcessor::midi_controller_type from the XML tag "type"
+ * - EnvelopeFollowerAudioProcessor::osc_host and osc_port from the XML attributes "oscHost" and "oscPort"
  *
  * Arguments
  * ---------
@@ -605,12 +1588,106 @@ void EnvelopeFollowerAudioProcessor::setStateInformation (const void* data, int
         if (xmlState->hasTagName("recovery")) {
             *recovery_user_param = xmlState->getDoubleAttribute("recovery");
         }
+        // Older sessions don't have these, so check for the attribute itself.
+        if (xmlState->hasAttribute("filterOrder")) {
+            *filter_order_user_param = xmlState->getIntAttribute("filterOrder");
+        }
+        if (xmlState->hasAttribute("filterAlignment")) {
+            *filter_alignment_user_param = xmlState->getIntAttribute("filterAlignment");
+        }
+        if (xmlState->hasAttribute("detector")) {
+            *detector_user_param = xmlState->getIntAttribute("detector");
+        }
+        if (xmlState->hasAttribute("rmsWindow")) {
+            *rms_window_user_param = xmlState->getDoubleAttribute("rmsWindow");
+        }
+        if (xmlState->hasAttribute("hold")) {
+            *hold_user_param = xmlState->getDoubleAttribute("hold");
+        }
+        if (xmlState->hasAttribute("attack")) {
+            *attack_user_param = xmlState->getDoubleAttribute("attack");
+        }
+        if (xmlState->hasAttribute("detectorRate")) {
+            *detector_rate_user_param = xmlState->getIntAttribute("detectorRate");
+        }
+        if (xmlState->hasAttribute("channelMode")) {
+            *channel_mode_user_param = xmlState->getIntAttribute("channelMode");
+        }
+        if (xmlState->hasAttribute("downmix")) {
+            *downmix_user_param = xmlState->getIntAttribute("downmix");
+        }
+        if (xmlState->hasAttribute("lookahead")) {
+            *lookahead_user_param = xmlState->getDoubleAttribute("lookahead");
+        }
+        if (xmlState->hasAttribute("bands")) {
+            *bands_user_param = xmlState->getIntAttribute("bands");
+        }
+        if (xmlState->hasAttribute("bandCC")) {
+            *band_cc_user_param = xmlState->getIntAttribute("bandCC");
+        }
+        if (xmlState->hasAttribute("centroid")) {
+            *centroid_user_param = xmlState->getBoolAttribute("centroid");
+        }
+        if (xmlState->hasAttribute("rolloff")) {
+            *rolloff_user_param = xmlState->getBoolAttribute("rolloff");
+        }
+        if (xmlState->hasAttribute("flatness")) {
+            *flatness_user_param = xmlState->getBoolAttribute("flatness");
+        }
+        if (xmlState->hasAttribute("flux")) {
+            *flux_user_param = xmlState->getBoolAttribute("flux");
+        }
+        if (xmlState->hasAttribute("spectralBands")) {
+            *spectral_bands_user_param = xmlState->getIntAttribute("spectralBands");
+        }
+        if (xmlState->hasAttribute("spectralCC")) {
+            *spectral_cc_user_param = xmlState->getIntAttribute("spectralCC");
+        }
+        if (xmlState->hasAttribute("onsets")) {
+            *onsets_user_param = xmlState->getBoolAttribute("onsets");
+        }
+        if (xmlState->hasAttribute("onsetSensitivity")) {
+            *onset_sensitivity_user_param = xmlState->getDoubleAttribute("onsetSensitivity");
+        }
+        if (xmlState->hasAttribute("onsetNote")) {
+            *onset_note_user_param = xmlState->getIntAttribute("onsetNote");
+        }
+        if (xmlState->hasAttribute("pitchOutput")) {
+            *pitch_output_user_param = xmlState->getIntAttribute("pitchOutput");
+        }
+        if (xmlState->hasAttribute("pitchThreshold")) {
+            *pitch_threshold_user_param = xmlState->getDoubleAttribute("pitchThreshold");
+        }
+        if (xmlState->hasAttribute("midiOutput")) {
+            *midi_output_user_param = xmlState->getIntAttribute("midiOutput");
+        }
+        if (xmlState->hasAttribute("ccClock")) {
+            *cc_clock_user_param = xmlState->getIntAttribute("ccClock");
+        }
+        if (xmlState->hasAttribute("ccRate")) {
+            *cc_rate_user_param = xmlState->getDoubleAttribute("ccRate");
+        }
+        if (xmlState->hasAttribute("ccDelta")) {
+            *cc_delta_user_param = xmlState->getIntAttribute("ccDelta");
+        }
+        if (xmlState->hasAttribute("ccInterval")) {
+            *cc_interval_user_param = xmlState->getDoubleAttribute("ccInterval");
+        }
+        if (xmlState->hasAttribute("ccFormat")) {
+            *cc_format_user_param = xmlState->getIntAttribute("ccFormat");
+        }
+        if (xmlState->hasAttribute("oscOutput")) {
+            *osc_output_user_param = xmlState->getBoolAttribute("oscOutput");
+        }
         if (xmlState->hasTagName("channel")) {
             midi_channel = xmlState->getIntAttribute("channel");
         }
         if (xmlState->hasTagName("type")) {
             midi_controller_type = xmlState->getIntAttribute("type");
         }
+        if (xmlState->hasAttribute("oscHost") && xmlState->hasAttribute("oscPort")) {
+            setOscTarget(xmlState->getStringAttribute("oscHost"), xmlState->getIntAttribute("oscPort"));
+        }
     }
 }
 
@@ -663,6 +1740,93 @@ int EnvelopeFollowerAudioProcessor::getMidiType()
     return midi_controller_type; // Fetch the target MIDI CC format type.
 }
 
+/**
+ * Gets the number of MIDI messages waiting for the sender thread. Safe to poll from the GUI.
+ *
+ * Returns
+ * -------
+ * int: The depth of the queue between the audio thread and the sender thread.
+ */
+int EnvelopeFollowerAudioProcessor::getMidiQueueDepth() const
+{
+    return midi_sender.getQueueDepth();
+}
+
+/**
+ * Gets the most MIDI messages that have waited for the sender thread at once. Safe to poll from the GUI.
+ *
+ * Returns
+ * -------
+ * int: The high-water mark of the queue depth.
+ */
+int EnvelopeFollowerAudioProcessor::getMaxMidiQueueDepth() const
+{
+    return midi_sender.getMaxQueueDepth();
+}
+
+/**
+ * Gets the number of MIDI messages dropped because the queue to the sender thread was full. Safe to poll from the GUI.
+ *
+ * Returns
+ * -------
+ * unsigned long long: The drop count. Anything above 0 means the sender thread is falling behind.
+ */
+unsigned long long EnvelopeFollowerAudioProcessor::getNumDroppedMidiMessages() const
+{
+    return midi_sender.getNumDropped();
+}
+
+/**
+ * Gets the host name or address the OSC output sends to.
+ *
+ * Returns
+ * -------
+ * juce::String: The host.
+ */
+juce::String EnvelopeFollowerAudioProcessor::getOscHost() const
+{
+    return osc_host;
+}
+
+/**
+ * Gets the UDP port the OSC output sends to.
+ *
+ * Returns
+ * -------
+ * int: The port.
+ */
+int EnvelopeFollowerAudioProcessor::getOscPort() const
+{
+    return osc_port;
+}
+
+/**
+ * Sets the host and UDP port the OSC output sends to, restarting the sender thread if it is running.
+ *
+ * Arguments
+ * ---------
+ * const juce::String& host: The host name or IP address to send to.
+ * int port: The UDP port to send to, from 1 to 65535.
+ */
+void EnvelopeFollowerAudioProcessor::setOscTarget(const juce::String& host, int port)
+{
+    osc_host = host;
+    osc_port = port;
+    osc_sender.setTarget(osc_host, osc_port);
+}
+
+/**
+ * Gets the number of OSC packets dropped because the queue to the sender thread was full. Safe to poll from the GUI.
+ *
+ * Returns
+ * -------
+ * unsigned long long: The drop count. Anything above 0 means the sender thread is falling behind.
+ */
+unsigned long long EnvelopeFollowerAudioProcessor::getNumDroppedOscPackets() const
+{
+    return osc_sender.getNumDropped();
+}
+
 //==============================================================================
 /**
  * Global JUCE framework function responsible for creating the EnvelopeFollowerAudioProcessor component when setting up the plugin.
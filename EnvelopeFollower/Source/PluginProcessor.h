@@ -23,10 +23,18 @@
 // Import external headers:
 #include <JuceHeader.h> // Import the JUCE dependencies required to run this plugin.
 #include "SignalProcessor.h" // Import the interface definition for the signal processor component.
+#include "SpectralFeatures.h" // Import the interface definition for the spectral feature engine.
+#include "OnsetDetector.h" // Import the interface definition for the onset detector.
+#include "PitchTracker.h" // Import the interface definition for the pitch tracker.
+#include "MidiSender.h" // Import the interface definition for the thread that sends MIDI off the audio thread.
+#include "SendOnDelta.h" // Import the interface definition for the check that skips controller values not worth sending.
+#include "MidiEncoder.h" // Import the interface definition for the encoder that writes the output messages as raw bytes.
+#include "OscEncoder.h" // Import the interface definition for the encoder that writes the OSC bundles.
+#include "OscSender.h" // Import the interface definition for the thread that sends OSC off the audio thread.
 
 
 // Are we sending OSC messages?
-#define SEND_OSC 0 // No.
+#define SEND_OSC 1 // Yes, while osc_output_user_param is on.
 // Are we sending midi messages?
 #define SEND_MIDI 1 // Yes.
 
@@ -95,18 +103,75 @@ public:
  * public juce::AudioParameterFloat* low_pass_user_param: A user-manager parameter corresponding to the maximum considered input audio frequency.
  * public juce::AudioParameterFloat* hi_pass_user_param: A user-manager parameter corresponding to the minimum considered input audio frequency.
  * public juce::AudioParameterFloat* recovery_user_param: A user-manager parameter corresponding to the length of time required for the output envelope waveform to decay to half its value given sufficiently small input values.
+ * public juce::AudioParameterChoice* filter_order_user_param: A user-managed parameter selecting the slope of the lowpass and highpass filters. (6, 12, 24 or 48 dB/octave, or the 12 dB/octave state variable filter)
+ * public juce::AudioParameterChoice* filter_alignment_user_param: A user-managed parameter selecting a Butterworth or Linkwitz-Riley design for the steeper slopes.
+ * public juce::AudioParameterChoice* detector_user_param: A user-managed parameter selecting whether the envelope follows the peak, the RMS, the true peak or the analytic magnitude of the filtered input.
+ * public juce::AudioParameterFloat* rms_window_user_param: A user-managed parameter corresponding to the length of the RMS detector window in milliseconds.
+ * public juce::AudioParameterFloat* hold_user_param: A user-managed parameter corresponding to how long, in milliseconds, the envelope holds a peak before it starts to decay.
+ * public juce::AudioParameterFloat* attack_user_param: A user-managed parameter corresponding to the length of time required for the output envelope waveform to rise halfway to a louder input.
+ * public juce::AudioParameterChoice* detector_rate_user_param: A user-managed parameter selecting whether the detector runs at the sampling frequency or decimated to 4, 2 or 1 kHz.
+ * public juce::AudioParameterChoice* channel_mode_user_param: A user-managed parameter selecting whether the input channels are downmixed into one envelope or each followed separately with its own CC.
+ * public juce::AudioParameterChoice* downmix_user_param: A user-managed parameter selecting how the input channels are combined in the downmix mode. (mean, max-abs, mid, side or power sum)
+ * public juce::AudioParameterFloat* lookahead_user_param: A user-managed parameter corresponding to how far ahead of the audio, in milliseconds, the envelope looks for peaks. Reported to the host as latency.
+ * public juce::AudioParameterInt* bands_user_param: A user-managed parameter corresponding to the number of bands the multiband mode splits the input into. 0 disables it.
+ * public juce::AudioParameterInt* band_cc_user_param: A user-managed parameter corresponding to the CC number of the lowest band. Each higher band sends the next CC number.
+ * public juce::AudioParameterBool* centroid_user_param: A user-managed parameter enabling the spectral centroid CC.
+ * public juce::AudioParameterBool* rolloff_user_param: A user-managed parameter enabling the spectral rolloff CC.
+ * public juce::AudioParameterBool* flatness_user_param: A user-managed parameter enabling the spectral flatness CC.
+ * public juce::AudioParameterBool* flux_user_param: A user-managed parameter enabling the spectral flux CC.
+ * public juce::AudioParameterInt* spectral_bands_user_param: A user-managed parameter corresponding to the number of spectral band energy CCs. 0 disables them.
+ * public juce::AudioParameterInt* spectral_cc_user_param: A user-managed parameter corresponding to the CC number of the centroid. The other spectral features follow it in a fixed order.
+ * public juce::AudioParameterBool* onsets_user_param: A user-managed parameter enabling the onset detector, which plays a note on every transient.
+ * public juce::AudioParameterFloat* onset_sensitivity_user_param: A user-managed parameter corresponding to how far, in dB, a transient must rise above the running background to trigger a note.
+ * public juce::AudioParameterInt* onset_note_user_param: A user-managed parameter corresponding to the note number the onset detector plays.
+ * public juce::AudioParameterChoice* pitch_output_user_param: A user-managed parameter selecting whether the tracked pitch is sent, as the main CC or as 14-bit pitch bend.
+ * public juce::AudioParameterFloat* pitch_threshold_user_param: A user-managed parameter corresponding to how periodic the input must be to have a pitch.
+ * public juce::AudioParameterChoice* midi_output_user_param: A user-managed parameter selecting whether MIDI goes to the plugin's own output device, to the host at its exact sample, or to both.
+ * public juce::AudioParameterChoice* cc_clock_user_param: A user-managed parameter selecting whether the CCs tick at cc_rate_user_param, once per block or on every sample.
+ * public juce::AudioParameterFloat* cc_rate_user_param: A user-managed parameter corresponding to the number of CC ticks per second in the "Rate" clock.
+ * public juce::AudioParameterInt* cc_delta_user_param: A user-managed parameter corresponding to how many steps a CC must move by to be sent again. 0 sends every tick.
+ * public juce::AudioParameterFloat* cc_interval_user_param: A user-managed parameter corresponding to the fewest milliseconds between two sends of the same CC.
+ * public juce::AudioParameterChoice* cc_format_user_param: A user-managed parameter selecting whether the CCs are sent as 7-bit CCs, 14-bit CC pairs or 14-bit NRPNs.
+ * public juce::AudioParameterBool* osc_output_user_param: A user-managed parameter enabling the OSC output, which sends every CC's value as a float over UDP.
  * public EnvelopeVisualiser EnvVisualiser: A GUI element responsible for visualizing the output envelope waveform.
  * public AudioInVisualiser AudioVisualiser: A GUI element responsible for visualizing the input audio waveform.
  * public std::String midi_info: A text string corresponding to the current last output MIDI value, channel, and type. Accessed for display by the GUI.
- * private float midi_message_rate: The rate at which MIDI messages are produced by this plugin.
- * private int samples_per_midi_message: The number of audio samples that must be processed per output MIDI message.
+ * private int samples_per_midi_message: The number of audio samples between CC ticks in the "Rate" clock.
  * private int elapsed_since_midi: The number of samples processed since the last output MIDI message.
  * private int elapsed_since_drawer: The number of samples processed since the last GUI update.
- * private SignalProcessor signalProcessor: The sole component of the audio stream to MIDI stream pipeline. 
+ * private SignalProcessor<float> signalProcessor: The audio stream to MIDI stream pipeline used when the host processes in single precision.
+ * private SignalProcessor<double> doubleSignalProcessor: The audio stream to MIDI stream pipeline used when the host processes in double precision.
+ * private std::vector<SignalProcessor<float>> channel_processors, double_channel_processors: One pipeline per input channel for the per-channel mode.
+ * private EnvelopeBank<float> channel_bank, EnvelopeBank<double> double_channel_bank: One lane per input channel, run in place of the per-channel pipelines when their settings allow.
+ * private bool channel_bank_active: Whether the per-channel envelopes came from the bank last chunk.
+ * private juce::AudioBuffer<float> vis_samples: Preallocated buffer for the envelope waveform display.
+ * private juce::AudioBuffer<float> vis_input: Preallocated float copy of double precision input, for the input waveform display.
+ * private int prepared_block_size: The block size announced in prepareToPlay. Bigger host blocks are processed in chunks of this size.
  * private int midi_channel: The MIDI channel this plugin outputs MIDI messages on.
  * private int midi_controller_type: The type of MIDI messages this plugin produces.
- * private int midi_value: The most recently output MIDI value.
- * private std::unique_ptr<juce::MidiOutput> output_device: The juce framework component used to output MIDI messages.
+ * private int midi_value: The most recently output MIDI value, as a 7-bit value for display.
+ * private double midi_level: The most recently output main CC level, from 0 to 1, before it is quantized to the CC format.
+ * private MidiSender midi_sender: The thread that owns the MIDI output device and sends the messages the audio thread queues.
+ * private SendOnDelta send_gate: Skips the CC and pitch bend values that haven't moved far enough, or soon enough after the last send, to be worth sending.
+ * private int gated_channel: The MIDI channel send_gate's last sent values were sent on.
+ * private long long sample_clock: The number of samples processed since the plugin was created. Times the sends for send_gate.
+ * private MidiEncoder midi_encoder: Writes each outgoing message as raw bytes into its own buffer, in the format cc_format_user_param selects.
+ * private juce::String osc_host: The host name or address the OSC packets are sent to.
+ * private int osc_port: The UDP port the OSC packets are sent to.
+ * private OscSender osc_sender: The thread that sends the OSC packets the audio thread queues.
+ * private OscEncoder osc_encoder: Writes the OSC bundles straight into the packet being filled.
+ * private unsigned char* osc_packet: The packet being filled, or null if none is open.
+ * private SpectralFeatures<float> spectral_features: The spectral feature engine used when the host processes in single precision.
+ * private SpectralFeatures<double> double_spectral_features: The spectral feature engine used when the host processes in double precision.
+ * private static const int spectral_fft_size: The number of samples in each spectral analysis window.
+ * private static const int spectral_hop_size: The number of samples between spectral analyses.
+ * private OnsetDetector<float> onset_detector: The onset detector used when the host processes in single precision.
+ * private OnsetDetector<double> double_onset_detector: The onset detector used when the host processes in double precision.
+ * private int sounding_onset_note: The note number of the onset note still waiting for its note-off, or -1.
+ * private PitchTracker<float> pitch_tracker: The pitch tracker used when the host processes in single precision.
+ * private PitchTracker<double> double_pitch_tracker: The pitch tracker used when the host processes in double precision.
+ * private static const int pitch_hop_size: The number of samples between pitch analyses.
+ * private std::atomic<juce::uint64> dirty_params: One bit per parameter index, set when that parameter changes and cleared when updateMathParams applies it.
  * 
  * 
  * Methods
@@ -116,6 +181,8 @@ public:
  * public void releaseResources(): 
  * public bool isBusesLayoutSupported (const BusesLayout& layouts): Checks whether a given arrangement of input and output buses can be processed by this plugin.
  * public void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&): Processes a block of input audio data into MIDI messages.
+ * public void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&): Processes a block of double precision input audio data into MIDI messages.
+ * public bool supportsDoublePrecisionProcessing(): Returns whether this plugin can process double precision audio. Always True.
  * public juce::AudioProcessorEditor* createEditor(): Creates the GUI management component for this plugin.
  * public bool hasEditor(): Returns whether this plugin should have a GUI.
  * public const juce::String getName(): Returns the name of this plugin.s
@@ -132,21 +199,61 @@ public:
  * public void setMidiChannel(int new_channel): Sets the MIDI channel this plugin outputs on.
  * public int getMidiType(): Gets the type of MIDI messages this plugin outputs.
  * public void setMidiType(int new_type): Sets the type of MIDI messages this plugin outputs.
+ * public int getMidiQueueDepth(): Gets the number of MIDI messages waiting for the sender thread.
+ * public int getMaxMidiQueueDepth(): Gets the most MIDI messages that have waited for the sender thread at once.
+ * public unsigned long long getNumDroppedMidiMessages(): Gets the number of MIDI messages dropped because the sender thread fell behind.
+ * public juce::String getOscHost(): Gets the host the OSC output sends to.
+ * public int getOscPort(): Gets the UDP port the OSC output sends to.
+ * public void setOscTarget(const juce::String& host, int port): Sets the host and UDP port the OSC output sends to.
+ * public unsigned long long getNumDroppedOscPackets(): Gets the number of OSC packets dropped because the sender thread fell behind.
  * public void getStateInformation(juce::MemoryBlock& destData): Writes the visible parameters of this plugin to memory as binary encoded XML.
  * public void setStateInformation(const void* data, int sizeInBytes): Loads and updates the visible parameters of this plugin from binary encoded XML stored in memory.
- * public void updateMathParams(): Updates the parameters of the SignalProcessor component.
- * public void sendCCMessage(int sample_number): Post an output MIDI message to the network interface.
+ * private void updateMathParams(SignalProcessor<SampleType>& processor, std::vector<SignalProcessor<SampleType>>& channelProcessors, EnvelopeBank<SampleType>& channelBank, SpectralFeatures<SampleType>& spectral, OnsetDetector<SampleType>& onsets, PitchTracker<SampleType>& pitch): Updates the parameters of the SignalProcessor, SpectralFeatures, OnsetDetector and PitchTracker components that have changed since the last call.
+ * private void applyMathParams(SignalProcessor<SampleType>& processor, juce::uint64 dirty): Applies the changed parameters to one SignalProcessor component.
+ * private void applySpectralParams(SpectralFeatures<SampleType>& spectral, juce::uint64 dirty): Applies the changed parameters to the SpectralFeatures component.
+ * private void applyOnsetParams(OnsetDetector<SampleType>& onsets, juce::uint64 dirty): Applies the changed parameters to the OnsetDetector component.
+ * private void applyPitchParams(PitchTracker<SampleType>& pitch, juce::uint64 dirty): Applies the changed parameters to the PitchTracker component.
+ * private void applyMidiParams(juce::uint64 dirty): Applies the changed CC clock, send-on-delta and CC format parameters.
+ * private double getOutputLevel(SignalProcessor<SampleType>& processor, SampleType envelope_position): Rescales an envelope value into the level a CC sends.
+ * private void writeOscTick(int index, unsigned long long time_tag, ...): Writes one CC tick's values into the open OSC packet as a time-tagged bundle.
+ * private bool openOscPacket(): Starts filling a new OSC packet, if none is open.
+ * private void flushOscPacket(): Queues the OSC packet being filled for the sender thread.
+ * private void prepareChannelProcessors(std::vector<SignalProcessor<SampleType>>&, EnvelopeBank<SampleType>&, int, double, int): Allocates and prepares one SignalProcessor per input channel, and a bank lane for each.
+ * private void processBlockInternal(juce::AudioBuffer<SampleType>&, juce::MidiBuffer&, SignalProcessor<SampleType>&, std::vector<SignalProcessor<SampleType>>&, SpectralFeatures<SampleType>&, OnsetDetector<SampleType>&, PitchTracker<SampleType>&): The shared implementation of both processBlock overloads.
+ * private bool processChunk(juce::AudioBuffer<SampleType>&, juce::MidiBuffer&, int start_sample, int num_samples, double block_time, ...): Runs the pipeline over one chunk of a block, no longer than the prepared block size.
+ * private void pushInputToVisualiser(const float/double** channels, int numChannels, int numSamples): Pushes a chunk of input audio to the input waveform display.
+ * private void parameterValueChanged(int parameterIndex, float newValue): Marks a parameter as needing to be reapplied to the SignalProcessor.
+ * private void parameterGestureChanged(int parameterIndex, bool gestureIsStarting): Unused.
+ * private void timerCallback(): Starts or stops the OSC sender thread to match osc_output_user_param, on the message thread.
+ * private bool isParamDirty(juce::uint64 dirty, const juce::AudioProcessorParameter* param): Checks a parameter's bit in a snapshot of dirty_params.
+ * public bool sendCCMessage(juce::MidiBuffer& midiMessages, int sample_number): Post the main CC to the network interface, the host or both, unless send_gate skips it.
+ * public bool sendCCMessage(juce::MidiBuffer& midiMessages, int sample_number, int controller, double level): Post a CC for the given controller to the network interface, the host or both, unless send_gate skips it.
+ * public void sendNoteMessage(juce::MidiBuffer& midiMessages, int sample_number, int note, int velocity): Post a note-on or note-off to the network interface, the host or both.
+ * public bool sendPitchBendMessage(juce::MidiBuffer& midiMessages, int sample_number, int value): Post a pitch bend message to the network interface, the host or both, unless send_gate skips it.
+ * public void postEncoded(juce::MidiBuffer& midiMessages, int sample_number): Route every message midi_encoder holds, one at a time, through postMessage.
+ * public void postMessage(juce::MidiBuffer& midiMessages, int sample_number, const unsigned char* data, int size): Route one message to the network interface, the host's buffer at its sample, or both.
  * 
  * Inherits:
  * - juce::AudioProcessor
+ * - juce::AudioProcessorParameter::Listener
+ * - juce::Timer
  * 
  * Owns
  * - SignalProcessor
+ * - EnvelopeBank
+ * - SpectralFeatures
+ * - OnsetDetector
+ * - PitchTracker
+ * - MidiSender
+ * - SendOnDelta
+ * - MidiEncoder
+ * - OscEncoder
+ * - OscSender
  * - EnvelopeFollowerAudioProcessorEditor
  * - EnvelopeVisualizer
  * - AudioInVisualizer
  */
-class EnvelopeFollowerAudioProcessor  : public juce::AudioProcessor
+class EnvelopeFollowerAudioProcessor  : public juce::AudioProcessor, private juce::AudioProcessorParameter::Listener, private juce::Timer
 {
 public:
     // The user parameters: numbers corresponding to each of the knobs
@@ -175,6 +282,132 @@ public:
     ///     The user manage parameter which controls how long it takes for the produced envelope to decay.
     /// </summary>
     juce::AudioParameterFloat* recovery_user_param; // unitless
+    /// <summary>
+    ///     The user managed parameter which controls the slope of the lowpass and highpass filters.
+    /// </summary>
+    juce::AudioParameterChoice* filter_order_user_param; // 6, 12, 24 or 48 dB/octave, or 12 dB/octave SVF
+    /// <summary>
+    ///     The user managed parameter which selects a Butterworth or Linkwitz-Riley design for the 12, 24 and 48 dB/octave slopes.
+    /// </summary>
+    juce::AudioParameterChoice* filter_alignment_user_param;
+    /// <summary>
+    ///     The user managed parameter which selects whether the envelope follows the peak, the RMS, the true (4x oversampled) peak or the analytic (Hilbert) magnitude of the filtered input.
+    /// </summary>
+    juce::AudioParameterChoice* detector_user_param;
+    /// <summary>
+    ///     The user managed parameter which controls the length of the RMS detector window.
+    /// </summary>
+    juce::AudioParameterFloat* rms_window_user_param; // ms
+    /// <summary>
+    ///     The user managed parameter which controls how long the envelope holds a peak before it starts to decay.
+    /// </summary>
+    juce::AudioParameterFloat* hold_user_param; // ms
+    /// <summary>
+    ///     The user managed parameter which controls how long the envelope takes to rise halfway to a louder input.
+    /// </summary>
+    juce::AudioParameterFloat* attack_user_param; // s
+    /// <summary>
+    ///     The user managed parameter which selects the rate the detector and envelope run at.
+    /// </summary>
+    juce::AudioParameterChoice* detector_rate_user_param;
+    /// <summary>
+    ///     The user managed parameter which selects between one downmixed envelope and one envelope per input channel.
+    /// </summary>
+    juce::AudioParameterChoice* channel_mode_user_param;
+    /// <summary>
+    ///     The user managed parameter which selects how the input channels are combined in the downmix mode.
+    /// </summary>
+    juce::AudioParameterChoice* downmix_user_param;
+    /// <summary>
+    ///     The user managed parameter which controls how far ahead of the audio the envelope looks for peaks.
+    /// </summary>
+    juce::AudioParameterFloat* lookahead_user_param; // ms
+    /// <summary>
+    ///     The user managed parameter which controls how many bands the multiband mode splits the input into.
+    /// </summary>
+    juce::AudioParameterInt* bands_user_param;
+    /// <summary>
+    ///     The user managed parameter which controls the CC number of the lowest band.
+    /// </summary>
+    juce::AudioParameterInt* band_cc_user_param;
+    /// <summary>
+    ///     The user managed parameter which enables the spectral centroid CC, sent on spectral_cc_user_param.
+    /// </summary>
+    juce::AudioParameterBool* centroid_user_param;
+    /// <summary>
+    ///     The user managed parameter which enables the spectral rolloff CC, sent one above spectral_cc_user_param.
+    /// </summary>
+    juce::AudioParameterBool* rolloff_user_param;
+    /// <summary>
+    ///     The user managed parameter which enables the spectral flatness CC, sent two above spectral_cc_user_param.
+    /// </summary>
+    juce::AudioParameterBool* flatness_user_param;
+    /// <summary>
+    ///     The user managed parameter which enables the spectral flux CC, sent three above spectral_cc_user_param.
+    /// </summary>
+    juce::AudioParameterBool* flux_user_param;
+    /// <summary>
+    ///     The user managed parameter which sets how many spectral band energies are sent, from four above spectral_cc_user_param.
+    /// </summary>
+    juce::AudioParameterInt* spectral_bands_user_param;
+    /// <summary>
+    ///     The user managed parameter which sets the CC number of the first spectral feature.
+    /// </summary>
+    juce::AudioParameterInt* spectral_cc_user_param;
+    /// <summary>
+    ///     The user managed parameter which enables the onset detector.
+    /// </summary>
+    juce::AudioParameterBool* onsets_user_param;
+    /// <summary>
+    ///     The user managed parameter which sets how far, in dB, a transient must rise above the running background to trigger a note.
+    /// </summary>
+    juce::AudioParameterFloat* onset_sensitivity_user_param;
+    /// <summary>
+    ///     The user managed parameter which sets the note number the onset detector plays. Defaults to 36, a kick drum in General MIDI.
+    /// </summary>
+    juce::AudioParameterInt* onset_note_user_param;
+    /// <summary>
+    ///     The user managed parameter which selects where the tracked pitch is sent. "CC" puts the nearest note number on midi_controller_type in place of the envelope,
+    ///     "Pitch bend" sends the fractional note number as 14-bit pitch bend on midi_channel beside the envelope CC, and "Off" stops the tracker.
+    /// </summary>
+    juce::AudioParameterChoice* pitch_output_user_param;
+    /// <summary>
+    ///     The user managed parameter which sets the YIN threshold: how low the normalised difference must dip for the input to have a pitch. Lower is stricter.
+    /// </summary>
+    juce::AudioParameterFloat* pitch_threshold_user_param;
+    /// <summary>
+    ///     The user managed parameter which selects where MIDI goes: "Device" (the plugin's own virtual output port, through the sender thread),
+    ///     "Host" (the host's MIDI buffer, at the sample each message belongs on) or "Device and host".
+    /// </summary>
+    juce::AudioParameterChoice* midi_output_user_param;
+    /// <summary>
+    ///     The user managed parameter which selects when the CCs tick: "Rate" (cc_rate_user_param times a second), "Every block"
+    ///     (on the last sample of each block) or "Every sample". Pair the faster clocks with cc_delta_user_param, or they flood the bus.
+    /// </summary>
+    juce::AudioParameterChoice* cc_clock_user_param;
+    /// <summary>
+    ///     The user managed parameter which sets how many times a second the CCs tick in the "Rate" clock.
+    /// </summary>
+    juce::AudioParameterFloat* cc_rate_user_param; // Hz
+    /// <summary>
+    ///     The user managed parameter which sets how many steps a CC has to move by, since it was last sent, to be sent again.
+    ///     0 sends on every tick, even when nothing has changed.
+    /// </summary>
+    juce::AudioParameterInt* cc_delta_user_param;
+    /// <summary>
+    ///     The user managed parameter which sets the fewest milliseconds between two sends of the same CC, however far it moves.
+    /// </summary>
+    juce::AudioParameterFloat* cc_interval_user_param; // ms
+    /// <summary>
+    ///     The user managed parameter which selects how the CCs are sent: "7-bit", "14-bit" (the fine value on the CC + 32, for CCs 0 to 31,
+    ///     the rest stay 7-bit) or "NRPN" (14-bit on any number, at four messages a value).
+    /// </summary>
+    juce::AudioParameterChoice* cc_format_user_param;
+    /// <summary>
+    ///     The user managed parameter which switches on the OSC output. Every CC tick then also sends a bundle of the unrounded values
+    ///     as floats to osc_host:osc_port, time-tagged with the moment of its sample. Independent of midi_output_user_param.
+    /// </summary>
+    juce::AudioParameterBool* osc_output_user_param;
 
 
     // GUI
@@ -243,7 +476,7 @@ public:
     /**
      * Checks whether a given arrangement of input, output and throughput audio and MIDI buffers can be processed by this plugin.
      * 
-     * Only returns true if the input layout is mono (one buffer) or stereo (two buffers) and the output layout matches the input layout as that is all this plugin supports.
+     * Only returns true if the input layout has between 1 and max_channels (64) channels and the output layout matches the input layout, as that is all this plugin supports.
      * All other inputs return false.
      * 
      * Arguments
@@ -272,6 +505,29 @@ public:
      */
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
+    /**
+     * Takes a set of double precision audio sample buffers and converts them into a series of MIDI messages posted to the network interface.
+     * 
+     * Used instead of the float overload when the host has enabled double precision processing.
+     * 
+     * Arguments
+     * ---------
+     * juce::AudioBuffer<double>&: The set of audio sample buffers used for DAW IO.
+     * juce::MidiBuffer&: The set of MIDI message buffers used for DAW IO. 
+     */
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+
+    /**
+     * Returns whether this plugin can process double precision audio.
+     * 
+     * Returns True, as the whole signal processing pipeline is templated on the sample type.
+     * 
+     * Returns
+     * -------
+     * bool: True if this plugin can process double precision audio, False otherwise. (Always True for this implementation)
+     */
+    bool supportsDoublePrecisionProcessing() const override;
+
 
     // GUI management:
 
@@ -454,6 +710,70 @@ public:
      */
     void setMidiType(int new_type);
 
+    /**
+     * Gets the number of MIDI messages waiting for the sender thread. Safe to poll from the GUI.
+     * 
+     * Returns
+     * -------
+     * int: The depth of the queue between the audio thread and the sender thread.
+     */
+    int getMidiQueueDepth() const;
+
+    /**
+     * Gets the most MIDI messages that have waited for the sender thread at once. Safe to poll from the GUI.
+     * 
+     * Returns
+     * -------
+     * int: The high-water mark of the queue depth.
+     */
+    int getMaxMidiQueueDepth() const;
+
+    /**
+     * Gets the number of MIDI messages dropped because the queue to the sender thread was full. Safe to poll from the GUI.
+     * 
+     * Returns
+     * -------
+     * unsigned long long: The drop count. Anything above 0 means the sender thread is falling behind.
+     */
+    unsigned long long getNumDroppedMidiMessages() const;
+
+    /**
+     * Gets the host name or address the OSC output sends to.
+     * 
+     * Returns
+     * -------
+     * juce::String: The host, such as "127.0.0.1".
+     */
+    juce::String getOscHost() const;
+
+    /**
+     * Gets the UDP port the OSC output sends to.
+     * 
+     * Returns
+     * -------
+     * int: The port.
+     */
+    int getOscPort() const;
+
+    /**
+     * Sets the host and UDP port the OSC output sends to. Never called from the audio thread, as it may restart the sender thread.
+     * 
+     * Arguments
+     * ---------
+     * const juce::String& host: The host name or IP address to send to.
+     * int port: The UDP port to send to, from 1 to 65535.
+     */
+    void setOscTarget(const juce::String& host, int port);
+
+    /**
+     * Gets the number of OSC packets dropped because the queue to the sender thread was full. Safe to poll from the GUI.
+     * 
+     * Returns
+     * -------
+     * unsigned long long: The drop count.
+     */
+    unsigned long long getNumDroppedOscPackets() const;
+
     /**
      * Compiles and outputs all user-visible parameters to binary encoded XML.
      * 
@@ -485,13 +805,9 @@ public:
     
 private:
     /// <summary>
-    ///     The number of MIDI messages that we should output per second.
+    ///     The number of audio samples between CC ticks in the "Rate" clock. Set from cc_rate_user_param by applyMidiParams.
     /// </summary>
-    float midi_message_rate;
-    /// <summary>
-    ///     The number of audio samples that should be processed to produce each MIDI output message.
-    /// </summary>
-    int samples_per_midi_message;
+    int samples_per_midi_message = 1;
     /// <summary>
     ///     The number of samples that have been processed since the last MIDI output message was produced.
     /// </summary>
@@ -502,9 +818,97 @@ private:
     int elapsed_since_drawer;
     
     /// <summary>
-    ///     The sole component of the audio processing pipeline used by this processor.
+    ///     The audio processing pipeline used by this processor when the host processes in single precision.
+    /// </summary>
+    SignalProcessor<float> signalProcessor;
+    /// <summary>
+    ///     The audio processing pipeline used by this processor when the host processes in double precision.
+    /// </summary>
+    SignalProcessor<double> doubleSignalProcessor;
+    /// <summary>
+    ///     One audio processing pipeline per input channel for the per-channel mode, in single precision.
+    ///     Allocated in prepareToPlay, and empty while the host processes in double precision.
+    /// </summary>
+    std::vector<SignalProcessor<float>> channel_processors;
+    /// <summary>
+    ///     One audio processing pipeline per input channel for the per-channel mode, in double precision.
+    ///     Allocated in prepareToPlay, and empty while the host processes in single precision.
+    /// </summary>
+    std::vector<SignalProcessor<double>> double_channel_processors;
+    /// <summary>
+    ///     One lane per input channel for the per-channel mode, in single precision. Runs every channel at once in place of
+    ///     channel_processors while SignalProcessor::fitsEnvelopeBank says the settings need nothing more.
+    /// </summary>
+    EnvelopeBank<float> channel_bank;
+    /// <summary>
+    ///     One lane per input channel for the per-channel mode, in double precision.
+    /// </summary>
+    EnvelopeBank<double> double_channel_bank;
+    /// <summary>
+    ///     Whether the per-channel envelopes came from the bank last chunk, so a switch to or from the processors can hand them over.
+    /// </summary>
+    bool channel_bank_active = false;
+    /// <summary>
+    ///     The most input channels the plugin accepts, and so the most per-channel envelopes.
     /// </summary>
-    SignalProcessor signalProcessor;
+    static const int max_channels = 64;
+
+    /// <summary>
+    ///     The spectral feature engine used when the host processes in single precision. Allocated in prepareToPlay.
+    /// </summary>
+    SpectralFeatures<float> spectral_features;
+    /// <summary>
+    ///     The spectral feature engine used when the host processes in double precision. Allocated in prepareToPlay.
+    /// </summary>
+    SpectralFeatures<double> double_spectral_features;
+    /// <summary>
+    ///     The number of samples in each spectral analysis window. About 43 ms at 48 kHz, or 23 Hz per bin.
+    /// </summary>
+    static const int spectral_fft_size = 2048;
+    /// <summary>
+    ///     The number of samples between spectral analyses. About 94 analyses per second at 48 kHz, well above the CC rate.
+    /// </summary>
+    static const int spectral_hop_size = 512;
+
+    /// <summary>
+    ///     The onset detector used when the host processes in single precision. Its event list is allocated in prepareToPlay.
+    /// </summary>
+    OnsetDetector<float> onset_detector;
+    /// <summary>
+    ///     The onset detector used when the host processes in double precision. Its event list is allocated in prepareToPlay.
+    /// </summary>
+    OnsetDetector<double> double_onset_detector;
+    /// <summary>
+    ///     The note number of the onset note still waiting for its note-off, or -1. Kept so the note-off matches even if onset_note_user_param moves.
+    /// </summary>
+    int sounding_onset_note = -1;
+
+    /// <summary>
+    ///     The pitch tracker used when the host processes in single precision. Allocated in prepareToPlay.
+    /// </summary>
+    PitchTracker<float> pitch_tracker;
+    /// <summary>
+    ///     The pitch tracker used when the host processes in double precision. Allocated in prepareToPlay.
+    /// </summary>
+    PitchTracker<double> double_pitch_tracker;
+    /// <summary>
+    ///     The number of samples between pitch analyses. About 47 analyses per second at 48 kHz, still above the CC rate.
+    /// </summary>
+    static const int pitch_hop_size = 1024;
+
+    /// <summary>
+    ///     The buffer the envelope waveform is drawn from. Preallocated in prepareToPlay.
+    /// </summary>
+    juce::AudioBuffer<float> vis_samples;
+    /// <summary>
+    ///     A float copy of double precision input audio for the input waveform display, which only draws floats. Preallocated in prepareToPlay.
+    /// </summary>
+    juce::AudioBuffer<float> vis_input;
+    /// <summary>
+    ///     The block size announced in prepareToPlay, which every buffer in the pipeline is sized for.
+    ///     A host that sends a bigger block gets it processed in chunks of this size.
+    /// </summary>
+    int prepared_block_size = 0;
 
     /// <summary>
     ///     Which MIDI channel this processor is outputting on.
@@ -520,20 +924,93 @@ private:
     int midi_controller_type = 14;
 
     /// <summary>
-    ///     The current value of the MIDI message to output.
+    ///     The current value of the MIDI message to output, as a 7-bit value for the GUI's description.
     /// </summary>
     int midi_value = 0;
+    /// <summary>
+    ///     The current level of the main CC, from 0 to 1. Quantized by midi_encoder to whatever resolution the CC format has.
+    /// </summary>
+    double midi_level = 0;
+
+    /// <summary>
+    ///     The thread responsible for relaying produced midi messages to the hardware's network ports for external use.
+    ///     Owns the output device. The audio thread only queues messages for it, so it never makes the system call that sends them.
+    /// </summary>
+    MidiSender midi_sender;
+    /// <summary>
+    ///     Skips the CC and pitch bend values that haven't moved by cc_delta_user_param, or that come sooner than cc_interval_user_param after the last send.
+    ///     On a steady signal that leaves the bus silent, whatever the CC clock.
+    /// </summary>
+    SendOnDelta send_gate;
+    /// <summary>
+    ///     The MIDI channel send_gate's last sent values were sent on. A new channel starts from scratch, so the receiver gets every value once.
+    /// </summary>
+    int gated_channel = 1;
+    /// <summary>
+    ///     The number of samples processed since the plugin was created. Times the sends for send_gate's minimum interval.
+    /// </summary>
+    long long sample_clock = 0;
+    /// <summary>
+    ///     Writes each outgoing message as raw bytes into its own fixed buffer, so sending never builds a juce::MidiMessage or allocates.
+    /// </summary>
+    MidiEncoder midi_encoder;
 
     /// <summary>
-    ///     The component responsible for relaying produced midi blocks to the hardware's network ports for external use.
+    ///     The host name or address the OSC packets are sent to. Our own machine unless told otherwise.
     /// </summary>
-    std::unique_ptr<juce::MidiOutput> output_device;
+    juce::String osc_host = "127.0.0.1";
+    /// <summary>
+    ///     The UDP port the OSC packets are sent to.
+    /// </summary>
+    int osc_port = 9000;
+    /// <summary>
+    ///     The thread that owns the UDP socket and sends the OSC packets the audio thread queues. Only running while osc_output_user_param is on.
+    /// </summary>
+    OscSender osc_sender;
+    /// <summary>
+    ///     Writes the OSC bundles straight into the packet being filled.
+    /// </summary>
+    OscEncoder osc_encoder;
+    /// <summary>
+    ///     The packet being filled, a slot of osc_sender's queue, or null if none is open. Only touched by the audio thread.
+    /// </summary>
+    unsigned char* osc_packet = nullptr;
     
     /// The maximum  number of plugins that can be running on a computer at once. Note that each plugin will have its own midi device.
     const int MAX_INSTANCES = 512;
+
+    /// <summary>
+    ///     One bit per parameter index, set by parameterValueChanged and cleared by updateMathParams.
+    ///     Lets updateMathParams skip the pow() and tan() calls for parameters that haven't moved.
+    ///     Starts with every bit set so the first block applies everything.
+    /// </summary>
+    std::atomic<juce::uint64> dirty_params { ~(juce::uint64) 0 };
     
     /**
-     * Updates the parameters of the SignalProcessor component from locally held values.
+     * Updates the parameters of the SignalProcessor, SpectralFeatures, OnsetDetector and PitchTracker components from locally held values.
+     * 
+     * Only parameters that have changed since the last call are reapplied, to the downmix processor, every per-channel processor, the spectral feature engine,
+     * the onset detector and the pitch tracker.
+     * 
+     * Arguments
+     * ---------
+     * SignalProcessor<SampleType>& processor: The signal processor of the precision currently in use.
+     * std::vector<SignalProcessor<SampleType>>& channelProcessors: The per-channel signal processors of the same precision.
+     * EnvelopeBank<SampleType>& channelBank: The per-channel envelope bank of the same precision.
+     * SpectralFeatures<SampleType>& spectral: The spectral feature engine of the same precision.
+     * OnsetDetector<SampleType>& onsets: The onset detector of the same precision.
+     * PitchTracker<SampleType>& pitch: The pitch tracker of the same precision.
+     */
+    template <typename SampleType>
+    void updateMathParams(SignalProcessor<SampleType>& processor, std::vector<SignalProcessor<SampleType>>& channelProcessors, EnvelopeBank<SampleType>& channelBank, SpectralFeatures<SampleType>& spectral, OnsetDetector<SampleType>& onsets, PitchTracker<SampleType>& pitch);
+
+    /**
+     * Applies the changed parameters to one SignalProcessor component.
+     * 
+     * Arguments
+     * ---------
+     * SignalProcessor<SampleType>& processor: The signal processor to update.
+     * juce::uint64 dirty: The snapshot of dirty_params taken by updateMathParams.
      * 
      * Responsible for updating:
      * - SignalProcessor::min_val
@@ -543,19 +1020,323 @@ private:
      * - SignalProcessor::highFilter::cutoff_frequency
      * - SignalProcessor::recovery_time and SignalProcessor::decay
      */
-    void updateMathParams();
+    template <typename SampleType>
+    void applyMathParams(SignalProcessor<SampleType>& processor, juce::uint64 dirty);
+
+    /**
+     * Applies the changed parameters to the SpectralFeatures component.
+     * 
+     * Arguments
+     * ---------
+     * SpectralFeatures<SampleType>& spectral: The spectral feature engine to update.
+     * juce::uint64 dirty: The snapshot of dirty_params taken by updateMathParams.
+     * 
+     * Responsible for updating:
+     * - SpectralFeatures::enabled_features
+     * - SpectralFeatures::num_bands
+     */
+    template <typename SampleType>
+    void applySpectralParams(SpectralFeatures<SampleType>& spectral, juce::uint64 dirty);
+
+    /**
+     * Applies the changed parameters to the OnsetDetector component.
+     * 
+     * Arguments
+     * ---------
+     * OnsetDetector<SampleType>& onsets: The onset detector to update.
+     * juce::uint64 dirty: The snapshot of dirty_params taken by updateMathParams.
+     * 
+     * Responsible for updating:
+     * - OnsetDetector::threshold_ratio
+     */
+    template <typename SampleType>
+    void applyOnsetParams(OnsetDetector<SampleType>& onsets, juce::uint64 dirty);
+
+    /**
+     * Applies the changed parameters to the PitchTracker component.
+     * 
+     * Arguments
+     * ---------
+     * PitchTracker<SampleType>& pitch: The pitch tracker to update.
+     * juce::uint64 dirty: The snapshot of dirty_params taken by updateMathParams.
+     * 
+     * Responsible for updating:
+     * - PitchTracker::enabled
+     * - PitchTracker::threshold
+     */
+    template <typename SampleType>
+    void applyPitchParams(PitchTracker<SampleType>& pitch, juce::uint64 dirty);
+
+    /**
+     * Applies the changed CC clock, send-on-delta and CC format parameters.
+     * 
+     * Arguments
+     * ---------
+     * juce::uint64 dirty: The snapshot of dirty_params taken by updateMathParams.
+     * 
+     * Responsible for updating:
+     * - EnvelopeFollowerAudioProcessor::samples_per_midi_message
+     * - SendOnDelta::delta
+     * - SendOnDelta::min_interval
+     * - MidiEncoder::format
+     */
+    void applyMidiParams(juce::uint64 dirty);
+
+    /**
+     * Rescales an envelope value into the level a CC sends.
+     * 
+     * Arguments
+     * ---------
+     * SignalProcessor<SampleType>& processor: The signal processor whose output range applies.
+     * SampleType envelope_position: The envelope value to rescale.
+     * 
+     * Returns
+     * -------
+     * double: The level, from 0 to 1.
+     */
+    template <typename SampleType>
+    double getOutputLevel(SignalProcessor<SampleType>& processor, SampleType envelope_position) const;
+
+    /**
+     * Writes one CC tick's values into the open OSC packet as a time-tagged bundle, starting a new packet if it doesn't fit.
+     * 
+     * Arguments
+     * ---------
+     * int index: The index of the sample within the block that the tick falls on.
+     * unsigned long long time_tag: The time of that sample, as an NTP time tag.
+     * SignalProcessor<SampleType>& processor: The signal processor of the precision in use.
+     * const SampleType* const* envelope_traces: The envelope after every sample, one trace per envelope.
+     * int trace_stride: The distance between one sample's envelope and the next in each trace.
+     * int num_envelopes: The number of traces.
+     * bool per_channel: Whether the traces are the per-channel envelopes rather than the downmix.
+     * SpectralFeatures<SampleType>& spectral: The spectral feature engine of the same precision.
+     * PitchTracker<SampleType>& pitch: The pitch tracker of the same precision.
+     */
+    template <typename SampleType>
+    void writeOscTick(int index, unsigned long long time_tag, SignalProcessor<SampleType>& processor, const SampleType* const* envelope_traces, int trace_stride, int num_envelopes, bool per_channel, SpectralFeatures<SampleType>& spectral, PitchTracker<SampleType>& pitch);
+
+    /**
+     * Starts filling a new OSC packet with an outer bundle, if none is open.
+     * 
+     * Returns
+     * -------
+     * bool: True if a packet is open, False if the sender thread's queue is full.
+     */
+    bool openOscPacket();
+
+    /**
+     * Closes the outer bundle of the OSC packet being filled and queues it for the sender thread. Does nothing if none is open.
+     */
+    void flushOscPacket();
+
+    /**
+     * Allocates and prepares one SignalProcessor per input channel for the per-channel mode.
+     * 
+     * Allocates memory, so should only be called from prepareToPlay.
+     * 
+     * Arguments
+     * ---------
+     * std::vector<SignalProcessor<SampleType>>& channelProcessors: The per-channel processors to resize and prepare.
+     * EnvelopeBank<SampleType>& channelBank: The per-channel envelope bank to prepare, with one lane per channel.
+     * int num_channels: The number of input channels. 0 releases the processors.
+     * double sampleRate: The number of audio samples per second.
+     * int samplesPerBlock: The largest block the host will send.
+     */
+    template <typename SampleType>
+    void prepareChannelProcessors(std::vector<SignalProcessor<SampleType>>& channelProcessors, EnvelopeBank<SampleType>& channelBank, int num_channels, double sampleRate, int samplesPerBlock);
+
+    /**
+     * The shared implementation of both processBlock overloads.
+     * 
+     * Arguments
+     * ---------
+     * juce::AudioBuffer<SampleType>& buffer: The set of audio sample buffers used for DAW IO.
+     * juce::MidiBuffer& midiMessages: The set of MIDI message buffers used for DAW IO.
+     * SignalProcessor<SampleType>& processor: The signal processor of the matching precision.
+     * std::vector<SignalProcessor<SampleType>>& channelProcessors: The per-channel signal processors of the matching precision.
+     * EnvelopeBank<SampleType>& channelBank: The per-channel envelope bank of the matching precision.
+     * SpectralFeatures<SampleType>& spectral: The spectral feature engine of the matching precision.
+     * OnsetDetector<SampleType>& onsets: The onset detector of the matching precision.
+     * PitchTracker<SampleType>& pitch: The pitch tracker of the matching precision.
+     */
+    template <typename SampleType>
+    void processBlockInternal(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages, SignalProcessor<SampleType>& processor, std::vector<SignalProcessor<SampleType>>& channelProcessors, EnvelopeBank<SampleType>& channelBank, SpectralFeatures<SampleType>& spectral, OnsetDetector<SampleType>& onsets, PitchTracker<SampleType>& pitch);
+
+    /**
+     * Runs the signal processing pipeline over one chunk of a block, and sends the MIDI and OSC ticks that fall in it.
+     * 
+     * Arguments
+     * ---------
+     * juce::AudioBuffer<SampleType>& buffer: The host's whole block.
+     * juce::MidiBuffer& midiMessages: The host's MIDI buffer for the block.
+     * int start_sample: The index of the chunk's first sample within the block.
+     * int num_samples: The length of the chunk. At most prepared_block_size.
+     * double block_time: The wall-clock time of the block's first sample in seconds since 1970, for the OSC time tags.
+     * SignalProcessor<SampleType>& processor: The signal processor of the matching precision.
+     * std::vector<SignalProcessor<SampleType>>& channelProcessors: The per-channel signal processors of the matching precision.
+     * EnvelopeBank<SampleType>& channelBank: The per-channel envelope bank of the matching precision.
+     * SpectralFeatures<SampleType>& spectral: The spectral feature engine of the matching precision.
+     * OnsetDetector<SampleType>& onsets: The onset detector of the matching precision.
+     * PitchTracker<SampleType>& pitch: The pitch tracker of the matching precision.
+     * 
+     * Returns
+     * -------
+     * bool: True if the main CC was sent during the chunk, False otherwise.
+     */
+    template <typename SampleType>
+    bool processChunk(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages, int start_sample, int num_samples, double block_time, SignalProcessor<SampleType>& processor, std::vector<SignalProcessor<SampleType>>& channelProcessors, EnvelopeBank<SampleType>& channelBank, SpectralFeatures<SampleType>& spectral, OnsetDetector<SampleType>& onsets, PitchTracker<SampleType>& pitch);
+
+    /**
+     * Pushes a chunk of single precision input audio to the input waveform display.
+     * 
+     * Arguments
+     * ---------
+     * const float** channels: One read pointer per input channel.
+     * int numChannels: The number of input channels.
+     * int numSamples: The number of samples in each channel.
+     */
+    void pushInputToVisualiser(const float** channels, int numChannels, int numSamples);
+
+    /**
+     * Pushes a chunk of double precision input audio to the input waveform display, via a preallocated float copy.
+     * 
+     * Arguments
+     * ---------
+     * const double** channels: One read pointer per input channel.
+     * int numChannels: The number of input channels.
+     * int numSamples: The number of samples in each channel. At most prepared_block_size.
+     */
+    void pushInputToVisualiser(const double** channels, int numChannels, int numSamples);
+
+    /**
+     * Marks a parameter as needing to be reapplied to the SignalProcessor.
+     * 
+     * Called by JUCE whenever a parameter changes, from whichever thread changed it.
+     * 
+     * Arguments
+     * ---------
+     * int parameterIndex: The index of the parameter that changed.
+     * float newValue: The new normalised value of the parameter. (unused)
+     */
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+
+    /**
+     * Starts or stops the OSC sender thread to match osc_output_user_param.
+     * 
+     * Called by JUCE on the message thread every 100 milliseconds. The parameter can change on any thread, including the
+     * audio thread, which must never start or stop a thread or wake another, so it is polled here instead.
+     */
+    void timerCallback() override;
+
+    /**
+     * Required by juce::AudioProcessorParameter::Listener. Does nothing.
+     * 
+     * Arguments
+     * ---------
+     * int parameterIndex: The index of the parameter. (unused)
+     * bool gestureIsStarting: Whether the gesture is starting or ending. (unused)
+     */
+    void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) override;
+
+    /**
+     * Checks whether a parameter's bit is set in a snapshot of dirty_params.
+     * 
+     * Arguments
+     * ---------
+     * juce::uint64 dirty: The snapshot of dirty_params.
+     * const juce::AudioProcessorParameter* param: The parameter to check.
+     * 
+     * Returns
+     * -------
+     * bool: True if the parameter has changed since the last update, False otherwise.
+     */
+    static bool isParamDirty(juce::uint64 dirty, const juce::AudioProcessorParameter* param);
+
+    /**
+     * Sends the main CC (midi_controller_type, carrying midi_value) to wherever midi_output_user_param points, unless send_gate skips it.
+     * 
+     * Arguments
+     * ---------
+     * juce::MidiBuffer& midiMessages: The host's MIDI buffer for this block.
+     * int sample_number: The index of the audio sample in the block that prompted the message.
+     * 
+     * Returns
+     * -------
+     * bool: True if the CC was sent, False if send_gate skipped it.
+     */
+    bool sendCCMessage(juce::MidiBuffer& midiMessages, int sample_number);
+
+    /**
+     * Sends a CC for the given controller to wherever midi_output_user_param points, unless send_gate skips it.
+     * 
+     * Arguments
+     * ---------
+     * juce::MidiBuffer& midiMessages: The host's MIDI buffer for this block.
+     * int sample_number: The index of the audio sample in the block that prompted the message.
+     * int controller: The CC (or NRPN) number to send.
+     * double level: The level to send, from 0 to 1. Quantized to the resolution of the CC format.
+     * 
+     * Returns
+     * -------
+     * bool: True if the CC was sent, False if send_gate skipped it.
+     */
+    bool sendCCMessage(juce::MidiBuffer& midiMessages, int sample_number, int controller, double level);
 
     /**
-     * Posts a produced MIDI message to one of the hardware's output ports.
+     * Sends a note-on or note-off to wherever midi_output_user_param points.
+     * 
+     * Arguments
+     * ---------
+     * juce::MidiBuffer& midiMessages: The host's MIDI buffer for this block.
+     * int sample_number: The index of the audio sample in the block the note belongs on.
+     * int note: The note number.
+     * int velocity: The note-on velocity, from 1 to 127, or 0 for a note-off.
+     */
+    void sendNoteMessage(juce::MidiBuffer& midiMessages, int sample_number, int note, int velocity);
+
+    /**
+     * Sends a pitch bend message on midi_channel to wherever midi_output_user_param points, unless send_gate skips it.
+     * 
+     * Arguments
+     * ---------
+     * juce::MidiBuffer& midiMessages: The host's MIDI buffer for this block.
+     * int sample_number: The index of the audio sample in the block that prompted the message.
+     * int value: The 14-bit pitch bend value, from 0 to 16383.
+     * 
+     * Returns
+     * -------
+     * bool: True if the pitch bend was sent, False if send_gate skipped it.
+     */
+    bool sendPitchBendMessage(juce::MidiBuffer& midiMessages, int sample_number, int value);
+
+    /**
+     * Routes every message midi_encoder holds through postMessage, in order, all on the same sample.
+     * 
+     * Arguments
+     * ---------
+     * juce::MidiBuffer& midiMessages: The host's MIDI buffer for this block.
+     * int sample_number: The index of the audio sample in the block the messages belong on.
+     */
+    void postEncoded(juce::MidiBuffer& midiMessages, int sample_number);
+
+    /**
+     * Routes one produced MIDI message by midi_output_user_param: queued for the output device, added to the host's
+     * buffer at its sample, or both.
+     * 
+     * The host buffer keeps the exact position in the block, so host CCs are free of jitter and identical on every
+     * offline bounce. The output device only ever sees the time the sender thread got to the message.
      * 
      * Arguments
      * ---------
-     * int sample_number: The index of the audio sample that prompted the message to be produced. (unused)
+     * juce::MidiBuffer& midiMessages: The host's MIDI buffer for this block.
+     * int sample_number: The index of the audio sample in the block the message belongs on.
+     * const unsigned char* data: The raw bytes of one short MIDI message, status byte first.
+     * int size: The number of bytes.
      */
-    void sendCCMessage(int sample_number);
+    void postMessage(juce::MidiBuffer& midiMessages, int sample_number, const unsigned char* data, int size);
     
     /**
-     * makes a new MIDI output device, deleting the old one if one exists already. Called by prepareToPlay()
+     * makes a new MIDI output device, deleting the old one if one exists already, and hands it to the sender thread. Called by prepareToPlay()
      */
     void makeMIDIOutputDevice();
 
@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+    RealFft.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the RealFft component class.
+    Dependencies:
+    - RealFft.h
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "RealFft.h" // Import the interface definition for the RealFft component for implementation.
+
+/**
+ * Tabulates the twiddles and bit reversal, and allocates the work buffers.
+ *
+ * Allocates memory, so should only be called from prepareToPlay.
+ *
+ * Arguments
+ * ---------
+ * int new_size: The length of the real signal. Rounded up to a power of 2, at least 4.
+ */
+template <typename SampleType>
+void RealFft<SampleType>::prepare(int new_size)
+{
+    const double pi = 3.14159265358979323846;
+    size = 4;
+    while (size < new_size) {
+        size *= 2;
+    }
+    const int half = size / 2;
+
+    twiddle_real.resize(half);
+    twiddle_imaginary.resize(half);
+    for (int index = 0; index < half; ++index) {
+        twiddle_real[index] = (SampleType) cos(2 * pi * index / size);
+        twiddle_imaginary[index] = (SampleType) -sin(2 * pi * index / size);
+    }
+    bit_reversed.resize(half);
+    int bits = 0;
+    while ((1 << bits) < half) {
+        ++bits;
+    }
+    for (int index = 0; index < half; ++index) {
+        int reversed = 0;
+        for (int bit = 0; bit < bits; ++bit) {
+            reversed |= ((index >> bit) & 1) << (bits - 1 - bit);
+        }
+        bit_reversed[index] = reversed;
+    }
+    work_real.assign(half, (SampleType) 0);
+    work_imaginary.assign(half, (SampleType) 0);
+}
+
+/**
+ * The spectrum of a real signal, from DC to Nyquist. Unscaled, so a full scale sine peaks at size / 2.
+ *
+ * With M = size / 2 and Z the FFT of the packed signal z[n] = x[2n] + i x[2n + 1], the spectra of the even and odd
+ * samples are E = (Z[k] + conj(Z[M - k])) / 2 and O = (Z[k] - conj(Z[M - k])) / 2i, and X[k] = E + e^(-2 pi i k / size) O.
+ *
+ * Arguments
+ * ---------
+ * const SampleType* input: size samples.
+ * SampleType* real: Receives the real part of the size / 2 + 1 bins.
+ * SampleType* imaginary: Receives the imaginary part of the size / 2 + 1 bins.
+ */
+template <typename SampleType>
+void RealFft<SampleType>::forward(const SampleType* input, SampleType* real, SampleType* imaginary)
+{
+    const int half = size / 2;
+    for (int index = 0; index < half; ++index) {
+        work_real[bit_reversed[index]] = input[2 * index];
+        work_imaginary[bit_reversed[index]] = input[2 * index + 1];
+    }
+    transform();
+
+    for (int bin = 0; bin <= half; ++bin) {
+        const int forward_index = bin == half ? 0 : bin;
+        const int mirrored = bin == 0 ? 0 : half - bin;
+        const SampleType even_real = (work_real[forward_index] + work_real[mirrored]) / 2;
+        const SampleType even_imaginary = (work_imaginary[forward_index] - work_imaginary[mirrored]) / 2;
+        const SampleType odd_real = (work_imaginary[forward_index] + work_imaginary[mirrored]) / 2;
+        const SampleType odd_imaginary = -(work_real[forward_index] - work_real[mirrored]) / 2;
+        // e^(-2 pi i k / size), which is -1 at Nyquist, past the end of the table.
+        const SampleType w_real = bin == half ? (SampleType) -1 : twiddle_real[bin];
+        const SampleType w_imaginary = bin == half ? (SampleType) 0 : twiddle_imaginary[bin];
+        real[bin] = even_real + w_real * odd_real - w_imaginary * odd_imaginary;
+        imaginary[bin] = even_imaginary + w_real * odd_imaginary + w_imaginary * odd_real;
+    }
+}
+
+/**
+ * The real signal with the given spectrum, so inverse(forward(x)) is x.
+ *
+ * Rebuilds E and O from X (E = (X[k] + conj(X[M - k])) / 2, O = (X[k] - conj(X[M - k])) e^(2 pi i k / size) / 2),
+ * packs Z = E + i O, and inverts the half-size FFT by conjugating before and after the forward one.
+ *
+ * Arguments
+ * ---------
+ * const SampleType* real: The real part of the size / 2 + 1 bins.
+ * const SampleType* imaginary: The imaginary part of the size / 2 + 1 bins. The imaginary parts of DC and Nyquist are ignored.
+ * SampleType* output: Receives size samples.
+ */
+template <typename SampleType>
+void RealFft<SampleType>::inverse(const SampleType* real, const SampleType* imaginary, SampleType* output)
+{
+    const int half = size / 2;
+    for (int bin = 0; bin < half; ++bin) {
+        const int mirrored = half - bin;
+        // DC and Nyquist are real for a real signal.
+        const SampleType x_imaginary = bin == 0 ? (SampleType) 0 : imaginary[bin];
+        const SampleType mirrored_imaginary = mirrored == half ? (SampleType) 0 : imaginary[mirrored];
+        const SampleType even_real = (real[bin] + real[mirrored]) / 2;
+        const SampleType even_imaginary = (x_imaginary - mirrored_imaginary) / 2;
+        const SampleType difference_real = (real[bin] - real[mirrored]) / 2;
+        const SampleType difference_imaginary = (x_imaginary + mirrored_imaginary) / 2;
+        // O = difference * e^(2 pi i k / size), the conjugate of the forward twiddle.
+        const SampleType odd_real = difference_real * twiddle_real[bin] + difference_imaginary * twiddle_imaginary[bin];
+        const SampleType odd_imaginary = difference_imaginary * twiddle_real[bin] - difference_real * twiddle_imaginary[bin];
+        // Z = E + i O, conjugated going into the forward FFT.
+        work_real[bit_reversed[bin]] = even_real - odd_imaginary;
+        work_imaginary[bit_reversed[bin]] = -(even_imaginary + odd_real);
+    }
+    transform();
+
+    // Conjugate again and scale by 1 / M. The real and imaginary parts are the even and odd samples.
+    const SampleType scale = (SampleType) 1 / half;
+    for (int index = 0; index < half; ++index) {
+        output[2 * index] = work_real[index] * scale;
+        output[2 * index + 1] = -work_imaginary[index] * scale;
+    }
+}
+
+/**
+ * The half-size complex FFT of the work buffers, in place. Expects them in bit reversed order.
+ *
+ * The twiddles for a butterfly of length len are every (size / len)th entry of the table.
+ */
+template <typename SampleType>
+void RealFft<SampleType>::transform()
+{
+    const int half = size / 2;
+    SampleType* real = work_real.data();
+    SampleType* imaginary = work_imaginary.data();
+    for (int length = 2; length <= half; length *= 2) {
+        const int span = length / 2;
+        const int stride = size / length;
+        for (int start = 0; start < half; start += length) {
+            for (int offset = 0; offset < span; ++offset) {
+                const SampleType w_real = twiddle_real[offset * stride];
+                const SampleType w_imaginary = twiddle_imaginary[offset * stride];
+                const int top = start + offset;
+                const int bottom = top + span;
+                const SampleType t_real = w_real * real[bottom] - w_imaginary * imaginary[bottom];
+                const SampleType t_imaginary = w_real * imaginary[bottom] + w_imaginary * real[bottom];
+                real[bottom] = real[top] - t_real;
+                imaginary[bottom] = imaginary[top] - t_imaginary;
+                real[top] += t_real;
+                imaginary[top] += t_imaginary;
+            }
+        }
+    }
+}
+
+// The plugin uses both precisions, depending on what the host asks for.
+template class RealFft<float>;
+template class RealFft<double>;
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    RealFft.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition for the RealFft component class, a preallocated radix-2 FFT of real
+                 signals, forward and inverse.
+    Dependencies:
+    - algorithm
+    - math.h
+    - vector
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <algorithm> // Imports the c++ stdlib algorithm libarary.
+#include <math.h> // Imports the basic c stdlib math library
+#include <vector> // Imports the c++ stdlib vector container used for the preallocated tables and work buffers.
+
+/**
+ * The FFT of a real signal of a power of 2 length, and its inverse, shared by the analysers that run at control rate.
+ *
+ * The even and odd samples are packed as the real and imaginary parts of a half-size complex signal, which is
+ * transformed in place by an iterative radix-2 FFT. One more pass untangles the spectra of the even and odd samples
+ * into the spectrum of the whole signal, so a real FFT costs about half a complex one of the same length. The inverse
+ * runs the same steps backwards.
+ *
+ * The twiddles, the bit reversal and the work buffers are all allocated by prepare, so the transforms never allocate.
+ *
+ * Attributes
+ * ----------
+ * private int size: The length of the real signal. A power of 2.
+ * private std::vector<SampleType> twiddle_real, twiddle_imaginary: e^(-2 pi i k / size) for k below size / 2.
+ * private std::vector<int> bit_reversed: The bit reversal permutation of the half-size complex FFT.
+ * private std::vector<SampleType> work_real, work_imaginary: The half-size complex FFT buffer.
+ *
+ * Methods
+ * -------
+ * public void prepare(int new_size): Tabulates the twiddles and bit reversal and allocates the work buffers.
+ * public int getSize(): Returns the length of the real signal.
+ * public void forward(const SampleType* input, SampleType* real, SampleType* imaginary): The spectrum of a real signal, from DC to Nyquist.
+ * public void inverse(const SampleType* real, const SampleType* imaginary, SampleType* output): The real signal with the given spectrum.
+ * private void transform(): The half-size complex FFT of the work buffers, in place.
+ *
+ * Owned by
+ * - SpectralFeatures
+ * - PitchTracker
+ */
+template <typename SampleType>
+class RealFft
+{
+public:
+    /**
+     * Tabulates the twiddles and bit reversal, and allocates the work buffers.
+     *
+     * Allocates memory, so should only be called from prepareToPlay.
+     *
+     * Arguments
+     * ---------
+     * int new_size: The length of the real signal. Rounded up to a power of 2, at least 4.
+     */
+    void prepare(int new_size);
+
+    /**
+     * Returns the length of the real signal.
+     *
+     * Returns
+     * -------
+     * int: The length, a power of 2. 0 until prepare.
+     */
+    int getSize() const { return size; };
+
+    /**
+     * The spectrum of a real signal, from DC to Nyquist. Unscaled, so a full scale sine peaks at size / 2.
+     *
+     * Arguments
+     * ---------
+     * const SampleType* input: size samples.
+     * SampleType* real: Receives the real part of the size / 2 + 1 bins.
+     * SampleType* imaginary: Receives the imaginary part of the size / 2 + 1 bins.
+     */
+    void forward(const SampleType* input, SampleType* real, SampleType* imaginary);
+
+    /**
+     * The real signal with the given spectrum, so inverse(forward(x)) is x.
+     *
+     * Arguments
+     * ---------
+     * const SampleType* real: The real part of the size / 2 + 1 bins.
+     * const SampleType* imaginary: The imaginary part of the size / 2 + 1 bins. The imaginary parts of DC and Nyquist are ignored.
+     * SampleType* output: Receives size samples.
+     */
+    void inverse(const SampleType* real, const SampleType* imaginary, SampleType* output);
+
+private:
+    /**
+     * The half-size complex FFT of the work buffers, in place. Expects them in bit reversed order.
+     */
+    void transform();
+
+    /// <summary>
+    ///     The length of the real signal. A power of 2. 0 until prepare.
+    /// </summary>
+    int size = 0;
+    /// <summary>
+    ///     cos(2 pi k / size) for k below size / 2.
+    /// </summary>
+    std::vector<SampleType> twiddle_real;
+    /// <summary>
+    ///     -sin(2 pi k / size) for k below size / 2.
+    /// </summary>
+    std::vector<SampleType> twiddle_imaginary;
+    /// <summary>
+    ///     The bit reversal permutation of the half-size complex FFT.
+    /// </summary>
+    std::vector<int> bit_reversed;
+    /// <summary>
+    ///     The real parts of the half-size complex FFT buffer.
+    /// </summary>
+    std::vector<SampleType> work_real;
+    /// <summary>
+    ///     The imaginary parts of the half-size complex FFT buffer.
+    /// </summary>
+    std::vector<SampleType> work_imaginary;
+};
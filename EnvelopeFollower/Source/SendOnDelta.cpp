@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    SendOnDelta.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the setup methods of the SendOnDelta component class.
+    Dependencies:
+    - SendOnDelta.h
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "SendOnDelta.h" // Import the interface definition for the SendOnDelta component for implementation.
+
+/**
+ * The constructor for the SendOnDelta component. Starts with every slot empty, so the first value on each is sent.
+ */
+SendOnDelta::SendOnDelta()
+{
+    reset();
+}
+
+/**
+ * Sets the fewest steps a value has to move by, since the last one sent on its slot, to be sent.
+ *
+ * Arguments
+ * ---------
+ * int new_delta: The step, in 7-bit CC steps. 0 sends every value, even repeats.
+ */
+void SendOnDelta::setDelta(int new_delta)
+{
+    delta = std::max(new_delta, 0);
+}
+
+/**
+ * Sets the fewest samples between two sends on the same slot.
+ *
+ * Arguments
+ * ---------
+ * long long new_min_interval: The interval in samples. 0 puts no limit on how often a slot sends.
+ */
+void SendOnDelta::setMinInterval(long long new_min_interval)
+{
+    min_interval = std::max(new_min_interval, 0LL);
+}
+
+/**
+ * Forgets every sent value, so the next value on each slot is sent whatever it is.
+ */
+void SendOnDelta::reset()
+{
+    std::fill(last_values, last_values + num_slots, -1LL);
+    // Far enough back that no interval can hold the first send, but not so far that subtracting it overflows.
+    std::fill(last_times, last_times + num_slots, -(1LL << 62));
+}
@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    SendOnDelta.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition and the inline send check of the SendOnDelta component class, which
+                 decides which controller values are worth sending.
+    Dependencies:
+    - algorithm
+    - cstdlib
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <algorithm> // Imports the c++ stdlib algorithm libarary.
+#include <cstdlib> // Imports the c++ stdlib integer abs.
+
+/**
+ * Thins out a stream of controller values so only the ones that say something new are sent.
+ *
+ * Each controller has its own slot, holding the last value sent and when it was sent. A value is let through when it
+ * differs from the last one sent by at least delta steps, and at least min_interval samples have passed since the
+ * last send on that slot. A steady signal then sends nothing at all, however fast the CC clock runs, while a transient
+ * goes out on the next tick. A value held back by the interval isn't lost: the slot keeps its last sent value, so the
+ * next tick after the interval sends it if it still differs.
+ *
+ * The first value on each slot after a reset is always sent, so the receiver starts in step with us.
+ *
+ * Attributes
+ * ----------
+ * public static const int num_slots: The number of slots. One per CC number, and one for pitch bend.
+ * public static const int pitch_bend_slot: The slot pitch bend uses.
+ * private int delta: The fewest 7-bit steps a value has to move by to be sent. 0 sends every value.
+ * private long long min_interval: The fewest samples between two sends on the same slot.
+ * private long long last_values[num_slots]: The last value sent on each slot, or -1 if none has been.
+ * private long long last_times[num_slots]: The sample time of the last send on each slot.
+ *
+ * Methods
+ * -------
+ * public void setDelta(int new_delta): Sets the fewest steps a value has to move by to be sent.
+ * public void setMinInterval(long long new_min_interval): Sets the fewest samples between two sends on one slot.
+ * public void reset(): Forgets every sent value, so the next value on each slot is sent.
+ * public bool shouldSend(int slot, long long value, long long time, long long resolution): Checks a value, and records it if it should be sent.
+ *
+ * Owned by
+ * - EnvelopeFollowerAudioProcessor
+ */
+class SendOnDelta
+{
+public:
+    /// <summary>
+    ///     The number of slots: CC numbers 0 to 127, then pitch bend.
+    /// </summary>
+    static const int num_slots = 129;
+    /// <summary>
+    ///     The slot pitch bend uses.
+    /// </summary>
+    static const int pitch_bend_slot = 128;
+
+    SendOnDelta();
+
+    /**
+     * Sets the fewest steps a value has to move by, since the last one sent on its slot, to be sent.
+     *
+     * Arguments
+     * ---------
+     * int new_delta: The step, in 7-bit CC steps. 0 sends every value, even repeats.
+     */
+    void setDelta(int new_delta);
+
+    /**
+     * Sets the fewest samples between two sends on the same slot.
+     *
+     * Arguments
+     * ---------
+     * long long new_min_interval: The interval in samples. 0 puts no limit on how often a slot sends.
+     */
+    void setMinInterval(long long new_min_interval);
+
+    /**
+     * Forgets every sent value, so the next value on each slot is sent whatever it is.
+     */
+    void reset();
+
+    /**
+     * Checks whether a value should be sent, and if so records it as the last value sent on its slot.
+     *
+     * Arguments
+     * ---------
+     * int slot: The slot, from 0 to num_slots - 1. A CC number, or pitch_bend_slot.
+     * long long value: The value about to be sent.
+     * long long time: The running sample time of the send.
+     * long long resolution: The number of value steps in one 7-bit step, so delta means the same for 14-bit values. 1 for a 7-bit CC.
+     *
+     * Returns
+     * -------
+     * bool: True if the value should be sent, False if it should be skipped.
+     */
+    bool shouldSend(int slot, long long value, long long time, long long resolution = 1) {
+        if (time - last_times[slot] < min_interval) {
+            return false;
+        }
+        const long long last_value = last_values[slot];
+        if (last_value >= 0 && std::llabs(value - last_value) < delta * resolution) {
+            return false;
+        }
+        last_values[slot] = value;
+        last_times[slot] = time;
+        return true;
+    };
+
+private:
+    /// <summary>
+    ///     The fewest 7-bit steps a value has to move by to be sent. 0 sends every value.
+    /// </summary>
+    int delta = 0;
+    /// <summary>
+    ///     The fewest samples between two sends on the same slot.
+    /// </summary>
+    long long min_interval = 0;
+    /// <summary>
+    ///     The last value sent on each slot, or -1 if nothing has been sent since the last reset.
+    /// </summary>
+    long long last_values[num_slots];
+    /// <summary>
+    ///     The sample time of the last send on each slot.
+    /// </summary>
+    long long last_times[num_slots];
+};
@@ -24,14 +24,20 @@
  *
  * Sets the default values for the audio processing parameters.
  */
-SignalProcessor::SignalProcessor()
+template <typename SampleType>
+SignalProcessor<SampleType>::SignalProcessor()
 {
     // Sets the default values for the coefficents
     min_val = 0.0;
     max_val = 127.0;
-    gain = 1.0;
+    gain.set_target(1, 0);
+    decay.set_target((SampleType) 0.99, 0);
+    attack.set_target(0, 0);
     current_envelope_position = 0.0;
     sampling_frequency = 44100;
+    // Match the Filter default cutoffs.
+    lowpass_cutoff.set_target(1000, 0);
+    highpass_cutoff.set_target(1000, 0);
 }
 
 /**
@@ -41,36 +47,607 @@ SignalProcessor::SignalProcessor()
  *
  * Arguments
  * ---------
- * double sample: The input audio sample to update the output value
+ * SampleType sample: The input audio sample to update the output value
  */
-void SignalProcessor::takeInSample(double sample)
+template <typename SampleType>
+void SignalProcessor<SampleType>::takeInSample(SampleType sample)
 {
+    // Above 88.2 kHz, the decimating front end averages each group of input samples, and the rest runs once per group.
+    if (front_decimation > 1) {
+        front_accumulator += sample;
+        if (++front_phase < front_decimation) {
+            return;
+        }
+        sample = front_accumulator * ((SampleType) 1 / front_decimation);
+        front_phase = 0;
+        front_accumulator = 0;
+    }
     // Scale the input audio sample.
-    sample *= gain;
+    sample *= gain.next();
     // Apply a lowpass and highpass filter to the input audio sample.
-    sample = lowFilter.calculate_lpf(sample);
-    sample = highFilter.calculate_hpf(sample);
+    if (state_variable) {
+        sample = lowStateVariable.processSample(sample, lowpass_cutoff.next()).low;
+        sample = highStateVariable.processSample(sample, highpass_cutoff.next()).high;
+    } else if (filter_order > 1) {
+        sample = cascade.processSample(sample);
+    } else {
+        sample = lowFilter.calculate_lpf(sample);
+        sample = highFilter.calculate_hpf(sample);
+    }
+    // The decimated detector gathers samples and only updates the envelope once per group.
+    if (decimation > 1) {
+        const SampleType sample_decay = decay.next();
+        const SampleType sample_attack = attack.next();
+        decimateSample(sample, sample_decay, sample_attack);
+        return;
+    }
+    // The RMS detector replaces the sample with the RMS of the window ending on it.
+    if (detector_mode == DetectorMode::rms) {
+        sample = rms.processSample(sample);
+    }
+    // The true-peak detector replaces the sample with the largest of its four interpolated sub-samples.
+    if (detector_mode == DetectorMode::truePeak) {
+        sample = true_peak.processSample(sample);
+    }
+    // The analytic detector replaces the sample with the magnitude of the analytic signal.
+    if (detector_mode == DetectorMode::analytic) {
+        sample = analytic.processSample(sample);
+    }
+    // The lookahead replaces the sample with the maximum of the detector signal over the lookahead.
+    if (lookahead_samples > 0) {
+        sample = lookahead.processSample((SampleType) fabs(sample));
+    }
+    // The hold stage replaces the sample with the maximum of the detector signal over the hold time.
+    if (hold_time > 0) {
+        sample = hold.processSample((SampleType) fabs(sample));
+    }
     // Update the tentative MIDI output sample.
     updateEnvelopePosition(sample);
 }
 
 /**
- * Updates the value of the output MIDI messages given an input audio sample.
+ * Updates the envelope from a whole block of multichannel input audio.
  *
- * Sets the output sample to the maximum of the input audio value and the decayed output value.
+ * Equivalent to averaging the channels and calling takeInSample once per sample, but each stage (downmix, gain and
+ * filters, detector, decay) runs as a tight loop over the block with its coefficients and state held in locals.
  *
  * Arguments
  * ---------
- * float sample: The audio sample used to update the output MIDI value.
+ * const SampleType* const* channels: One read pointer per input channel.
+ * int numChannels: The number of input channels. The channels are averaged together before processing.
+ * int numSamples: The number of samples in each channel.
+ *
+ * Returns
+ * -------
+ * const SampleType*: The envelope value after each of the numSamples input samples. Valid until the next call.
  */
-void SignalProcessor::updateEnvelopePosition(float sample)
+template <typename SampleType>
+const SampleType* SignalProcessor<SampleType>::processBlock(const SampleType* const* channels, int numChannels, int numSamples)
 {
-    // Decay the tentative output MIDI value.
-    current_envelope_position *= decay;
-    // Increases the MIDI output value up to the input audio sample.
-    if (abs(sample) > current_envelope_position) {
-        current_envelope_position = abs(sample);
+    // The caller splits bigger blocks, so this never triggers in the plugin. It only stops a stray call from writing past the trace.
+    numSamples = std::min(numSamples, (int) envelope_trace.size());
+    SampleType* trace = envelope_trace.data();
+
+    // Combine the input channels into the trace. The gain is applied separately since it may be ramping,
+    // so the downmix's own scaling factor is folded in with it.
+    SampleType input_scale = downmixBlock(channels, numChannels, numSamples, trace);
+
+    // The bands all read the same downmix, so they run before the trace is filtered in place.
+    if (num_bands > 0) {
+        const SampleType* band_inputs[max_bands];
+        for (int band = 0; band < num_bands; ++band) {
+            // The bank has no gain ramps, so it takes the gain the main chain is gliding to.
+            bands.setLaneGain(band, (float) (gain.target * input_scale));
+            band_inputs[band] = trace;
+        }
+        bands.processBlock(band_inputs, numSamples);
+    }
+
+    // Above 88.2 kHz the decimated detector first averages the input down to the filter rate, and everything
+    // from the filters on runs over the group sums at the start of the trace. The 1 / front_decimation of the
+    // average rides along with the downmix scaling.
+    const int block_samples = numSamples;
+    const int first_end = front_decimation - front_phase - 1;
+    const SampleType previous_envelope = current_envelope_position;
+    if (front_decimation > 1) {
+        numSamples = reduceBlock(trace, numSamples);
+        input_scale *= (SampleType) 1 / front_decimation;
     }
+
+    // The cascade runs over the whole downmixed block before the fused loop. The filters are linear,
+    // so filtering before the gain instead of after only differs while the gain is gliding.
+    const bool one_pole = !state_variable && filter_order <= 1;
+    if (state_variable) {
+        processStateVariable(trace, numSamples);
+    } else if (!one_pole) {
+        cascade.process(trace, numSamples);
+    }
+
+    // Split the block wherever a coefficient ramp ends, so each segment is either entirely
+    // ramping or entirely steady, and the steady case pays nothing for smoothing.
+    SmoothedCoefficient<SampleType>* coefficients[] = { &gain, &decay, &attack, &lowFilter.lp_b, &lowFilter.feedback, &highFilter.hp_b, &highFilter.feedback };
+    int position = 0;
+    while (position < numSamples) {
+        int segment = numSamples - position;
+        bool ramping = false;
+        for (SmoothedCoefficient<SampleType>* coefficient : coefficients) {
+            if (coefficient->remaining > 0) {
+                segment = std::min(segment, coefficient->remaining);
+                ramping = true;
+            }
+        }
+
+        SampleType* segment_trace = trace + position;
+        if (ramping) {
+            if (one_pole) {
+                processSegment<true, true>(segment_trace, segment, input_scale);
+            } else {
+                processSegment<true, false>(segment_trace, segment, input_scale);
+            }
+        } else {
+            if (one_pole) {
+                processSegment<false, true>(segment_trace, segment, input_scale);
+            } else {
+                processSegment<false, false>(segment_trace, segment, input_scale);
+            }
+        }
+
+        if (decimation > 1) {
+            // Detect, hold and follow at the detector rate instead of once per sample.
+            if (decay.remaining > 0 || attack.remaining > 0) {
+                decimateSegment<true>(segment_trace, segment);
+            } else {
+                decimateSegment<false>(segment_trace, segment);
+            }
+        } else {
+            // Turn the filtered signal into the detector signal.
+            detectSegment(segment_trace, segment);
+
+            // Bring each peak forward by the lookahead. The audio is delayed to match.
+            if (lookahead_samples > 0) {
+                lookahead.process(segment_trace, segment);
+            }
+
+            // Hold each peak for hold_time before the decay can take it down.
+            if (hold_time > 0) {
+                hold.process(segment_trace, segment);
+            }
+
+            // Attack towards the detector signal when it is above the decayed envelope, release otherwise.
+            if (decay.remaining > 0 || attack.remaining > 0) {
+                followSegment<true>(segment_trace, segment);
+            } else {
+                followSegment<false>(segment_trace, segment);
+            }
+        }
+
+        // Move every ramp along by the segment length.
+        for (SmoothedCoefficient<SampleType>* coefficient : coefficients) {
+            coefficient->skip(segment);
+        }
+        position += segment;
+    }
+
+    if (front_decimation > 1) {
+        expandBlock(trace, block_samples, numSamples, first_end, previous_envelope);
+    }
+
+    return trace;
+}
+
+/**
+ * The decimating front end. Sums each group of front_decimation input samples into one filter-rate sample, packed at
+ * the start of the trace. Each sum only reads input samples at or after the slot it is written to, so this works in place.
+ *
+ * Summing a group and keeping one value per group is a first-order CIC decimator, an integrate-and-dump average once
+ * scaled. It is the cheapest anti-aliasing filter there is, and at the 44.1 or 48 kHz it decimates to its first null
+ * is at the filter rate, so what folds back into the audible band is already well down.
+ *
+ * Arguments
+ * ---------
+ * SampleType* trace: The downmixed input samples. Overwritten at the start with the group sums.
+ * int numSamples: The number of input samples.
+ *
+ * Returns
+ * -------
+ * int: The number of groups finished in this block.
+ */
+template <typename SampleType>
+int SignalProcessor<SampleType>::reduceBlock(SampleType* trace, int numSamples)
+{
+    int num_reduced = 0;
+    int position = 0;
+    while (position < numSamples) {
+        // Gather up to the end of the group, or of the block.
+        const int span = std::min(front_decimation - front_phase, numSamples - position);
+        SampleType sum = front_accumulator;
+        for (int index = position; index < position + span; ++index) {
+            sum += trace[index];
+        }
+        position += span;
+        front_phase += span;
+        front_accumulator = sum;
+        if (front_phase == front_decimation) {
+            trace[num_reduced++] = sum;
+            front_phase = 0;
+            front_accumulator = 0;
+        }
+    }
+    return num_reduced;
+}
+
+/**
+ * Spreads the envelope after each filter-rate sample back over the input samples, in place.
+ *
+ * The filter-rate sample k is finished by input sample first_end + k * front_decimation, so from there until the next
+ * one finishes, the trace holds its envelope, just as the full-rate trace holds the envelope after each input sample.
+ * The runs are written from the end of the block, so each is read before anything is written over it.
+ *
+ * Arguments
+ * ---------
+ * SampleType* trace: The envelope after each filter-rate sample, at the start. Overwritten with the envelope after each input sample.
+ * int numSamples: The number of input samples.
+ * int numReduced: The number of filter-rate samples.
+ * int first_end: The input sample that finished the first group.
+ * SampleType previous_envelope: The envelope before the block, for the input samples before first_end.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::expandBlock(SampleType* trace, int numSamples, int numReduced, int first_end, SampleType previous_envelope)
+{
+    int run_end = numSamples;
+    for (int reduced = numReduced - 1; reduced >= 0; --reduced) {
+        const int run_start = first_end + reduced * front_decimation;
+        const SampleType envelope = trace[reduced];
+        std::fill(trace + run_start, trace + run_end, envelope);
+        run_end = run_start;
+    }
+    std::fill(trace, trace + run_end, previous_envelope);
+}
+
+/**
+ * Combines the input channels into the trace according to downmix_mode.
+ *
+ * Arguments
+ * ---------
+ * const SampleType* const* channels: One read pointer per input channel.
+ * int numChannels: The number of input channels.
+ * int numSamples: The number of samples in each channel.
+ * SampleType* trace: Where to write the combined signal. Has room for numSamples.
+ *
+ * Returns
+ * -------
+ * SampleType: The scaling factor still to apply to the trace.
+ */
+template <typename SampleType>
+SampleType SignalProcessor<SampleType>::downmixBlock(const SampleType* const* channels, int numChannels, int numSamples, SampleType* trace)
+{
+    if (numChannels <= 0) {
+        std::fill(trace, trace + numSamples, (SampleType) 0);
+        return 0;
+    }
+    const SampleType* first = channels[0];
+
+    switch (downmix_mode) {
+        case DownmixMode::mid:
+        case DownmixMode::side: {
+            // Mid and side only look at the first pair. A mono input is all mid and no side.
+            if (numChannels < 2) {
+                std::copy(first, first + numSamples, trace);
+                return downmix_mode == DownmixMode::mid ? (SampleType) 1 : (SampleType) 0;
+            }
+            const SampleType* second = channels[1];
+            const SampleType sign = downmix_mode == DownmixMode::mid ? (SampleType) 1 : (SampleType) -1;
+            for (int index = 0; index < numSamples; ++index) {
+                trace[index] = first[index] + sign * second[index];
+            }
+            return (SampleType) 0.5;
+        }
+        case DownmixMode::maxAbs:
+        case DownmixMode::powerSum: {
+            // Both start from the loudest sample of any channel, sign included. The select compiles to a blend.
+            const bool power = downmix_mode == DownmixMode::powerSum;
+            SampleType* squares = downmix_power.data();
+            std::copy(first, first + numSamples, trace);
+            if (power) {
+                for (int index = 0; index < numSamples; ++index) {
+                    squares[index] = first[index] * first[index];
+                }
+            }
+            for (int channel = 1; channel < numChannels; ++channel) {
+                const SampleType* input = channels[channel];
+                for (int index = 0; index < numSamples; ++index) {
+                    trace[index] = fabs(input[index]) > fabs(trace[index]) ? input[index] : trace[index];
+                }
+                if (power) {
+                    for (int index = 0; index < numSamples; ++index) {
+                        squares[index] += input[index] * input[index];
+                    }
+                }
+            }
+            if (power) {
+                // The RMS across the channels, with the sign of the loudest one so the filters still see a waveform.
+                // Run on LaneVector, since the libm calls only vectorise with -fno-math-errno, which the exporters don't set.
+                typedef LaneVector<SampleType> V;
+                const SampleType inverse_channels = (SampleType) 1 / numChannels;
+                const typename V::Register scale = V::broadcast(inverse_channels);
+                int index = 0;
+                for (; index + V::width <= numSamples; index += V::width) {
+                    V::store(trace + index, V::copySign(V::sqrt(V::mul(V::load(squares + index), scale)), V::load(trace + index)));
+                }
+                for (; index < numSamples; ++index) {
+                    trace[index] = (SampleType) copysign(sqrt(squares[index] * inverse_channels), trace[index]);
+                }
+            }
+            return 1;
+        }
+        case DownmixMode::mean:
+        default: {
+            // Sum the input channels into the trace one channel at a time, so every pass is a contiguous read.
+            std::copy(first, first + numSamples, trace);
+            for (int channel = 1; channel < numChannels; ++channel) {
+                const SampleType* input = channels[channel];
+                for (int index = 0; index < numSamples; ++index) {
+                    trace[index] += input[index];
+                }
+            }
+            // The averaging factor.
+            return (SampleType) 1 / numChannels;
+        }
+    }
+}
+
+/**
+ * Runs the fused gain and one-pole filter loop over part of a block.
+ *
+ * Ramping selects, at compile time, whether the coefficients advance by their ramp step every sample.
+ * OnePole selects whether the one-pole filters run here, or were already applied by the cascade or state variable filters.
+ * processBlock splits the block so that every ramp starts or ends on a segment boundary.
+ *
+ * Arguments
+ * ---------
+ * SampleType* trace: The downmixed input samples for the segment. Overwritten with the filtered samples.
+ * int numSamples: The length of the segment.
+ * SampleType input_scale: The downmix scaling factor applied before the gain.
+ */
+template <typename SampleType>
+template <bool Ramping, bool OnePole>
+void SignalProcessor<SampleType>::processSegment(SampleType* trace, int numSamples, SampleType input_scale)
+{
+    // Hoist the coefficients and their per-sample ramp steps. These are the same expressions as
+    // Filter::calculate_lpf and Filter::calculate_hpf.
+    SampleType block_gain = gain.current;
+    SampleType lp_b = lowFilter.lp_b.current;
+    SampleType lp_feedback = lowFilter.feedback.current;
+    SampleType hp_b = highFilter.hp_b.current;
+    SampleType hp_feedback = highFilter.feedback.current;
+    const SampleType gain_step = gain.step;
+    const SampleType lp_b_step = lowFilter.lp_b.step;
+    const SampleType lp_feedback_step = lowFilter.feedback.step;
+    const SampleType hp_b_step = highFilter.hp_b.step;
+    const SampleType hp_feedback_step = highFilter.feedback.step;
+
+    // Hoist the filter state.
+    SampleType lp_prev_input = lowFilter.prev_input;
+    SampleType lp_prev_output = lowFilter.prev_output;
+    SampleType hp_prev_input = highFilter.prev_input;
+    SampleType hp_prev_output = highFilter.prev_output;
+
+    for (int index = 0; index < numSamples; ++index) {
+        if (Ramping) {
+            // Same order as SmoothedCoefficient::next: step first, then use.
+            block_gain += gain_step;
+            lp_b += lp_b_step;
+            lp_feedback += lp_feedback_step;
+            hp_b += hp_b_step;
+            hp_feedback += hp_feedback_step;
+        }
+
+        // Scale the downmixed input audio sample.
+        SampleType sample = trace[index] * input_scale * block_gain;
+
+        SampleType hp_output = sample;
+        if (OnePole) {
+            // Lowpass filter.
+            SampleType lp_output = lp_b * (sample + lp_prev_input) + lp_feedback * lp_prev_output;
+            lp_prev_input = sample;
+            lp_prev_output = lp_output;
+
+            // Highpass filter.
+            hp_output = hp_b * (lp_output - hp_prev_input) + hp_feedback * hp_prev_output;
+            hp_prev_input = lp_output;
+            hp_prev_output = hp_output;
+        }
+
+        trace[index] = hp_output;
+    }
+
+    // Write the state back for the next segment.
+    lowFilter.prev_input = lp_prev_input;
+    lowFilter.prev_output = lp_prev_output;
+    highFilter.prev_input = hp_prev_input;
+    highFilter.prev_output = hp_prev_output;
+}
+
+/**
+ * Turns the filtered signal into the detector signal over part of a block, in place.
+ *
+ * The peak detector rectifies each sample. The RMS detector replaces each sample with the RMS of the
+ * window ending on it, which costs the same per sample whatever the window length. The true-peak detector
+ * replaces each sample with the largest magnitude of the four sub-samples a 4x interpolator puts around it.
+ * The analytic detector replaces each sample with the magnitude of the analytic signal, which is smooth for a tone.
+ *
+ * Arguments
+ * ---------
+ * SampleType* trace: The filtered samples for the segment. Overwritten with the detector signal.
+ * int numSamples: The length of the segment.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::detectSegment(SampleType* trace, int numSamples)
+{
+    if (detector_mode == DetectorMode::rms) {
+        rms.process(trace, numSamples);
+        return;
+    }
+    if (detector_mode == DetectorMode::truePeak) {
+        true_peak.process(trace, numSamples);
+        return;
+    }
+    if (detector_mode == DetectorMode::analytic) {
+        analytic.process(trace, numSamples);
+        return;
+    }
+    for (int index = 0; index < numSamples; ++index) {
+        trace[index] = (SampleType) fabs(trace[index]);
+    }
+}
+
+/**
+ * Runs the attack and release loop over part of a block.
+ *
+ * Every sample the envelope decays, and wherever the detector signal is above the decayed envelope, the envelope
+ * moves towards it by the attack coefficient instead. The choice between the two is a select rather than a branch,
+ * so noisy material, where it flips almost every sample, costs no mispredictions, and the loop body has no control
+ * flow to stop the compiler vectorising it. With no attack time this is exactly max(envelope * decay, detector).
+ *
+ * Ramping selects, at compile time, whether the decay and attack advance by their ramp steps every sample.
+ *
+ * Arguments
+ * ---------
+ * SampleType* trace: The detector signal for the segment. Overwritten with the envelope.
+ * int numSamples: The length of the segment.
+ */
+template <typename SampleType>
+template <bool Ramping>
+void SignalProcessor<SampleType>::followSegment(SampleType* trace, int numSamples)
+{
+    SampleType block_decay = decay.current;
+    SampleType block_attack = attack.current;
+    const SampleType decay_step = decay.step;
+    const SampleType attack_step = attack.step;
+    SampleType envelope = current_envelope_position;
+
+    for (int index = 0; index < numSamples; ++index) {
+        if (Ramping) {
+            // Same order as SmoothedCoefficient::next: step first, then use.
+            block_decay += decay_step;
+            block_attack += attack_step;
+        }
+        envelope = followSample(envelope, trace[index], block_decay, block_attack);
+        trace[index] = envelope;
+    }
+
+    current_envelope_position = envelope;
+}
+
+/**
+ * Runs the state variable bandpass over a downmixed block, in place.
+ *
+ * While neither cutoff is gliding, the filters run at a fixed cutoff and skip the per-sample table lookup.
+ *
+ * Arguments
+ * ---------
+ * SampleType* trace: The downmixed input samples. Overwritten with the filtered samples.
+ * int numSamples: The number of samples.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::processStateVariable(SampleType* trace, int numSamples)
+{
+    if (lowpass_cutoff.remaining == 0 && highpass_cutoff.remaining == 0) {
+        lowStateVariable.setCutoff(lowpass_cutoff.current);
+        highStateVariable.setCutoff(highpass_cutoff.current);
+        for (int index = 0; index < numSamples; ++index) {
+            trace[index] = highStateVariable.processSample(lowStateVariable.processSample(trace[index]).low).high;
+        }
+        return;
+    }
+
+    for (int index = 0; index < numSamples; ++index) {
+        const SampleType low = lowStateVariable.processSample(trace[index], lowpass_cutoff.next()).low;
+        trace[index] = highStateVariable.processSample(low, highpass_cutoff.next()).high;
+    }
+}
+
+/**
+ * Runs the decimated detector, hold and envelope over part of a block.
+ *
+ * Every filtered sample goes into the decimator, but the detector, hold and envelope only run once per group of
+ * decimation samples. The trace holds the envelope from the last complete group, so the CC output reads it
+ * exactly as it would at the full rate.
+ *
+ * The segment is worked through a group at a time. The true-peak and analytic detectors run over the whole segment
+ * first, so each group is pooled by one of two tight loops, chosen once per group: the largest magnitude, or the sum
+ * of squares for the RMS detector. Neither has a branch per sample, and the envelope is only written once per group.
+ *
+ * Ramping selects, at compile time, whether the decay and attack advance by their ramp steps. Only their values on
+ * each group's last sample are used.
+ *
+ * Arguments
+ * ---------
+ * SampleType* trace: The filtered samples for the segment. Overwritten with the envelope, held between detector samples.
+ * int numSamples: The length of the segment.
+ */
+template <typename SampleType>
+template <bool Ramping>
+void SignalProcessor<SampleType>::decimateSegment(SampleType* trace, int numSamples)
+{
+    if (detector_mode == DetectorMode::truePeak) {
+        true_peak.process(trace, numSamples);
+    } else if (detector_mode == DetectorMode::analytic) {
+        analytic.process(trace, numSamples);
+    }
+    const bool mean_square = detector_mode == DetectorMode::rms;
+
+    int position = 0;
+    while (position < numSamples) {
+        // Gather up to the end of the group, or of the segment.
+        const int span = std::min(decimation - decimation_phase, numSamples - position);
+        SampleType* group = trace + position;
+        SampleType pooled = decimation_accumulator;
+        if (mean_square) {
+            for (int index = 0; index < span; ++index) {
+                pooled += group[index] * group[index];
+            }
+        } else {
+            for (int index = 0; index < span; ++index) {
+                pooled = std::max(pooled, (SampleType) fabs(group[index]));
+            }
+        }
+        position += span;
+        decimation_phase += span;
+        decimation_accumulator = pooled;
+
+        if (decimation_phase < decimation) {
+            // The group runs on into the next segment, so the envelope holds.
+            std::fill(group, group + span, current_envelope_position);
+            continue;
+        }
+        decimation_phase = 0;
+        // The held envelope up to the group's last sample, which gets the new one.
+        std::fill(group, group + span - 1, current_envelope_position);
+        // Same values SmoothedCoefficient::next would give on the group's last sample.
+        const SampleType group_decay = Ramping ? decay.current + decay.step * position : decay.current;
+        const SampleType group_attack = Ramping ? attack.current + attack.step * position : attack.current;
+        finishGroup(pooled, group_decay, group_attack);
+        group[span - 1] = current_envelope_position;
+    }
+}
+
+/**
+ * Updates the value of the output MIDI messages given an input audio sample.
+ *
+ * Decays the output value, or moves it towards the input audio value by the attack coefficient if that is larger.
+ *
+ * Arguments
+ * ---------
+ * SampleType sample: The audio sample used to update the output MIDI value.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::updateEnvelopePosition(SampleType sample)
+{
+    // Same order as the block loop: decay first, then attack.
+    const SampleType sample_decay = decay.next();
+    const SampleType sample_attack = attack.next();
+    current_envelope_position = followSample(current_envelope_position, (SampleType) fabs(sample), sample_decay, sample_attack);
 }
 
 /**
@@ -82,12 +659,30 @@ void SignalProcessor::updateEnvelopePosition(float sample)
  * -------
  * int: The next output MIDI value.
  */
-int SignalProcessor::getEnvelopePosition()
+template <typename SampleType>
+int SignalProcessor<SampleType>::getEnvelopePosition()
+{
+    return getEnvelopePosition(current_envelope_position);
+}
+
+/**
+ * Rescales an envelope value, such as one from the trace returned by processBlock, into an output MIDI value.
+ *
+ * Arguments
+ * ---------
+ * SampleType envelope_position: The envelope value to rescale.
+ *
+ * Returns
+ * -------
+ * int: The envelope value rescaled and clamped between the minimum and maximum output bounds.
+ */
+template <typename SampleType>
+int SignalProcessor<SampleType>::getEnvelopePosition(SampleType envelope_position)
 {
     // Before scaling, the envelope position is between 0 and 1, since that's what
     // the audio values are between. TODO: I think?
     // Scales the tentative ouput MIDI value  
-    float scaled_envelope_position = current_envelope_position * (max_val - min_val) + min_val;
+    float scaled_envelope_position = envelope_position * (max_val - min_val) + min_val;
     // The actual minimum output MIDI value given the selected bounds.
     int low_bound = std::min((int)max_val, (int)min_val);
     // The actual maximum output MIDI value given the selected bounds 
@@ -96,6 +691,64 @@ int SignalProcessor::getEnvelopePosition()
     return std::max(std::min((int)scaled_envelope_position, high_bound), low_bound);
 }
 
+/**
+ * Returns whether a lane of an EnvelopeBank, set up with configureBankLane, computes the same envelope this processor would for a single channel.
+ *
+ * The bank runs gain, the one-pole lowpass and highpass, and the peak envelope with an instant attack, all at the full rate.
+ *
+ * Returns
+ * -------
+ * bool: True if the current settings need nothing the bank doesn't have.
+ */
+template <typename SampleType>
+bool SignalProcessor<SampleType>::fitsEnvelopeBank() const
+{
+    return detector_mode == DetectorMode::peak && !state_variable && filter_order <= 1 && attack.target == 0
+        && hold_time <= 0 && lookahead_samples == 0 && detector_rate <= 0;
+}
+
+/**
+ * Copies the gain, cutoffs and recovery time this processor is set to (or gliding to) to one lane of an EnvelopeBank.
+ *
+ * The bank has no glides, so it takes the values the glides are heading for, as the bands do. The lane's coefficients
+ * are rebuilt once, after every setting is in.
+ *
+ * Arguments
+ * ---------
+ * EnvelopeBank<SampleType>& bank: The bank to update.
+ * int lane: The index of the lane.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::configureBankLane(EnvelopeBank<SampleType>& bank, int lane) const
+{
+    // A single channel is all mid and no side, and every other downmix passes it through unscaled.
+    const SampleType input_scale = downmix_mode == DownmixMode::side ? (SampleType) 0 : (SampleType) 1;
+    bank.setLaneSettings(lane, (float) (gain.target * input_scale), (float) lowpass_cutoff.target, (float) highpass_cutoff.target,
+                         std::max(recovery_time, 0.0f));
+}
+
+/**
+ * Rescales an envelope value into an output level, for outputs finer than a 7-bit MIDI value.
+ *
+ * The same rescaling and clamping as getEnvelopePosition, but without rounding, so each output can quantize it to its own resolution.
+ *
+ * Arguments
+ * ---------
+ * SampleType envelope_position: The envelope value to rescale.
+ *
+ * Returns
+ * -------
+ * double: The envelope value rescaled and clamped between the minimum and maximum output bounds, divided by 127 to lie between 0 and 1.
+ */
+template <typename SampleType>
+double SignalProcessor<SampleType>::getEnvelopeLevel(SampleType envelope_position)
+{
+    const double scaled_envelope_position = envelope_position * (double) (max_val - min_val) + min_val;
+    const double low_bound = std::min(min_val, max_val);
+    const double high_bound = std::max(min_val, max_val);
+    return std::max(std::min(scaled_envelope_position, high_bound), low_bound) / 127.0;
+}
+
 /**
  * Sets the minimum output MIDI value.
  *
@@ -103,7 +756,8 @@ int SignalProcessor::getEnvelopePosition()
  * ---------
  * float min: The new minimum output MIDI value.
  */
-void SignalProcessor::setMinValue(float new_min)
+template <typename SampleType>
+void SignalProcessor<SampleType>::setMinValue(float new_min)
 {
     // Update the relevant private parameter.
     min_val = new_min;
@@ -116,7 +770,8 @@ void SignalProcessor::setMinValue(float new_min)
  * ---------
  * float max: The new maximum output MIDI value.
  */
-void SignalProcessor::setMaxValue(float new_max)
+template <typename SampleType>
+void SignalProcessor<SampleType>::setMaxValue(float new_max)
 {
     // Update the relevant private parameter.
     max_val = new_max;
@@ -129,10 +784,11 @@ void SignalProcessor::setMaxValue(float new_max)
  * ---------
  * float min: The new scaling factor.
  */
-void SignalProcessor::setGainValue(float new_gain)
+template <typename SampleType>
+void SignalProcessor<SampleType>::setGainValue(float new_gain)
 {
-    // Update the relevant private parameter.
-    gain = new_gain;
+    // Glide to the new scaling factor.
+    gain.set_target((SampleType) new_gain, smoothing_length);
 }
 
 /**
@@ -144,10 +800,15 @@ void SignalProcessor::setGainValue(float new_gain)
  * ---------
  * float lp_val: The new cutoff threshold for the internal lowpass filter.
  */
-void SignalProcessor::setLowpassValue(float lp_val)
+template <typename SampleType>
+void SignalProcessor<SampleType>::setLowpassValue(float lp_val)
 {
     // Update the cutoff frequency threshold of the internal lowpass filter.
     lowFilter.set_cutoff_frequency(lp_val);
+    cascade.setLowpass(lp_val);
+    lowpass_cutoff.set_target((SampleType) lp_val, smoothing_length);
+    // The bands span the cutoffs.
+    updateBands();
 }
 
 /**
@@ -159,10 +820,15 @@ void SignalProcessor::setLowpassValue(float lp_val)
  * ---------
  * float hp_val: The new cutoff threshold for the internal highpass filter.
  */
-void SignalProcessor::setHighpassValue(float hp_val)
+template <typename SampleType>
+void SignalProcessor<SampleType>::setHighpassValue(float hp_val)
 {
     // Update the cutoff frequency threshold of the internal highpass filter.
     highFilter.set_cutoff_frequency(hp_val);
+    cascade.setHighpass(hp_val);
+    highpass_cutoff.set_target((SampleType) hp_val, smoothing_length);
+    // The bands span the cutoffs.
+    updateBands();
 }
 
 /**
@@ -172,9 +838,10 @@ void SignalProcessor::setHighpassValue(float hp_val)
  *
  * Arguments
  * ---------
- * float recovery_time: The amount of time the envelope should take to decay to half of its value given lesser input samples in seconds.
+ * float new_recovery_time: The amount of time the envelope should take to decay to half of its value given lesser input samples in seconds.
  */
-void SignalProcessor::setRecoveryTimeValue(float recovery_time)
+template <typename SampleType>
+void SignalProcessor<SampleType>::setRecoveryTimeValue(float new_recovery_time)
 {
     // The recovery time is how long it takes the envelope to decay to half
     // of its original value, and is calculated as such:
@@ -182,14 +849,50 @@ void SignalProcessor::setRecoveryTimeValue(float recovery_time)
     // num_samples * log2(decay) = log2(0.5) = -1
     // decay = 2 ^ (-1 / num_samples)
     
+    // Skip the pow() if nothing changed.
+    if (new_recovery_time == recovery_time) {
+        return;
+    }
+    recovery_time = new_recovery_time;
+
     // If the recovery time is 0, there is effectively no envelope, so we set
     // a lower bound for the recovery time. This lower bound is 1 millisecond.
-    recovery_time = fmax(recovery_time, 0.001);
+    float bounded_recovery_time = fmax(recovery_time, 0.001);
     
-    // The number of samples that this component should expect per recovery_time interval.
-    float num_samples = recovery_time * sampling_frequency;
-    // Update the decay scaling constant.
-    decay = pow(2, (-1 / num_samples));
+    // The number of samples that this component should expect per recovery_time interval, at the filter rate the decay runs at.
+    float num_samples = bounded_recovery_time * getFilterSamplingFrequency();
+    // Glide to the new decay scaling constant.
+    decay.set_target((SampleType) pow(2, (-1 / num_samples)), smoothing_length);
+    // The bands share the recovery time.
+    updateBands();
+}
+
+/**
+ * Sets the amount of time the envelope takes to rise halfway to a louder input.
+ *
+ * Uses the same half-life definition as setRecoveryTimeValue, so attack and release are set in the same units.
+ *
+ * Arguments
+ * ---------
+ * float new_attack_time: The attack half-life in seconds. 0 makes the envelope jump straight to louder input.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::setAttackTimeValue(float new_attack_time)
+{
+    // Skip the pow() if nothing changed.
+    if (new_attack_time == attack_time) {
+        return;
+    }
+    attack_time = new_attack_time;
+
+    // attack ^ num_samples = 0.5, as for the decay. No attack time means no smoothing at all.
+    SampleType coefficient = 0;
+    if (attack_time > 0) {
+        double num_samples = attack_time * getFilterSamplingFrequency();
+        coefficient = (SampleType) pow(2, (-1 / num_samples));
+    }
+    // Glide to the new attack coefficient.
+    attack.set_target(coefficient, smoothing_length);
 }
 
 /**
@@ -199,11 +902,445 @@ void SignalProcessor::setRecoveryTimeValue(float recovery_time)
  * ---------
  * double freq: The new number of input audio samples this component should expect per second of audio input.
  */
-void SignalProcessor::setSamplingFrequency(double freq)
+template <typename SampleType>
+void SignalProcessor<SampleType>::setSamplingFrequency(double freq)
 {
     // Update the cached sampling frequency.
     sampling_frequency = freq;
+    // The bands always run at the full rate.
+    bands.setSamplingFrequency(freq);
+    // Allocate the RMS history for the longest window at this sampling frequency. This also covers any decimated rate.
+    rms.prepare((int) ceil(max_rms_window_time * freq));
+    // Likewise for the hold deque.
+    hold.prepare((int) ceil(max_hold_time * freq));
+    // The lookahead is a whole number of samples, so it changes with the sampling frequency. The window includes the current sample.
+    lookahead_samples = (int) lround(lookahead_time * freq);
+    lookahead.prepare((int) ceil(max_lookahead_time * freq) + 1);
+    audio_delay.prepare(num_delay_channels, (int) ceil(max_lookahead_time * freq));
+    audio_delay.setDelay(lookahead_samples);
+    // The decimation factors depend on the sampling frequency. This also sets the RMS and hold window lengths,
+    // and, since no front end matches 0, always rebuilds the filters for the new filter rate.
+    const float previous_detector_rate = detector_rate;
+    detector_rate = -1;
+    front_decimation = 0;
+    setDetectorRate(previous_detector_rate);
+}
+
+/**
+ * Rebuilds everything that counts in filter-rate samples for the current filter rate: the glide length, the filters,
+ * the decay and the attack. The filters start from silence, and nothing glides from the old values.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::updateFilterRate()
+{
+    const double filter_frequency = getFilterSamplingFrequency();
+    // The glide length in samples depends on the filter rate.
+    setSmoothingTime(smoothing_time);
     // Update the sampling frequencies for the internal lowpass and highpass filters.
-    lowFilter.set_sampling_frequency(freq);
-    highFilter.set_sampling_frequency(freq);
+    lowFilter.set_sampling_frequency(filter_frequency);
+    highFilter.set_sampling_frequency(filter_frequency);
+    lowFilter.prev_input = lowFilter.prev_output = 0;
+    highFilter.prev_input = highFilter.prev_output = 0;
+    cascade.setSamplingFrequency(filter_frequency);
+    cascade.reset();
+    lowStateVariable.setSamplingFrequency(filter_frequency);
+    highStateVariable.setSamplingFrequency(filter_frequency);
+    lowStateVariable.reset();
+    highStateVariable.reset();
+    lowpass_cutoff.set_target(lowpass_cutoff.target, 0);
+    highpass_cutoff.set_target(highpass_cutoff.target, 0);
+    // The decay is per sample, so it has to be rebuilt for the new filter rate.
+    if (recovery_time >= 0) {
+        float previous_recovery_time = recovery_time;
+        recovery_time = -1;
+        setRecoveryTimeValue(previous_recovery_time);
+        // A new rate means a new stream, so there is nothing to glide from.
+        decay.set_target(decay.target, 0);
+    }
+    // Likewise for the attack.
+    if (attack_time >= 0) {
+        float previous_attack_time = attack_time;
+        attack_time = -1;
+        setAttackTimeValue(previous_attack_time);
+        attack.set_target(attack.target, 0);
+    }
+    gain.set_target(gain.target, 0);
+}
+
+/**
+ * Preallocates the envelope trace returned by processBlock.
+ *
+ * Should be called from prepareToPlay so that no memory is allocated while processing audio.
+ *
+ * Arguments
+ * ---------
+ * int max_block_size: The largest number of samples processBlock is expected to receive at once.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::setMaximumBlockSize(int max_block_size)
+{
+    envelope_trace.assign(std::max(max_block_size, 0), (SampleType) 0);
+    downmix_power.assign(std::max(max_block_size, 0), (SampleType) 0);
+    prepareBands(max_block_size);
+}
+
+/**
+ * Sets how long changes to the gain, cutoff frequencies and recovery time take to glide to their new values.
+ *
+ * The gliding is done on the already computed coefficients, so it costs additions rather than
+ * transcendental calls per sample, and removes the zipper noise of block-wise parameter jumps.
+ *
+ * Arguments
+ * ---------
+ * float new_smoothing_time: The glide time in seconds. 0 makes changes take effect immediately.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::setSmoothingTime(float new_smoothing_time)
+{
+    smoothing_time = fmax(new_smoothing_time, 0.0);
+    smoothing_length = (int) (smoothing_time * getFilterSamplingFrequency());
+    lowFilter.set_smoothing_length(smoothing_length);
+    highFilter.set_smoothing_length(smoothing_length);
+    cascade.setSmoothingLength(smoothing_length);
+}
+
+/**
+ * Sets the order of the lowpass and highpass filtering.
+ *
+ * Order 1 uses the one-pole lowFilter and highFilter (6 dB/octave). Orders 2, 4 and 8 use the biquad cascade
+ * (12, 24 and 48 dB/octave on each side). Switching orders resets the cascade.
+ *
+ * Arguments
+ * ---------
+ * int order: 1, 2, 4 or 8.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::setFilterOrder(int order)
+{
+    if (order == filter_order) {
+        return;
+    }
+    filter_order = order;
+    if (filter_order > 1) {
+        // Start the cascade from silence rather than from whatever it held when it was last used.
+        cascade.setOrder(filter_order);
+        cascade.reset();
+    }
+}
+
+/**
+ * Selects the alignment of the biquad cascade. Has no effect at filter order 1.
+ *
+ * Arguments
+ * ---------
+ * typename BiquadCascade<SampleType>::Alignment alignment: Butterworth or Linkwitz-Riley.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::setFilterAlignment(typename BiquadCascade<SampleType>::Alignment alignment)
+{
+    cascade.setAlignment(alignment);
+}
+
+/**
+ * Selects the zero-delay-feedback state variable filters instead of the one-pole filters or the cascade.
+ *
+ * Arguments
+ * ---------
+ * bool enabled: True for the state variable filters, False for the one-pole filters or cascade selected by setFilterOrder.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::setStateVariableMode(bool enabled)
+{
+    if (enabled == state_variable) {
+        return;
+    }
+    state_variable = enabled;
+    if (state_variable) {
+        // Start from silence rather than from whatever the filters held when they were last used.
+        lowStateVariable.reset();
+        highStateVariable.reset();
+    }
+}
+
+/**
+ * Selects the peak, RMS, true-peak or analytic detector.
+ *
+ * Arguments
+ * ---------
+ * DetectorMode mode: The new detector.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::setDetectorMode(DetectorMode mode)
+{
+    if (mode == detector_mode) {
+        return;
+    }
+    detector_mode = mode;
+    if (detector_mode == DetectorMode::rms) {
+        // Start the window from silence rather than from whatever it held when it was last used.
+        rms.reset();
+    }
+    if (detector_mode == DetectorMode::truePeak) {
+        // Likewise start the interpolator from silence.
+        true_peak.reset();
+    }
+    if (detector_mode == DetectorMode::analytic) {
+        // And the allpass chains.
+        analytic.reset();
+    }
+}
+
+/**
+ * Sets the length of the RMS detector window.
+ *
+ * Arguments
+ * ---------
+ * float window_time: The window length in seconds. Clamped to between one sample and max_rms_window_time.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::setRmsWindowTime(float window_time)
+{
+    rms_window_time = std::min(std::max(window_time, 0.0f), max_rms_window_time);
+    rms.setWindowLength(std::max((int) (rms_window_time * getDetectorSamplingFrequency()), 1));
+}
+
+/**
+ * Sets how long the envelope holds a peak before it starts to decay.
+ *
+ * Arguments
+ * ---------
+ * float new_hold_time: The hold in seconds. 0 disables the hold stage. Clamped to max_hold_time.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::setHoldTime(float new_hold_time)
+{
+    const bool was_holding = hold_time > 0;
+    hold_time = std::min(std::max(new_hold_time, 0.0f), max_hold_time);
+    hold.setWindowLength(std::max((int) (hold_time * getDetectorSamplingFrequency()), 1));
+    if (!was_holding) {
+        // Don't hold peaks from before the stage was enabled.
+        hold.reset();
+    }
+}
+
+/**
+ * Sets the rate the detector, hold and envelope run at.
+ *
+ * Above 88.2 kHz the front end first averages whole groups of input samples down to 44.1 or 48 kHz, the filter rate.
+ * The decimation factor is then the filter rate divided by the rate, rounded to a whole number of samples.
+ *
+ * Arguments
+ * ---------
+ * float rate: The detector rate in Hz. 0 runs the detector at the sampling frequency.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::setDetectorRate(float rate)
+{
+    if (rate == detector_rate) {
+        return;
+    }
+    detector_rate = std::max(rate, 0.0f);
+    // Above 88.2 kHz the front end brings the signal down to 44.1 or 48 kHz, which is still above twice the highest cutoff.
+    const int new_front_decimation = detector_rate > 0 ? std::max((int) (sampling_frequency / 44100), 1) : 1;
+    const int new_decimation = detector_rate > 0 ? std::max((int) lround(sampling_frequency / new_front_decimation / detector_rate), 1) : 1;
+    const bool front_changed = new_front_decimation != front_decimation;
+    const bool changed = front_changed || new_decimation != decimation;
+    front_decimation = new_front_decimation;
+    decimation = new_decimation;
+    if (front_changed) {
+        // The filters, glides, decay and attack all count in filter-rate samples.
+        updateFilterRate();
+        front_phase = 0;
+        front_accumulator = 0;
+    }
+
+    // The windows are counted in detector samples, so they change length with the decimation.
+    rms.setWindowLength(std::max((int) (rms_window_time * getDetectorSamplingFrequency()), 1));
+    hold.setWindowLength(std::max((int) (hold_time * getDetectorSamplingFrequency()), 1));
+    updateLookaheadWindow();
+    if (changed) {
+        // The history was gathered at the old rate, so start again from silence.
+        rms.reset();
+        hold.reset();
+        lookahead.reset();
+        decimation_phase = 0;
+        decimation_accumulator = 0;
+        control_decay_source = -1;
+        control_attack_source = -1;
+    }
+}
+
+/**
+ * Selects how processBlock combines the input channels into one signal.
+ *
+ * Arguments
+ * ---------
+ * DownmixMode mode: The new downmix.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::setDownmixMode(DownmixMode mode)
+{
+    downmix_mode = mode;
+}
+
+/**
+ * Sets how far ahead of the audio the envelope looks for peaks.
+ *
+ * Arguments
+ * ---------
+ * float new_lookahead_time: The lookahead in seconds. 0 disables it. Clamped to max_lookahead_time.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::setLookaheadTime(float new_lookahead_time)
+{
+    const bool was_looking_ahead = lookahead_samples > 0;
+    lookahead_time = std::min(std::max(new_lookahead_time, 0.0f), max_lookahead_time);
+    lookahead_samples = (int) lround(lookahead_time * sampling_frequency);
+    updateLookaheadWindow();
+    audio_delay.setDelay(lookahead_samples);
+    if (!was_looking_ahead) {
+        // Don't bring forward peaks from before the stage was enabled.
+        lookahead.reset();
+    }
+}
+
+/**
+ * Allocates the audio delay for the given number of channels.
+ *
+ * Arguments
+ * ---------
+ * int num_channels: The most channels delayBlock will be given.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::setNumChannels(int num_channels)
+{
+    num_delay_channels = std::max(num_channels, 0);
+    audio_delay.prepare(num_delay_channels, (int) ceil(max_lookahead_time * sampling_frequency));
+    audio_delay.setDelay(lookahead_samples);
+}
+
+/**
+ * Delays a block of audio in place by the lookahead. Does nothing while the lookahead is 0.
+ *
+ * Arguments
+ * ---------
+ * SampleType* const* channels: One write pointer per channel. Overwritten with the delayed audio.
+ * int numChannels: The number of channels.
+ * int numSamples: The number of samples in each channel.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::delayBlock(SampleType* const* channels, int numChannels, int numSamples)
+{
+    audio_delay.process(channels, numChannels, numSamples);
+}
+
+/**
+ * Sets the lookahead window in detector samples, so it covers lookahead_samples at the full rate.
+ *
+ * The window includes the current sample, so a lookahead of n samples is a window of n + 1.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::updateLookaheadWindow()
+{
+    lookahead.setWindowLength(lookahead_samples / (front_decimation * decimation) + 1);
 }
+
+/**
+ * Sets how many bands the multiband mode splits the input into.
+ *
+ * Arguments
+ * ---------
+ * int count: The number of bands. Clamped to max_bands. 0 disables the multiband mode.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::setNumBands(int count)
+{
+    count = std::min(std::max(count, 0), max_bands);
+    if (count == num_bands) {
+        return;
+    }
+    num_bands = count;
+    bands.setActiveLanes(num_bands);
+    updateBands();
+}
+
+/**
+ * Returns one band's envelope after a given sample of the last processed block, rescaled into a MIDI value.
+ *
+ * Arguments
+ * ---------
+ * int band: The index of the band, from lowest to highest.
+ * int index: The index of the sample within the last block.
+ *
+ * Returns
+ * -------
+ * int: The band envelope rescaled and clamped between the minimum and maximum output bounds.
+ */
+template <typename SampleType>
+int SignalProcessor<SampleType>::getBandEnvelopePosition(int band, int index)
+{
+    return getEnvelopePosition(bands.getEnvelopeTrace(band, index));
+}
+
+/**
+ * Returns one band's envelope after a given sample of the last processed block, rescaled into an output level.
+ *
+ * Arguments
+ * ---------
+ * int band: The index of the band, from lowest to highest.
+ * int index: The index of the sample within the last block.
+ *
+ * Returns
+ * -------
+ * double: The band envelope rescaled and clamped between the minimum and maximum output bounds, between 0 and 1.
+ */
+template <typename SampleType>
+double SignalProcessor<SampleType>::getBandEnvelopeLevel(int band, int index)
+{
+    return getEnvelopeLevel(bands.getEnvelopeTrace(band, index));
+}
+
+/**
+ * Allocates the band bank for max_bands lanes and blocks of up to the given size, and reapplies its settings.
+ *
+ * Arguments
+ * ---------
+ * int max_block_size: The largest number of samples processBlock is expected to receive at once.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::prepareBands(int max_block_size)
+{
+    // prepare resets every lane, so put the band edges, recovery time and active lanes back.
+    bands.prepare(max_bands, max_block_size);
+    bands.setActiveLanes(num_bands);
+    updateBands();
+}
+
+/**
+ * Spreads the bands evenly in log frequency between the highpass and lowpass cutoffs, and copies the recovery time to them.
+ *
+ * Each band is a fourth-order constant-Q bandpass that is 3 dB down at its edges, so neighbouring bands cross
+ * where they meet, and every band has the same width in octaves.
+ */
+template <typename SampleType>
+void SignalProcessor<SampleType>::updateBands()
+{
+    if (num_bands == 0 || bands.getNumLanes() == 0) {
+        return;
+    }
+    // Log spacing needs a positive lower edge, so start no lower than 20 Hz.
+    const double lowest = std::max((double) highpass_cutoff.target, 20.0);
+    const double highest = std::max((double) lowpass_cutoff.target, lowest);
+    const double ratio = pow(highest / lowest, 1.0 / num_bands);
+    double lower_edge = lowest;
+    for (int band = 0; band < num_bands; ++band) {
+        const double upper_edge = lower_edge * ratio;
+        bands.setLaneBandpass(band, (float) lower_edge, (float) upper_edge);
+        bands.setLaneRecoveryTime(band, std::max(recovery_time, 0.0f));
+        lower_edge = upper_edge;
+    }
+}
+
+// The plugin uses both precisions, depending on what the host asks for.
+template class SignalProcessor<float>;
+template class SignalProcessor<double>;
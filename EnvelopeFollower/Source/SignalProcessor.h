@@ -13,6 +13,13 @@
     Dependencies:
     - algorithm
     - math.h
+    - vector
+    - BiquadCascade.h
+    - StateVariableFilter.h
+    - SlidingRms.h
+    - SlidingMaximum.h
+    - EnvelopeBank.h
+    - DelayLine.h
 
   ==============================================================================
 */
@@ -23,37 +30,158 @@
 // Import the dependencies for the contents of this file.
 #include <algorithm> // Imports the c++ stdlib algorithm libarary.
 #include <math.h> // Imports the basic c stdlib math library
+#include <vector> // Imports the c++ stdlib vector container used for the per-block envelope trace.
+#include "BiquadCascade.h" // Import the steeper second-order filter cascade used when the filter order is above 1.
+#include "StateVariableFilter.h" // Import the zero-delay-feedback filter used when the cutoffs are swept every sample.
+#include "SlidingRms.h" // Import the running RMS used by the RMS detector.
+#include "SlidingMaximum.h" // Import the sliding maximum used by the hold stage.
+#include "EnvelopeBank.h" // Import the multi-lane envelope kernel used for the multiband envelopes.
+#include "DelayLine.h" // Import the delay that holds the audio back by the lookahead.
+#include "TruePeakDetector.h" // Import the 4x interpolating rectifier used by the true-peak detector.
+#include "HilbertEnvelope.h" // Import the allpass-pair analytic signal used by the analytic detector.
+
+// Forward declaration so Filter can befriend every SignalProcessor instantiation.
+template <typename SampleType> class SignalProcessor;
+
+/**
+ * A coefficient that moves linearly to a new value over a fixed number of samples instead of jumping.
+ * 
+ * Used to smooth automation of the gain, decay and filter coefficients without zipper noise.
+ * Templated on the sample type (float or double) of the processor that owns it.
+ * 
+ * Attributes
+ * ----------
+ * public SampleType current: The value to use for the current sample.
+ * public SampleType target: The value being moved towards.
+ * public SampleType step: The amount current changes by per sample while ramping.
+ * public int remaining: The number of samples left in the ramp. 0 when current == target.
+ * 
+ * Methods
+ * -------
+ * public void set_target(SampleType new_target, int ramp_length): Starts a ramp from the current value to a new one.
+ * public SampleType next(): Returns the value for the next sample and advances the ramp.
+ * public void skip(int num_samples): Advances the ramp by several samples at once.
+ * 
+ * Owned by
+ * - Filter
+ * - SignalProcessor
+ */
+template <typename SampleType>
+struct SmoothedCoefficient {
+    /**
+     * Starts a ramp from the current value to a new one.
+     * 
+     * Arguments
+     * ---------
+     * SampleType new_target: The value to move to.
+     * int ramp_length: The number of samples to take getting there. 0 jumps straight to the new value.
+     */
+    void set_target(SampleType new_target, int ramp_length) {
+        target = new_target;
+        if (ramp_length <= 0) {
+            current = target;
+            step = 0;
+            remaining = 0;
+        } else {
+            step = (target - current) / ramp_length;
+            remaining = ramp_length;
+        }
+    };
+
+    /**
+     * Returns the value for the next sample and advances the ramp by one sample.
+     * 
+     * Returns
+     * -------
+     * SampleType: The value to use for the next sample.
+     */
+    SampleType next() {
+        if (remaining > 0) {
+            skip(1);
+        }
+        return current;
+    };
+
+    /**
+     * Advances the ramp by several samples at once. Lands exactly on the target when the ramp ends.
+     * 
+     * Arguments
+     * ---------
+     * int num_samples: The number of samples to advance by.
+     */
+    void skip(int num_samples) {
+        if (num_samples >= remaining) {
+            current = target;
+            step = 0;
+            remaining = 0;
+        } else {
+            current += step * num_samples;
+            remaining -= num_samples;
+        }
+    };
+
+    /// <summary>
+    ///     The value to use for the current sample.
+    /// </summary>
+    SampleType current = 0;
+    /// <summary>
+    ///     The value being moved towards.
+    /// </summary>
+    SampleType target = 0;
+    /// <summary>
+    ///     The amount current changes by per sample while ramping.
+    /// </summary>
+    SampleType step = 0;
+    /// <summary>
+    ///     The number of samples left in the ramp.
+    /// </summary>
+    int remaining = 0;
+};
 
 /**
- * A biquad lowpass and highpass filter.
+ * A first-order (one-pole) lowpass and highpass filter, with a 6 dB/octave slope.
+ * 
+ * Used by SignalProcessor when the filter order is 1. Steeper slopes are handled by BiquadCascade,
+ * and cutoffs that move every sample by StateVariableFilter.
  * 
  * Functionality is based off of the equations in
  * - https://www.st.com/resource/en/application_note/an2874-bqd-filter-design-equations-stmicroelectronics.pdf
  * - https://en.wikipedia.org/wiki/Digital_biquad_filter
  * 
+ * Templated on the sample type (float or double). The filter state and coefficients are stored as SampleType,
+ * while the cutoff and sampling frequencies and the intermediate design values are always double.
  * 
  * Attributes
  * ----------
  * private const double pi: An approximation of the irrational consant pi used for calculating the filter coefficients.
- * private double prev_input: The previous input audio sample value. Defaults to 0 before input.
- * private double prev_output: The previous output audio sample value. Defaults to 0 before input.
+ * private SampleType prev_input: The previous input audio sample value. Defaults to 0 before input.
+ * private SampleType prev_output: The previous output audio sample value. Defaults to 0 before input.
  * private double cutoff_frequency: The audio frequency used as the cutoff threshold by the lowpass and highpass filter calculations.
  * private double sampling_frequency: The number of audio samples this filter should expect per second of audio input.
  * private double theta_c: An angle used to calculate the other filter coefficients.
  * private double k: Part of a scaling factor applied to the previous output value during filter calculations.
  * private double alpha: A divisor used to scale all input values for the filter calculations.
+ * private SmoothedCoefficient lp_b: The input coefficient used by calculate_lpf. Glides to k / alpha.
+ * private SmoothedCoefficient hp_b: The input coefficient used by calculate_hpf. Glides to 1 / alpha.
+ * private SmoothedCoefficient feedback: The previous-output coefficient used by both. Glides to (1 - k) / alpha.
+ * private int smoothing_length: The number of samples the coefficients take to reach their new values.
  * 
  * Methods
  * -------
  * public void set_sampling_frequency(double new_freq): Sets the number of audio samples this filter should expect per second of audio input.
  * public void set_cutoff_frequency(double new_freq): Sets the audio frequency used as the cutoff threshold by the lowpass and highpass filter calculations.
- * public double calculate_lpf(double new_sample): Calculates and returns the next output value as a lowpass filter.
- * public double calculate_hpf(double new_sample): Calculates and returns the next output value as a highpass filter.
+ * public SampleType calculate_lpf(SampleType new_sample): Calculates and returns the next output value as a lowpass filter.
+ * public SampleType calculate_hpf(SampleType new_sample): Calculates and returns the next output value as a highpass filter.
+ * public void set_smoothing_length(int num_samples): Sets how many samples the coefficients take to glide to new values.
  * public void calc_coeff(): Updates the coefficients used for the lowpass and highpass filter calculations.
  * 
+ * Friends
+ * - SignalProcessor (reads the coefficients and state directly in its fused block loop)
+ * 
  * Owned by
  * - SignalProcessor
  */
+template <typename SampleType>
 struct Filter {
     /**
      * Sets the number of input samples this filer expects to receive per second of audio stream.
@@ -67,6 +195,10 @@ struct Filter {
         sampling_frequency = new_freq;
         // Updates the coefficients used by the filter.
         calc_coeff();
+        // A new sampling frequency means a new stream, so there is nothing to glide from.
+        lp_b.set_target(lp_b.target, 0);
+        hp_b.set_target(hp_b.target, 0);
+        feedback.set_target(feedback.target, 0);
     };
 
     /**
@@ -79,6 +211,10 @@ struct Filter {
      * double new freq: The new cutoff frequency threshold for this filter.
      */
     void set_cutoff_frequency(double new_freq) {
+        // Skip the tan() in calc_coeff if nothing changed.
+        if (new_freq == cutoff_frequency) {
+            return;
+        }
         // Sets the cutoff frequency threshold for this filter.
         cutoff_frequency = new_freq;
         // Updates the coefficients used by the filter.
@@ -90,24 +226,20 @@ struct Filter {
      * 
      * Arguments
      * ---------
-     * double new_sample: The next input value.
+     * SampleType new_sample: The next input value.
      * 
      * Returns
      * -------
-     * double: The next output value for a high pass filter. 
-     */
-    double calculate_lpf(double new_sample) {
-        // The inverse scaling coefficient for the new output value.
-        double a0 = 1.0;
-        // The scaling coefficient for the previous output value.
-        double a1 = -(1.0 - k) / alpha;
-        // The scaling coefficent for the new input value.
-        double b0 = k / alpha;
-        // The scaling coefficient for the prevous input value.
-        double b1 = k / alpha;
+     * SampleType: The next output value for a high pass filter. 
+     */
+    SampleType calculate_lpf(SampleType new_sample) {
+        // The scaling coefficient for the new and previous input values, (k / alpha).
+        SampleType b = lp_b.next();
+        // The scaling coefficient for the previous output value, (1 - k) / alpha.
+        SampleType a = feedback.next();
 
         // The new output value.
-        double output = (1 / a0) * (b0 * new_sample + b1 * prev_input - a1 * prev_output);
+        SampleType output = b * (new_sample + prev_input) + a * prev_output;
         prev_input = new_sample; // Update the previous input and output values.
         prev_output = output;
         return output; // Return the new output value.
@@ -118,29 +250,36 @@ struct Filter {
      * 
      * Arguments
      * ---------
-     * double new_sample: The next input value.
+     * SampleType new_sample: The next input value.
      * 
      * Returns
      * -------
-     * double: The next output value for a low pass filter. 
-     */
-    double calculate_hpf(double new_sample) {
-        // The inverse scaling coefficient for the new output value.
-        double a0 = 1.0;
-        // The scaling coefficient for the previous output value.
-        double a1 = -(1.0 - k) / alpha;
-        // The scaling coefficent for the new input value.
-        double b0 = 1.0 / alpha;
-        // The scaling coefficient for the prevous input value.
-        double b1 = -1.0 / alpha;
+     * SampleType: The next output value for a low pass filter. 
+     */
+    SampleType calculate_hpf(SampleType new_sample) {
+        // The scaling coefficient for the new and previous input values, 1 / alpha.
+        SampleType b = hp_b.next();
+        // The scaling coefficient for the previous output value, (1 - k) / alpha.
+        SampleType a = feedback.next();
 
         // The new output value.
-        double output = (1 / a0) * (b0 * new_sample + b1 * prev_input - a1 * prev_output);
+        SampleType output = b * (new_sample - prev_input) + a * prev_output;
         prev_input = new_sample; // Update the previous input and output values.
         prev_output = output;
         return output; // Return the new output value.
     }
 
+    /**
+     * Sets how many samples the coefficients take to glide to their new values after the cutoff changes.
+     * 
+     * Arguments
+     * ---------
+     * int num_samples: The length of the coefficient ramp. 0 makes changes take effect immediately.
+     */
+    void set_smoothing_length(int num_samples) {
+        smoothing_length = num_samples;
+    };
+
     /**
      * Updates the coefficients used to calculate the output values.
      */
@@ -149,9 +288,18 @@ struct Filter {
         theta_c = 2.0 * pi * cutoff_frequency / sampling_frequency;
         k = tan(theta_c / 2.0);
         alpha = 1 + k;
+        // Glide the coefficients actually used by calculate_lpf and calculate_hpf towards the new ones.
+        // Interpolating in the coefficient domain means no tan() per sample during the glide.
+        lp_b.set_target((SampleType) (k / alpha), smoothing_length);
+        hp_b.set_target((SampleType) (1.0 / alpha), smoothing_length);
+        feedback.set_target((SampleType) ((1.0 - k) / alpha), smoothing_length);
     };
     
 private:
+    // SignalProcessor::processBlock hoists the coefficients and filter state into locals.
+    template <typename> friend class SignalProcessor;
+
+
     /// <summary>
     ///     An approximation of the pi constant for usage in calculations.
     /// </summary>
@@ -160,11 +308,11 @@ private:
     /// <summary>
     ///     The previous input audio sample value.
     /// </summary>
-    double prev_input = 0;
+    SampleType prev_input = 0;
     /// <summary>
     ///     The previous output audio sample value.
     /// </summary>
-    double prev_output = 0;
+    SampleType prev_output = 0;
 
     /// <summary>
     ///     The minimum or maximum allowed frequency depending on whether this is being used as a lowpass or highpass filter.
@@ -188,47 +336,196 @@ private:
     ///     A divisor used to rescale input values when calculating the succeeding output value.
     /// </summary>
     double alpha = 0;
+
+    /// <summary>
+    ///     The scaling coefficient for the input values of the lowpass filter, k / alpha.
+    /// </summary>
+    SmoothedCoefficient<SampleType> lp_b;
+    /// <summary>
+    ///     The scaling coefficient for the input values of the highpass filter, 1 / alpha.
+    /// </summary>
+    SmoothedCoefficient<SampleType> hp_b;
+    /// <summary>
+    ///     The scaling coefficient for the previous output value of either filter, (1 - k) / alpha.
+    /// </summary>
+    SmoothedCoefficient<SampleType> feedback;
+    /// <summary>
+    ///     The number of samples the coefficients take to reach their new values after a cutoff change.
+    /// </summary>
+    int smoothing_length = 0;
 };
 
 /**
  * The component of the plugin responsible for deriving the values of the MIDI envelope from an input audio stream.
  * 
+ * Templated on the sample type, so that single precision hosts get a float pipeline and double precision hosts
+ * get a double pipeline without any conversions in between. Both are explicitly instantiated in SignalProcessor.cpp.
+ * 
  * Attributes
  * ----------
- * private float current_envelope_position: The current value of the waveform envelope normalized to between 0 and 1.
+ * private SampleType current_envelope_position: The current value of the waveform envelope normalized to between 0 and 1.
  * private float min_val: The minimum output MIDI value.
  * private float max_val: The maximum output MIDI value.
- * private float gain: A scaling factor applied to input audio samples.
+ * private SmoothedCoefficient gain: A scaling factor applied to input audio samples. Glides to new values.
  * private float sampling_frequency: The number of input audio samples the component expects to receive per second of audio.
- * private float decay: A scaling factory applied to the current_envelope_position whenever it's updated to make it decay over time.
+ * private SmoothedCoefficient decay: A scaling factory applied to the current_envelope_position whenever it's updated to make it decay over time. Glides to new values.
+ * private float smoothing_time: The amount of time in seconds the gain, decay and filter coefficients take to glide to new values.
+ * private int smoothing_length: smoothing_time in filter-rate samples.
+ * private float recovery_time: The half-life of the envelope in seconds. Kept so decay can be rebuilt when the sampling frequency changes.
+ * private SmoothedCoefficient attack: How much of the gap to a louder input the envelope keeps each sample. 0 for an instant attack. Glides to new values.
+ * private float attack_time: The attack half-life in seconds. Kept so attack can be rebuilt when the sampling frequency changes.
  * private const int MIN_MIDI_VAL: The absolute minimum MIDI output value possible.
  * private const int MAX_MIDI_VAL: The absolute maximum MIDI output value possible.
  * private Filter lowFilter: A lowpass filter used to process input audio samples and filter out high frequencies.
  * private Filter highFilter: A highpass filter used to process input audio samples and filter out low frequencies.
+ * private int filter_order: The order of the lowpass and highpass filtering. 1 uses lowFilter and highFilter, 2, 4 and 8 use cascade.
+ * private BiquadCascade cascade: The Butterworth or Linkwitz-Riley bandpass used when filter_order is above 1.
+ * private bool state_variable: Whether the state variable filters replace both the one-pole filters and the cascade.
+ * private StateVariableFilter lowStateVariable: The lowpass half of the state variable bandpass.
+ * private StateVariableFilter highStateVariable: The highpass half of the state variable bandpass.
+ * private SmoothedCoefficient lowpass_cutoff: The lowpass cutoff in Hz, gliding per sample, for the state variable filters.
+ * private SmoothedCoefficient highpass_cutoff: The highpass cutoff in Hz, gliding per sample, for the state variable filters.
+ * private DetectorMode detector_mode: Whether the envelope follows the rectified signal (peak), its windowed RMS, its true peak, or its analytic magnitude.
+ * private SlidingRms rms: The running RMS used by the RMS detector.
+ * private TruePeakDetector true_peak: The 4x polyphase interpolator used by the true-peak detector.
+ * private HilbertEnvelope analytic: The allpass-pair Hilbert transformer used by the analytic detector.
+ * private float rms_window_time: The RMS window length in seconds.
+ * private const float max_rms_window_time: The longest RMS window, which sets how much history is allocated.
+ * private SlidingMaximum hold: The sliding maximum of the detector signal used by the hold stage.
+ * private float hold_time: How long in seconds the envelope holds a peak before it starts to decay. 0 disables the hold stage.
+ * private const float max_hold_time: The longest hold, which sets how large a deque is allocated.
+ * private SlidingMaximum lookahead: The sliding maximum of the detector signal over the lookahead, so the envelope rises before transients.
+ * private float lookahead_time: The lookahead in seconds. 0 disables it.
+ * private const float max_lookahead_time: The longest lookahead, which sets how large the lookahead deque and audio delay are.
+ * private int lookahead_samples: The lookahead in samples, which is also the latency reported to the host.
+ * private int num_delay_channels: The number of channels the audio delay has room for.
+ * private DelayLine audio_delay: Holds the audio back by the lookahead, so it lines up with the envelope once the host compensates.
+ * private float detector_rate: The rate in Hz the detector and envelope run at after decimation. 0 runs them at the sampling frequency.
+ * private int front_decimation: The number of input samples the front end averages into each filter-rate sample. 1 when not decimating.
+ * private int front_phase: The number of input samples gathered towards the next filter-rate sample.
+ * private SampleType front_accumulator: The sum of the input samples gathered so far.
+ * private int decimation: The number of filter-rate samples per detector sample. 1 when not decimating.
+ * private int decimation_phase: The number of filter-rate samples gathered towards the next detector sample.
+ * private SampleType decimation_accumulator: The peak, or the sum of squares, of the filter-rate samples gathered so far.
+ * private SampleType control_decay_source: The per-sample decay that control_decay was computed from.
+ * private SampleType control_decay: The decay per detector sample, decay ^ decimation.
+ * private SampleType control_attack_source: The per-sample attack that control_attack was computed from.
+ * private SampleType control_attack: The attack per detector sample, attack ^ decimation.
+ * public static const int max_bands: The most bands the multiband bank can split the input into.
+ * private EnvelopeBank bands: One band-limited envelope per lane for the multiband mode.
+ * private int num_bands: The number of bands in use. 0 disables the multiband mode.
+ * private DownmixMode downmix_mode: How processBlock combines the input channels into one signal.
+ * private std::vector<SampleType> envelope_trace: The envelope value after every sample of the last block passed to processBlock.
+ * private std::vector<SampleType> downmix_power: Scratch space for the sum of squares of the power-sum downmix.
  * 
  * Methods
  * -------
  * public SignalProcessor(): The constructor for this component. Sets up the initial parameter values.
- * public void takeInSample(double sample): Processes a new audio sample and updates the current amplitude of the envelope accordingly.
+ * public void takeInSample(SampleType sample): Processes a new audio sample and updates the current amplitude of the envelope accordingly.
+ * public const SampleType* processBlock(const SampleType* const* channels, int numChannels, int numSamples): Processes a whole block of multichannel audio one stage at a time and returns the envelope trace.
  * public int getEnvelopePosition(): Returns the current position of the waveform envelope as a valid MIDI value between 0 and 127.
+ * public SampleType getEnvelope(): Returns the current value of the envelope, before rescaling.
+ * public void setEnvelope(SampleType envelope): Sets the current value of the envelope, so the processor can take over from another envelope follower.
+ * public bool fitsEnvelopeBank(): Returns whether an EnvelopeBank lane computes the same envelope as this processor does for one channel.
+ * public void configureBankLane(EnvelopeBank<SampleType>& bank, int lane): Copies the gain, cutoffs and recovery time to one lane of an EnvelopeBank.
+ * public int getEnvelopePosition(SampleType envelope_position): Rescales an envelope value from the trace into a valid MIDI value between 0 and 127.
+ * public double getEnvelopeLevel(SampleType envelope_position): Rescales an envelope value from the trace into a level between 0 and 1, without rounding it to a MIDI value.
  * public void setMinValue(float min): Sets the minimum possible MIDI output value.
  * public void setMaxValue(float max): Sets the maximum possible MIDI output value.
  * public void setGainValue(float gain): Sets the amplitude scaling coefficent applied to input audio samples before processing.
  * public void setLowpassValue(float gain): Sets the frequency cutoff threshold for the internal lowpass filter.
  * public void setHighpassValue(float gain): Sets the frequency cutoff threshold for the internal highpass filter.
- * public void setRecoveryTimeValue(float gain): Sets the amount of time it takes for the waveform envelope to decay to half its value given sufficiently small input audio samples.
+ * public void setRecoveryTimeValue(float gain): Sets the amount of time it takes for the waveform envelope to decay to half its value given sufficiently small input audio samples. (The release time)
+ * public void setAttackTimeValue(float new_attack_time): Sets the amount of time it takes for the waveform envelope to rise halfway to a louder input.
  * public void setSamplingFrequency(float gain): Sets the number of input audio samples the component should expect to receive per second of audio.
- * private void updateEnvelopePosition(float sample): Updates the current amplitude of the waveform envelope given a new audio sample.
+ * public void setMaximumBlockSize(int max_block_size): Preallocates the envelope trace for blocks of up to the given number of samples.
+ * public void setSmoothingTime(float new_smoothing_time): Sets how long parameter changes take to glide to their new values.
+ * public void setFilterOrder(int order): Selects the one-pole filters (1) or a 2nd, 4th or 8th order cascade.
+ * public void setFilterAlignment(Alignment alignment): Selects a Butterworth or Linkwitz-Riley cascade.
+ * public void setStateVariableMode(bool enabled): Selects the zero-delay-feedback state variable filters instead of the one-pole filters or the cascade.
+ * private void processStateVariable(SampleType* trace, int numSamples): Runs the state variable bandpass over a downmixed block.
+ * public void setDetectorMode(DetectorMode mode): Selects the peak, RMS, true-peak or analytic detector.
+ * public void setRmsWindowTime(float window_time): Sets the length of the RMS detector window.
+ * public void setHoldTime(float new_hold_time): Sets how long the envelope holds a peak before it starts to decay.
+ * public void setDetectorRate(float rate): Sets the rate the detector and envelope run at, decimating the filtered signal down to it.
+ * public void setDownmixMode(DownmixMode mode): Selects how processBlock combines the input channels.
+ * private SampleType downmixBlock(const SampleType* const* channels, int numChannels, int numSamples, SampleType* trace): Combines the input channels into the trace and returns the scaling factor still to apply.
+ * public void setLookaheadTime(float new_lookahead_time): Sets how far ahead of the audio the envelope looks for peaks.
+ * public int getLookaheadSamples(): Returns the lookahead in samples, which is the latency to report to the host.
+ * public void setNumChannels(int num_channels): Allocates the audio delay for the given number of channels.
+ * public void delayBlock(SampleType* const* channels, int numChannels, int numSamples): Delays the audio by the lookahead in place.
+ * private void updateLookaheadWindow(): Sets the lookahead window in detector samples.
+ * public void setNumBands(int count): Sets how many bands the multiband mode splits the input into. 0 disables it.
+ * public int getNumBands(): Returns the number of bands in use.
+ * public int getBandEnvelopePosition(int band, int index): Returns one band's envelope after a given sample of the last block as a MIDI value.
+ * public double getBandEnvelopeLevel(int band, int index): Returns one band's envelope after a given sample of the last block as a level between 0 and 1.
+ * private void prepareBands(int max_block_size): Allocates the band bank and reapplies its settings.
+ * private void updateBands(): Spreads the bands between the highpass and lowpass cutoffs and copies the recovery time to them.
+ * private double getFilterSamplingFrequency(): Returns the number of samples per second the filters and envelope coefficients run at, after the front end.
+ * private double getDetectorSamplingFrequency(): Returns the number of detector samples per second after decimation.
+ * private void updateFilterRate(): Rebuilds the filters, glide length, decay and attack for the filter rate.
+ * private int reduceBlock(SampleType* trace, int numSamples): Sums each group of front_decimation input samples into one filter-rate sample, in place.
+ * private void expandBlock(SampleType* trace, int numSamples, int numReduced, int first_end, SampleType previous_envelope): Spreads the filter-rate envelope back over the input samples, in place.
+ * private void decimateSegment<bool Ramping>(SampleType* trace, int numSamples): Runs the decimated detector and envelope over part of a block.
+ * private void decimateSample(SampleType sample, SampleType sample_decay, SampleType sample_attack): Gathers one filtered sample, and updates the envelope once a whole group is in.
+ * private void finishGroup(SampleType pooled, SampleType sample_decay, SampleType sample_attack): Runs the detector, hold and envelope once for a whole group.
+ * private void processSegment<bool Ramping, bool OnePole>(SampleType* trace, int numSamples, double input_scale): Runs the fused gain and filter loop over part of a block, with or without coefficient ramps and one-pole filters.
+ * private void detectSegment(SampleType* trace, int numSamples): Turns the filtered signal into the detector signal (rectified, RMS, true peak or analytic magnitude) over part of a block.
+ * private void followSegment<bool Ramping>(SampleType* trace, int numSamples): Runs the attack and release loop over part of a block, with or without coefficient ramps.
+ * private static SampleType followSample(SampleType envelope, SampleType detected, SampleType decay, SampleType attack): One branch-free attack/release update.
+ * private void updateEnvelopePosition(SampleType sample): Updates the current amplitude of the waveform envelope given a new audio sample.
  * 
  * Owns
  * - Filter
+ * - BiquadCascade
+ * - StateVariableFilter
+ * - SlidingRms
+ * - SlidingMaximum
+ * - EnvelopeBank
+ * - DelayLine
  * 
  * Owned by
  * - EnvelopeFollowerAudioProcessor
  */
+template <typename SampleType>
 class SignalProcessor
 {
 public:
+    /**
+     * The available detectors, which turn the filtered signal into what the envelope follows.
+     */
+    enum class DetectorMode {
+        /// The rectified signal. Reacts to every transient.
+        peak,
+        /// The RMS over a sliding window. Tracks perceived loudness more closely.
+        rms,
+        /// The rectified signal upsampled 4x, so peaks between samples count too. Lags the peak detector by 8 samples.
+        truePeak,
+        /// The magnitude of the analytic signal. Follows the amplitude of a tone without rippling at twice its frequency.
+        analytic
+    };
+
+    /**
+     * The ways processBlock can combine the input channels into the one signal the envelope follows.
+     */
+    enum class DownmixMode {
+        /// The average of every channel. Opposite-polarity content cancels.
+        mean,
+        /// The sample of whichever channel is loudest at that instant, sign included. Never cancels.
+        maxAbs,
+        /// The average of the first two channels, (L + R) / 2.
+        mid,
+        /// Half the difference of the first two channels, (L - R) / 2. Follows the stereo width.
+        side,
+        /// The RMS across the channels at each instant, with the sign of the loudest channel. Never cancels.
+        powerSum
+    };
+
+    /// <summary>
+    ///     The most bands the multiband mode can split the input into.
+    /// </summary>
+    static const int max_bands = 16;
+
     /**
      * The constructor for the SignalProcessor component.
      * 
@@ -243,9 +540,28 @@ public:
      * 
      * Arguments
      * ---------
-     * double sample: The input audio sample to update the output value 
+     * SampleType sample: The input audio sample to update the output value 
      */
-    void takeInSample(double sample);
+    void takeInSample(SampleType sample);
+
+    /**
+     * Updates the envelope from a whole block of multichannel input audio.
+     * 
+     * Equivalent to averaging the channels and calling takeInSample once per sample, but each stage (downmix, gain and
+     * filters, detector, decay) runs as a tight loop over the block with its coefficients and state held in locals.
+     * 
+     * Arguments
+     * ---------
+     * const SampleType* const* channels: One read pointer per input channel.
+     * int numChannels: The number of input channels. The channels are averaged together before processing.
+     * int numSamples: The number of samples in each channel. At most the size passed to setMaximumBlockSize; split bigger blocks
+     *                 into chunks, since growing the buffers would allocate and reset the bands on the audio thread.
+     * 
+     * Returns
+     * -------
+     * const SampleType*: The envelope value after each of the numSamples input samples. Valid until the next call.
+     */
+    const SampleType* processBlock(const SampleType* const* channels, int numChannels, int numSamples);
 
     /**
      * Gets the next output MIDI value.
@@ -258,6 +574,74 @@ public:
      */
     int getEnvelopePosition();
 
+    /**
+     * Returns the current value of the envelope, before it is rescaled to the output range.
+     * 
+     * Returns
+     * -------
+     * SampleType: The envelope after the last sample.
+     */
+    SampleType getEnvelope() const { return current_envelope_position; };
+
+    /**
+     * Sets the current value of the envelope, so this processor can take over from another envelope follower without a jump.
+     * 
+     * Arguments
+     * ---------
+     * SampleType envelope: The envelope value to continue from.
+     */
+    void setEnvelope(SampleType envelope) { current_envelope_position = envelope; };
+
+    /**
+     * Returns whether a lane of an EnvelopeBank, set up with configureBankLane, computes the same envelope this processor
+     * would for a single channel. The bank only has the peak detector after the one-pole filters, at the full rate,
+     * with an instant attack and no hold or lookahead. It also has no glides, so it jumps to new settings.
+     * 
+     * Returns
+     * -------
+     * bool: True if the current settings need nothing the bank doesn't have.
+     */
+    bool fitsEnvelopeBank() const;
+
+    /**
+     * Copies the gain, cutoffs and recovery time this processor is set to (or gliding to) to one lane of an EnvelopeBank,
+     * for a lane fed a single channel.
+     * 
+     * Arguments
+     * ---------
+     * EnvelopeBank<SampleType>& bank: The bank to update.
+     * int lane: The index of the lane.
+     */
+    void configureBankLane(EnvelopeBank<SampleType>& bank, int lane) const;
+
+    /**
+     * Rescales an envelope value, such as one from the trace returned by processBlock, into an output MIDI value.
+     * 
+     * Arguments
+     * ---------
+     * SampleType envelope_position: The envelope value to rescale.
+     * 
+     * Returns
+     * -------
+     * int: The envelope value rescaled and clamped between the minimum and maximum output bounds.
+     */
+    int getEnvelopePosition(SampleType envelope_position);
+
+    /**
+     * Rescales an envelope value into an output level, for outputs finer than a 7-bit MIDI value.
+     * 
+     * The same rescaling and clamping as getEnvelopePosition, but without rounding, so each output can quantize it to its own resolution.
+     * 
+     * Arguments
+     * ---------
+     * SampleType envelope_position: The envelope value to rescale.
+     * 
+     * Returns
+     * -------
+     * double: The envelope value rescaled and clamped between the minimum and maximum output bounds, divided by 127 to lie between 0 and 1.
+     */
+    double getEnvelopeLevel(SampleType envelope_position);
+
     /**
      * Sets the minimum output MIDI value.
      * 
@@ -318,6 +702,17 @@ public:
      */
     void setRecoveryTimeValue(float recovery_time);
 
+    /**
+     * Sets the amount of time the envelope takes to rise halfway to a louder input.
+     * 
+     * Uses the same half-life definition as setRecoveryTimeValue, so attack and release are set in the same units.
+     * 
+     * Arguments
+     * ---------
+     * float new_attack_time: The attack half-life in seconds. 0 makes the envelope jump straight to louder input.
+     */
+    void setAttackTimeValue(float new_attack_time);
+
     /**
      * Sets the number of input audio samples this component should expect per second of audio input.
      * 
@@ -327,11 +722,226 @@ public:
      */
     void setSamplingFrequency(double freq);
 
+    /**
+     * Preallocates the envelope trace returned by processBlock.
+     * 
+     * Should be called from prepareToPlay so that no memory is allocated while processing audio.
+     * 
+     * Arguments
+     * ---------
+     * int max_block_size: The largest number of samples processBlock is expected to receive at once.
+     */
+    void setMaximumBlockSize(int max_block_size);
+
+    /**
+     * Sets how long changes to the gain, cutoff frequencies and recovery time take to glide to their new values.
+     * 
+     * The gliding is done on the already computed coefficients, so it costs additions rather than
+     * transcendental calls per sample, and removes the zipper noise of block-wise parameter jumps.
+     * 
+     * Arguments
+     * ---------
+     * float new_smoothing_time: The glide time in seconds. 0 makes changes take effect immediately.
+     */
+    void setSmoothingTime(float new_smoothing_time);
+
+    /**
+     * Sets the order of the lowpass and highpass filtering.
+     * 
+     * Order 1 uses the one-pole lowFilter and highFilter (6 dB/octave). Orders 2, 4 and 8 use the biquad cascade
+     * (12, 24 and 48 dB/octave on each side). Switching orders resets the cascade.
+     * 
+     * Arguments
+     * ---------
+     * int order: 1, 2, 4 or 8.
+     */
+    void setFilterOrder(int order);
+
+    /**
+     * Selects the alignment of the biquad cascade. Has no effect at filter order 1.
+     * 
+     * Arguments
+     * ---------
+     * typename BiquadCascade<SampleType>::Alignment alignment: Butterworth or Linkwitz-Riley.
+     */
+    void setFilterAlignment(typename BiquadCascade<SampleType>::Alignment alignment);
+
+    /**
+     * Selects the zero-delay-feedback state variable filters instead of the one-pole filters or the cascade.
+     * 
+     * Each side is a 12 dB/octave Butterworth response, like a 2nd order cascade, but the cutoffs glide
+     * in Hz and are applied every sample without rebuilding any coefficients, so fast sweeps stay cheap.
+     * 
+     * Arguments
+     * ---------
+     * bool enabled: True for the state variable filters, False for the one-pole filters or cascade selected by setFilterOrder.
+     */
+    void setStateVariableMode(bool enabled);
+
+    /**
+     * Selects the peak, RMS, true-peak or analytic detector.
+     * 
+     * Arguments
+     * ---------
+     * DetectorMode mode: The new detector.
+     */
+    void setDetectorMode(DetectorMode mode);
+
+    /**
+     * Sets the length of the RMS detector window.
+     * 
+     * Every sample costs the same whatever the window length. Changing the length resums the new window
+     * from the stored history once, so it shouldn't be swept continuously.
+     * 
+     * Arguments
+     * ---------
+     * float window_time: The window length in seconds. Clamped to between one sample and max_rms_window_time.
+     */
+    void setRmsWindowTime(float window_time);
+
+    /**
+     * Sets how long the envelope holds a peak before it starts to decay.
+     * 
+     * With a hold, the decay follows the true maximum of the detector signal over the last hold_time
+     * seconds rather than the detector signal itself, so short hits don't start dropping straight away.
+     * 
+     * Arguments
+     * ---------
+     * float new_hold_time: The hold in seconds. 0 disables the hold stage. Clamped to max_hold_time.
+     */
+    void setHoldTime(float new_hold_time);
+
+    /**
+     * Sets the rate the detector, hold and envelope run at.
+     * 
+     * The CC output is only sent a few times a second, so the detector doesn't need to run at 44.1-192 kHz.
+     * Above 0, decimation happens in two stages:
+     * - Above 88.2 kHz, a front end averages each group of front_decimation input samples (a first-order CIC),
+     *   bringing the signal down to 44.1 or 48 kHz. That is still above twice the highest cutoff, so the filters,
+     *   which then run at this rate, see the whole audible band. It costs one add per input sample, and the
+     *   averaging is 2.5 dB down at 20 kHz at 192 kHz.
+     * - The filtered signal is then pooled down to roughly this rate (a whole number of filter-rate samples per
+     *   detector sample) before detection, and the envelope is held between detector samples.
+     * The envelope lags the full-rate one by at most one detector sample (1 ms at 1 kHz).
+     * 
+     * Arguments
+     * ---------
+     * float rate: The detector rate in Hz, such as 1000 to 4000. 0 runs the detector at the sampling frequency.
+     */
+    void setDetectorRate(float rate);
+
+    /**
+     * Sets how far ahead of the audio the envelope looks for peaks.
+     * 
+     * The detector signal goes through a sliding maximum over the lookahead, so every peak reaches the envelope
+     * lookahead seconds early, and with an attack time the envelope has already risen by the time the transient
+     * plays. The plugin holds the audio back by the same amount with delayBlock and reports it as latency, so
+     * the host lines the CC output up with the audio again.
+     * 
+     * Arguments
+     * ---------
+     * float new_lookahead_time: The lookahead in seconds. 0 disables it. Clamped to max_lookahead_time.
+     */
+    void setLookaheadTime(float new_lookahead_time);
+
+    /**
+     * Selects how processBlock combines the input channels into one signal. takeInSample takes one signal already, so is unaffected.
+     * 
+     * The max-abs and power-sum downmixes keep a bipolar waveform for the filters by taking the sign of the
+     * loudest channel, but can't cancel the way averaging opposite-polarity channels does.
+     * 
+     * Arguments
+     * ---------
+     * DownmixMode mode: The new downmix.
+     */
+    void setDownmixMode(DownmixMode mode);
+
+    /**
+     * Returns the lookahead in samples, which is the latency the plugin should report to the host.
+     * 
+     * Returns
+     * -------
+     * int: The lookahead in samples at the current sampling frequency.
+     */
+    int getLookaheadSamples() const { return lookahead_samples; };
+
+    /**
+     * Allocates the audio delay for the given number of channels.
+     * 
+     * Allocates memory, so should only be called from prepareToPlay.
+     * 
+     * Arguments
+     * ---------
+     * int num_channels: The most channels delayBlock will be given.
+     */
+    void setNumChannels(int num_channels);
+
+    /**
+     * Delays a block of audio in place by the lookahead. Does nothing while the lookahead is 0.
+     * 
+     * Arguments
+     * ---------
+     * SampleType* const* channels: One write pointer per channel. Overwritten with the delayed audio.
+     * int numChannels: The number of channels.
+     * int numSamples: The number of samples in each channel.
+     */
+    void delayBlock(SampleType* const* channels, int numChannels, int numSamples);
+
+    /**
+     * Sets how many bands the multiband mode splits the input into.
+     * 
+     * The bands are spaced evenly in log frequency (constant Q) between the highpass and lowpass cutoffs. Each is a
+     * fourth-order bandpass, and each gets its own envelope with the recovery time. They all run in one EnvelopeBank, so the whole set
+     * advances together in SIMD registers instead of one full chain per band. Only processBlock updates them.
+     * 
+     * Arguments
+     * ---------
+     * int count: The number of bands. Clamped to max_bands. 0 disables the multiband mode.
+     */
+    void setNumBands(int count);
+
+    /**
+     * Returns the number of bands in use.
+     * 
+     * Returns
+     * -------
+     * int: The number of bands. 0 when the multiband mode is off.
+     */
+    int getNumBands() const { return num_bands; };
+
+    /**
+     * Returns one band's envelope after a given sample of the last processed block, rescaled into a MIDI value.
+     * 
+     * Arguments
+     * ---------
+     * int band: The index of the band, from lowest to highest.
+     * int index: The index of the sample within the last block.
+     * 
+     * Returns
+     * -------
+     * int: The band envelope rescaled and clamped between the minimum and maximum output bounds.
+     */
+    int getBandEnvelopePosition(int band, int index);
+
+    /**
+     * Returns one band's envelope after a given sample of the last processed block, rescaled into an output level.
+     * 
+     * Arguments
+     * ---------
+     * int band: The index of the band, from lowest to highest.
+     * int index: The index of the sample within the last block.
+     * 
+     * Returns
+     * -------
+     * double: The band envelope rescaled and clamped between the minimum and maximum output bounds, between 0 and 1.
+     */
+    double getBandEnvelopeLevel(int band, int index);
+
 private:
     /// <summary>
     ///     The current rolling MIDI output value.
     /// </summary>
-    float current_envelope_position;
+    SampleType current_envelope_position;
 
     /// <summary>
     ///     The minimum MIDI output value.
@@ -346,7 +956,7 @@ private:
     /// <summary>
     ///     A scaling coefficient applied to the input audio samples before updating the envelope position.
     /// </summary>
-    float gain;
+    SmoothedCoefficient<SampleType> gain;
 
     /// <summary>
     ///     The number of audio samples that this component should expect to recieve for each second of audio input.
@@ -357,7 +967,32 @@ private:
     ///     A multiplier applied to the tentative envelope position for every input audio sample.
     ///     The lower this is the faster the tentative envelope position approaches 0 given lower audio input.
     /// </summary>
-    float decay = 0.99;
+    SmoothedCoefficient<SampleType> decay;
+
+    /// <summary>
+    ///     The amount of time in seconds the gain, decay and filter coefficients take to glide to new values.
+    /// </summary>
+    float smoothing_time = 0.01;
+    /// <summary>
+    ///     smoothing_time converted to samples at the filter rate.
+    /// </summary>
+    int smoothing_length = 0;
+
+    /// <summary>
+    ///     The amount of time in seconds the envelope takes to decay to half of its value.
+    ///     Kept so that decay can be rebuilt when the sampling frequency changes. Negative until first set.
+    /// </summary>
+    float recovery_time = -1;
+
+    /// <summary>
+    ///     How much of the gap to a louder input the envelope keeps each sample. 0 jumps straight to the input.
+    /// </summary>
+    SmoothedCoefficient<SampleType> attack;
+    /// <summary>
+    ///     The attack half-life in seconds.
+    ///     Kept so that attack can be rebuilt when the sampling frequency changes. Negative until first set.
+    /// </summary>
+    float attack_time = -1;
 
     /// <summary>
     ///     The minimum value of the MIDI output messages.
@@ -373,22 +1008,456 @@ private:
     /// 
     ///     Disposed of when this component is disposed of.
     /// </summary>
-    Filter lowFilter;
+    Filter<SampleType> lowFilter;
     /// <summary>
     ///     The highpass filter applied to the input audio samples before updating the MIDI output value.
     /// 
     ///     Disposed of when this component is disposed of.
     /// </summary>
-    Filter highFilter;
+    Filter<SampleType> highFilter;
+
+    /// <summary>
+    ///     The order of the lowpass and highpass filtering. 1 uses lowFilter and highFilter, anything higher uses cascade.
+    /// </summary>
+    int filter_order = 1;
+    /// <summary>
+    ///     The Butterworth or Linkwitz-Riley bandpass used in place of lowFilter and highFilter when filter_order is above 1.
+    /// 
+    ///     Disposed of when this component is disposed of.
+    /// </summary>
+    BiquadCascade<SampleType> cascade;
+
+    /// <summary>
+    ///     Whether the state variable filters replace both the one-pole filters and the cascade.
+    /// </summary>
+    bool state_variable = false;
+    /// <summary>
+    ///     The lowpass half of the state variable bandpass.
+    /// 
+    ///     Disposed of when this component is disposed of.
+    /// </summary>
+    StateVariableFilter<SampleType> lowStateVariable;
+    /// <summary>
+    ///     The highpass half of the state variable bandpass.
+    /// 
+    ///     Disposed of when this component is disposed of.
+    /// </summary>
+    StateVariableFilter<SampleType> highStateVariable;
+    /// <summary>
+    ///     The lowpass cutoff in Hz. Glides in Hz rather than in coefficients, since the state variable filters take a cutoff every sample.
+    /// </summary>
+    SmoothedCoefficient<SampleType> lowpass_cutoff;
+    /// <summary>
+    ///     The highpass cutoff in Hz. Glides in Hz rather than in coefficients, since the state variable filters take a cutoff every sample.
+    /// </summary>
+    SmoothedCoefficient<SampleType> highpass_cutoff;
+
+    /// <summary>
+    ///     Whether the envelope follows the rectified signal (peak), its windowed RMS, its true peak, or its analytic magnitude.
+    /// </summary>
+    DetectorMode detector_mode = DetectorMode::peak;
+    /// <summary>
+    ///     The 4x polyphase interpolator used by the true-peak detector. Needs no allocation, so it is ready as soon as it is built.
+    /// 
+    ///     Disposed of when this component is disposed of.
+    /// </summary>
+    TruePeakDetector<SampleType> true_peak;
+    /// <summary>
+    ///     The allpass-pair Hilbert transformer used by the analytic detector. Needs no allocation.
+    /// 
+    ///     Disposed of when this component is disposed of.
+    /// </summary>
+    HilbertEnvelope<SampleType> analytic;
+    /// <summary>
+    ///     The running RMS used by the RMS detector. Its history is allocated in setSamplingFrequency.
+    /// 
+    ///     Disposed of when this component is disposed of.
+    /// </summary>
+    SlidingRms<SampleType> rms;
+    /// <summary>
+    ///     The RMS window length in seconds.
+    /// </summary>
+    float rms_window_time = 0.05f;
+    /// <summary>
+    ///     The longest RMS window in seconds. Sets how much history setSamplingFrequency allocates.
+    /// </summary>
+    const float max_rms_window_time = 2.0f;
+
+    /// <summary>
+    ///     The sliding maximum of the detector signal used by the hold stage. Its deque is allocated in setSamplingFrequency.
+    /// 
+    ///     Disposed of when this component is disposed of.
+    /// </summary>
+    SlidingMaximum<SampleType> hold;
+    /// <summary>
+    ///     How long in seconds the envelope holds a peak before it starts to decay. 0 disables the hold stage.
+    /// </summary>
+    float hold_time = 0;
+    /// <summary>
+    ///     The longest hold in seconds. Sets how large a deque setSamplingFrequency allocates.
+    /// </summary>
+    const float max_hold_time = 1.0f;
+
+    /// <summary>
+    ///     The sliding maximum of the detector signal over the lookahead. Its deque is allocated in setSamplingFrequency.
+    /// 
+    ///     Disposed of when this component is disposed of.
+    /// </summary>
+    SlidingMaximum<SampleType> lookahead;
+    /// <summary>
+    ///     The lookahead in seconds. 0 disables it.
+    /// </summary>
+    float lookahead_time = 0;
+    /// <summary>
+    ///     The longest lookahead in seconds. Sets how large a deque and audio delay are allocated.
+    /// </summary>
+    const float max_lookahead_time = 0.05f;
+    /// <summary>
+    ///     The lookahead in samples, which is also the latency reported to the host.
+    /// </summary>
+    int lookahead_samples = 0;
+    /// <summary>
+    ///     The number of channels the audio delay has room for.
+    /// </summary>
+    int num_delay_channels = 0;
+    /// <summary>
+    ///     Holds the audio back by the lookahead. Its ring is allocated in setSamplingFrequency and setNumChannels.
+    /// 
+    ///     Disposed of when this component is disposed of.
+    /// </summary>
+    DelayLine<SampleType> audio_delay;
+
+    /// <summary>
+    ///     The rate in Hz the detector, hold and envelope run at after decimation. 0 runs them at the sampling frequency.
+    /// </summary>
+    float detector_rate = 0;
+    /// <summary>
+    ///     The number of input samples the front end averages into each filter-rate sample. 1 when not decimating, or at 48 kHz and below.
+    /// </summary>
+    int front_decimation = 1;
+    /// <summary>
+    ///     The number of input samples gathered towards the next filter-rate sample.
+    /// </summary>
+    int front_phase = 0;
+    /// <summary>
+    ///     The sum of the input samples gathered towards the next filter-rate sample.
+    /// </summary>
+    SampleType front_accumulator = 0;
+    /// <summary>
+    ///     The number of filter-rate samples per detector sample. 1 when not decimating.
+    /// </summary>
+    int decimation = 1;
+    /// <summary>
+    ///     The number of filter-rate samples gathered towards the next detector sample.
+    /// </summary>
+    int decimation_phase = 0;
+    /// <summary>
+    ///     The largest rectified sample (peak detector) or the sum of squares (RMS detector) of the group so far.
+    /// </summary>
+    SampleType decimation_accumulator = 0;
+    /// <summary>
+    ///     The per-sample decay that control_decay was last computed from. Negative when nothing has been computed yet.
+    /// </summary>
+    SampleType control_decay_source = -1;
+    /// <summary>
+    ///     The decay per detector sample, decay ^ decimation.
+    /// </summary>
+    SampleType control_decay = 0;
+    /// <summary>
+    ///     The per-sample attack that control_attack was last computed from. Negative when nothing has been computed yet.
+    /// </summary>
+    SampleType control_attack_source = -1;
+    /// <summary>
+    ///     The attack per detector sample, attack ^ decimation.
+    /// </summary>
+    SampleType control_attack = 0;
+
+    /// <summary>
+    ///     One band-limited envelope per lane for the multiband mode. Allocated for max_bands lanes in setMaximumBlockSize.
+    /// 
+    ///     Disposed of when this component is disposed of.
+    /// </summary>
+    EnvelopeBank<SampleType> bands;
+    /// <summary>
+    ///     The number of bands in use. 0 disables the multiband mode.
+    /// </summary>
+    int num_bands = 0;
+
+    /// <summary>
+    ///     The envelope value after every sample of the last processed block.
+    ///     Also used as scratch space for the downmixed input while the block is being processed.
+    /// </summary>
+    std::vector<SampleType> envelope_trace;
+    /// <summary>
+    ///     How processBlock combines the input channels into one signal.
+    /// </summary>
+    DownmixMode downmix_mode = DownmixMode::mean;
+    /// <summary>
+    ///     Scratch space for the per-sample sum of squares of the power-sum downmix. Preallocated with envelope_trace.
+    /// </summary>
+    std::vector<SampleType> downmix_power;
 
     /**
      * Updates the value of the output MIDI messages given an input audio sample.
      *
-     * Sets the output sample to the maximum of the input audio value and the decayed output value.
+     * Decays the output value, or moves it towards the input audio value by the attack coefficient if that is larger.
      *
      * Arguments
      * ---------
-     * float sample: The audio sample used to update the output MIDI value.
+     * SampleType sample: The audio sample used to update the output MIDI value.
+     */
+    void updateEnvelopePosition(SampleType sample);
+
+    /**
+     * Combines the input channels into the trace according to downmix_mode.
+     * 
+     * Each mode is a few passes over whole contiguous channels, written as plain loops with no dependencies
+     * between samples so that the compiler vectorises them. Any constant scaling is left to the fused gain loop.
+     * 
+     * Arguments
+     * ---------
+     * const SampleType* const* channels: One read pointer per input channel.
+     * int numChannels: The number of input channels.
+     * int numSamples: The number of samples in each channel.
+     * SampleType* trace: Where to write the combined signal. Has room for numSamples.
+     * 
+     * Returns
+     * -------
+     * SampleType: The scaling factor still to apply to the trace, such as 1 / numChannels for the mean.
+     */
+    SampleType downmixBlock(const SampleType* const* channels, int numChannels, int numSamples, SampleType* trace);
+
+    /**
+     * Runs the fused gain and one-pole filter loop over part of a block.
+     * 
+     * Ramping selects, at compile time, whether the coefficients advance by their ramp step every sample.
+     * OnePole selects whether the one-pole filters run here, or were already applied by the cascade or state variable filters.
+     * processBlock splits the block so that every ramp starts or ends on a segment boundary.
+     * 
+     * Arguments
+     * ---------
+     * SampleType* trace: The downmixed input samples for the segment. Overwritten with the filtered samples.
+     * int numSamples: The length of the segment.
+     * SampleType input_scale: The downmix scaling factor applied before the gain.
+     */
+    template <bool Ramping, bool OnePole>
+    void processSegment(SampleType* trace, int numSamples, SampleType input_scale);
+
+    /**
+     * Turns the filtered signal into the detector signal over part of a block, in place.
+     * 
+     * Arguments
+     * ---------
+     * SampleType* trace: The filtered samples for the segment. Overwritten with the detector signal.
+     * int numSamples: The length of the segment.
+     */
+    void detectSegment(SampleType* trace, int numSamples);
+
+    /**
+     * Runs the attack and release loop over part of a block.
+     * 
+     * Ramping selects, at compile time, whether the decay and attack advance by their ramp steps every sample.
+     * 
+     * Arguments
+     * ---------
+     * SampleType* trace: The detector signal for the segment. Overwritten with the envelope.
+     * int numSamples: The length of the segment.
+     */
+    template <bool Ramping>
+    void followSegment(SampleType* trace, int numSamples);
+
+    /**
+     * Sets the lookahead window in detector samples, so it covers lookahead_samples at the full rate.
+     */
+    void updateLookaheadWindow();
+
+    /**
+     * Allocates the band bank for max_bands lanes and blocks of up to the given size, and reapplies its settings.
+     * 
+     * Allocates memory and resets every band, so should only be called from setMaximumBlockSize.
+     * 
+     * Arguments
+     * ---------
+     * int max_block_size: The largest number of samples processBlock is expected to receive at once.
+     */
+    void prepareBands(int max_block_size);
+
+    /**
+     * Spreads the bands evenly in log frequency between the highpass and lowpass cutoffs, and copies the recovery time to them.
+     */
+    void updateBands();
+
+    /**
+     * Returns the number of samples per second the filters, glides, decay and attack run at, after the front end.
+     * 
+     * Returns
+     * -------
+     * double: The sampling frequency divided by the front end's decimation factor.
+     */
+    double getFilterSamplingFrequency() const { return sampling_frequency / front_decimation; };
+
+    /**
+     * Returns the number of detector samples per second after decimation.
+     * 
+     * Returns
+     * -------
+     * double: The filter rate divided by the decimation factor.
+     */
+    double getDetectorSamplingFrequency() const { return getFilterSamplingFrequency() / decimation; };
+
+    /**
+     * Rebuilds everything that counts in filter-rate samples (the filters, the glide length, the decay and the attack)
+     * for the current filter rate, and starts the filters from silence.
+     */
+    void updateFilterRate();
+
+    /**
+     * The decimating front end. Sums each group of front_decimation input samples into one filter-rate sample,
+     * packed at the start of the trace. A group left unfinished at the end of the block is finished by the next one.
+     * 
+     * Arguments
+     * ---------
+     * SampleType* trace: The downmixed input samples. Overwritten at the start with the group sums.
+     * int numSamples: The number of input samples.
+     * 
+     * Returns
+     * -------
+     * int: The number of groups finished in this block.
+     */
+    int reduceBlock(SampleType* trace, int numSamples);
+
+    /**
+     * Spreads the envelope after each filter-rate sample back over the input samples, in place, so each input sample
+     * gets the envelope after the last group finished by then, as the full-rate trace would.
+     * 
+     * Arguments
+     * ---------
+     * SampleType* trace: The envelope after each filter-rate sample, at the start. Overwritten with the envelope after each input sample.
+     * int numSamples: The number of input samples.
+     * int numReduced: The number of filter-rate samples.
+     * int first_end: The input sample that finished the first group.
+     * SampleType previous_envelope: The envelope before the block, for the input samples before first_end.
+     */
+    void expandBlock(SampleType* trace, int numSamples, int numReduced, int first_end, SampleType previous_envelope);
+
+    /**
+     * Runs the decimated detector, hold and envelope over part of a block.
+     * 
+     * Ramping selects, at compile time, whether the decay and attack advance by their ramp steps every sample.
+     * 
+     * Arguments
+     * ---------
+     * SampleType* trace: The filtered samples for the segment. Overwritten with the envelope, held between detector samples.
+     * int numSamples: The length of the segment.
+     */
+    template <bool Ramping>
+    void decimateSegment(SampleType* trace, int numSamples);
+
+    /**
+     * Gathers one filtered sample into the decimator, and updates the envelope once a whole group of decimation
+     * samples is in.
+     * 
+     * The decimator keeps what each detector needs from the group. For the peak detector that is the largest
+     * rectified sample (for the true-peak and analytic detectors, the largest interpolated or analytic magnitude), so no peak is missed and the envelope reaches the same heights as at the full rate.
+     * For the RMS detector it is the mean square (a first-order CIC, an integrate-and-dump average), which the
+     * RMS window then sums exactly, so the RMS is unchanged too. Either way the group is the anti-aliasing
+     * filter, and nothing is lost that the CC output could show.
+     * 
+     * The coefficients are per filter-rate sample, so they are raised to the decimation factor, once per change.
+     * 
+     * Arguments
+     * ---------
+     * SampleType sample: The filtered sample.
+     * SampleType sample_decay: The decay for this sample.
+     * SampleType sample_attack: The attack for this sample.
+     */
+    void decimateSample(SampleType sample, SampleType sample_decay, SampleType sample_attack) {
+        if (detector_mode == DetectorMode::rms) {
+            decimation_accumulator += sample * sample;
+        } else if (detector_mode == DetectorMode::truePeak) {
+            decimation_accumulator = std::max(decimation_accumulator, true_peak.processSample(sample));
+        } else if (detector_mode == DetectorMode::analytic) {
+            decimation_accumulator = std::max(decimation_accumulator, analytic.processSample(sample));
+        } else {
+            decimation_accumulator = std::max(decimation_accumulator, (SampleType) fabs(sample));
+        }
+        if (++decimation_phase < decimation) {
+            return;
+        }
+        decimation_phase = 0;
+        finishGroup(decimation_accumulator, sample_decay, sample_attack);
+    };
+
+    /**
+     * Runs the detector, hold and envelope once for a whole group of decimation filter-rate samples, and starts the next group.
+     * 
+     * Arguments
+     * ---------
+     * SampleType pooled: What the decimator kept from the group: the largest rectified sample, or the sum of squares.
+     * SampleType sample_decay: The decay for the group's last filter-rate sample.
+     * SampleType sample_attack: The attack for the group's last filter-rate sample.
+     */
+    void finishGroup(SampleType pooled, SampleType sample_decay, SampleType sample_attack) {
+        // The detector signal for the group.
+        SampleType detected = pooled;
+        decimation_accumulator = 0;
+        if (detector_mode == DetectorMode::rms) {
+            // SlidingRms squares its input again, so hand it the root of the mean square.
+            detected = rms.processSample((SampleType) sqrt(detected / decimation));
+        }
+        if (lookahead_samples > 0) {
+            detected = lookahead.processSample((SampleType) fabs(detected));
+        }
+        if (hold_time > 0) {
+            detected = hold.processSample((SampleType) fabs(detected));
+        }
+
+        // Only recompute the control-rate coefficients when the per-sample ones have moved.
+        if (sample_decay != control_decay_source) {
+            control_decay_source = sample_decay;
+            control_decay = (SampleType) pow(sample_decay, decimation);
+        }
+        if (sample_attack != control_attack_source) {
+            control_attack_source = sample_attack;
+            control_attack = (SampleType) pow(sample_attack, decimation);
+        }
+        current_envelope_position = followSample(current_envelope_position, detected, control_decay, control_attack);
+    };
+
+    /**
+     * One attack/release update, written without branches.
+     * 
+     * The release decays the envelope towards 0. Wherever the detector signal is above the decayed envelope, the
+     * attack moves the envelope towards it instead, keeping attack of the gap. Both outcomes are computed and one
+     * is selected, which compiles to a compare and blend rather than a jump.
+     * 
+     * Arguments
+     * ---------
+     * SampleType envelope: The envelope after the previous sample.
+     * SampleType detected: The detector signal for this sample. Never negative.
+     * SampleType decay: The release coefficient.
+     * SampleType attack: The attack coefficient. 0 for an instant attack.
+     * 
+     * Returns
+     * -------
+     * SampleType: The envelope after this sample.
+     */
+    static SampleType followSample(SampleType envelope, SampleType detected, SampleType decay, SampleType attack) {
+        const SampleType decayed = envelope * decay;
+        // The larger of the two is where the envelope would go with an instant attack.
+        const SampleType target = std::max(decayed, detected);
+        // Only slow the envelope down when it is rising.
+        const SampleType rise = detected > decayed ? attack : (SampleType) 0;
+        return target + rise * (envelope - target);
+    };
+
+    /**
+     * Runs the state variable bandpass over a downmixed block, in place.
+     * 
+     * Arguments
+     * ---------
+     * SampleType* trace: The downmixed input samples. Overwritten with the filtered samples.
+     * int numSamples: The number of samples.
      */
-    void updateEnvelopePosition(float sample);
+    void processStateVariable(SampleType* trace, int numSamples);
 };
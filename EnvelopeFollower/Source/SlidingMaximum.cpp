@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    SlidingMaximum.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the block and setup methods of the SlidingMaximum component class.
+    Dependencies:
+    - SlidingMaximum.h
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "SlidingMaximum.h" // Import the interface definition for the SlidingMaximum component for implementation.
+
+/**
+ * Allocates the deque for windows of up to the given length, and clears it.
+ *
+ * Allocates memory, so should only be called from prepareToPlay.
+ *
+ * Arguments
+ * ---------
+ * int max_window_length: The longest window in samples.
+ */
+template <typename SampleType>
+void SlidingMaximum<SampleType>::prepare(int max_window_length)
+{
+    capacity = std::max(max_window_length, 1);
+    values.assign(capacity, (SampleType) 0);
+    positions.assign(capacity, 0);
+    window_length = std::min(std::max(window_length, 1), capacity);
+    reset();
+}
+
+/**
+ * Sets the number of samples in the window.
+ *
+ * Arguments
+ * ---------
+ * int new_window_length: The new window length in samples. Clamped to between 1 and the length passed to prepare.
+ */
+template <typename SampleType>
+void SlidingMaximum<SampleType>::setWindowLength(int new_window_length)
+{
+    window_length = std::min(std::max(new_window_length, 1), std::max(capacity, 1));
+}
+
+/**
+ * Empties the deque.
+ */
+template <typename SampleType>
+void SlidingMaximum<SampleType>::reset()
+{
+    head = 0;
+    size = 0;
+    position = 0;
+}
+
+/**
+ * Replaces each sample of a block with the maximum of the window ending on it.
+ *
+ * Arguments
+ * ---------
+ * SampleType* samples: The input samples. Overwritten with the maximum.
+ * int numSamples: The number of samples.
+ */
+template <typename SampleType>
+void SlidingMaximum<SampleType>::process(SampleType* samples, int numSamples)
+{
+    for (int index = 0; index < numSamples; ++index) {
+        samples[index] = processSample(samples[index]);
+    }
+}
+
+// The plugin uses both precisions, depending on what the host asks for.
+template class SlidingMaximum<float>;
+template class SlidingMaximum<double>;
@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+    SlidingMaximum.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition and the per-sample implementation of the SlidingMaximum component class,
+                 the maximum over a sliding window in amortised O(1) per sample.
+    Dependencies:
+    - algorithm
+    - vector
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <algorithm> // Imports the c++ stdlib algorithm libarary.
+#include <vector> // Imports the c++ stdlib vector container used for the preallocated deque.
+
+/**
+ * The maximum of the last window_length samples, using a monotonic deque.
+ *
+ * The deque holds the samples that could still become the maximum: each is larger than every sample that came
+ * after it. A new sample first evicts every smaller or equal sample from the back (they can never be the maximum
+ * again while it is in the window), and the front is dropped once it falls out of the window. The front is then
+ * the maximum. Every sample is pushed and popped at most once, so the cost is amortised O(1) per sample for any
+ * window length.
+ *
+ * The deque is a fixed-capacity ring allocated by prepare, so processing never allocates.
+ *
+ * Attributes
+ * ----------
+ * private std::vector<SampleType> values: The ring of candidate values.
+ * private std::vector<long long> positions: The sample position of each candidate, to tell when it leaves the window.
+ * private int capacity: The size of the ring, which is the longest supported window.
+ * private int head: The ring index of the front of the deque.
+ * private int size: The number of candidates in the deque.
+ * private int window_length: The number of samples in the window.
+ * private long long position: The position of the most recent sample.
+ *
+ * Methods
+ * -------
+ * public void prepare(int max_window_length): Allocates the deque for windows of up to the given length and clears it.
+ * public void setWindowLength(int new_window_length): Sets the window length.
+ * public void reset(): Empties the deque.
+ * public SampleType processSample(SampleType sample): Adds a sample and returns the maximum of the window ending on it.
+ * public void process(SampleType* samples, int numSamples): Replaces each sample of a block with the maximum of the window ending on it.
+ * public int getWindowLength(): Returns the window length in samples.
+ *
+ * Owned by
+ * - SignalProcessor
+ */
+template <typename SampleType>
+class SlidingMaximum
+{
+public:
+    /**
+     * Allocates the deque for windows of up to the given length, and clears it.
+     *
+     * Allocates memory, so should only be called from prepareToPlay.
+     *
+     * Arguments
+     * ---------
+     * int max_window_length: The longest window in samples.
+     */
+    void prepare(int max_window_length);
+
+    /**
+     * Sets the number of samples in the window.
+     *
+     * A shorter window takes effect on the next sample, which drops any candidates that are now too old.
+     * A longer window can only include samples that were still candidates, so the maximum is exact once
+     * the new window has filled.
+     *
+     * Arguments
+     * ---------
+     * int new_window_length: The new window length in samples. Clamped to between 1 and the length passed to prepare.
+     */
+    void setWindowLength(int new_window_length);
+
+    /**
+     * Empties the deque.
+     */
+    void reset();
+
+    /**
+     * Adds a sample to the window and returns the maximum of the window ending on it.
+     *
+     * Arguments
+     * ---------
+     * SampleType sample: The next input sample.
+     *
+     * Returns
+     * -------
+     * SampleType: The maximum of the last window_length samples.
+     */
+    SampleType processSample(SampleType sample) {
+        if (capacity == 0) {
+            return sample;
+        }
+        ++position;
+
+        // Evict every candidate the new sample beats. They can never be the maximum again.
+        while (size > 0) {
+            int back = head + size - 1;
+            if (back >= capacity) {
+                back -= capacity;
+            }
+            if (values[back] > sample) {
+                break;
+            }
+            --size;
+        }
+
+        // Drop candidates that have left the window. The new sample is pushed after this, so it can't be dropped.
+        while (size > 0 && positions[head] <= position - window_length) {
+            if (++head == capacity) {
+                head = 0;
+            }
+            --size;
+        }
+
+        // Push the new sample. There is always room, since every candidate is inside a window of at most capacity samples.
+        int slot = head + size;
+        if (slot >= capacity) {
+            slot -= capacity;
+        }
+        values[slot] = sample;
+        positions[slot] = position;
+        ++size;
+
+        return values[head];
+    };
+
+    /**
+     * Replaces each sample of a block with the maximum of the window ending on it.
+     *
+     * Arguments
+     * ---------
+     * SampleType* samples: The input samples. Overwritten with the maximum.
+     * int numSamples: The number of samples.
+     */
+    void process(SampleType* samples, int numSamples);
+
+    /**
+     * Returns the number of samples in the window.
+     *
+     * Returns
+     * -------
+     * int: The window length in samples.
+     */
+    int getWindowLength() const { return window_length; };
+
+private:
+    /// <summary>
+    ///     The ring of candidate values, from largest (front) to smallest (back).
+    /// </summary>
+    std::vector<SampleType> values;
+    /// <summary>
+    ///     The sample position of each candidate, to tell when it leaves the window.
+    /// </summary>
+    std::vector<long long> positions;
+    /// <summary>
+    ///     The size of the ring, which is the longest supported window.
+    /// </summary>
+    int capacity = 0;
+    /// <summary>
+    ///     The ring index of the front of the deque.
+    /// </summary>
+    int head = 0;
+    /// <summary>
+    ///     The number of candidates in the deque.
+    /// </summary>
+    int size = 0;
+    /// <summary>
+    ///     The number of samples in the window.
+    /// </summary>
+    int window_length = 1;
+    /// <summary>
+    ///     The position of the most recent sample.
+    /// </summary>
+    long long position = 0;
+};
@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    SlidingRms.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the block and setup methods of the SlidingRms component class.
+    Dependencies:
+    - SlidingRms.h
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "SlidingRms.h" // Import the interface definition for the SlidingRms component for implementation.
+
+/**
+ * Allocates the ring for windows of up to the given length, and clears it.
+ *
+ * Allocates memory, so should only be called from prepareToPlay.
+ *
+ * Arguments
+ * ---------
+ * int max_window_length: The longest window in samples.
+ */
+template <typename SampleType>
+void SlidingRms<SampleType>::prepare(int max_window_length)
+{
+    squares.assign(std::max(max_window_length, 1), (SampleType) 0);
+    window_length = std::min(std::max(window_length, 1), (int) squares.size());
+    reset();
+}
+
+/**
+ * Sets the number of samples in the window.
+ *
+ * The ring always holds the most recent squares, so the new window is resummed from it.
+ * This is O(window length), once per change, and never allocates.
+ *
+ * Arguments
+ * ---------
+ * int new_window_length: The new window length in samples. Clamped to between 1 and the length passed to prepare.
+ */
+template <typename SampleType>
+void SlidingRms<SampleType>::setWindowLength(int new_window_length)
+{
+    const int capacity = std::max((int) squares.size(), 1);
+    new_window_length = std::min(std::max(new_window_length, 1), capacity);
+    if (new_window_length == window_length) {
+        return;
+    }
+    window_length = new_window_length;
+
+    if (squares.empty()) {
+        return;
+    }
+    // Resum the squares now inside the window, walking back from the newest.
+    double sum = 0;
+    int index = write_index;
+    for (int count = 0; count < window_length; ++count) {
+        index = index == 0 ? capacity - 1 : index - 1;
+        sum += (double) squares[index];
+    }
+    running_sum = sum;
+    fresh_sum = 0;
+    fresh_count = 0;
+}
+
+/**
+ * Clears the ring and the sums.
+ */
+template <typename SampleType>
+void SlidingRms<SampleType>::reset()
+{
+    std::fill(squares.begin(), squares.end(), (SampleType) 0);
+    write_index = 0;
+    running_sum = 0;
+    fresh_sum = 0;
+    fresh_count = 0;
+}
+
+/**
+ * Replaces each sample of a block with the RMS of the window ending on it.
+ *
+ * Arguments
+ * ---------
+ * SampleType* samples: The input samples. Overwritten with the RMS.
+ * int numSamples: The number of samples.
+ */
+template <typename SampleType>
+void SlidingRms<SampleType>::process(SampleType* samples, int numSamples)
+{
+    for (int index = 0; index < numSamples; ++index) {
+        samples[index] = processSample(samples[index]);
+    }
+}
+
+// The plugin uses both precisions, depending on what the host asks for.
+template class SlidingRms<float>;
+template class SlidingRms<double>;
@@ -0,0 +1,176 @@
+/*
+  ==============================================================================
+
+    SlidingRms.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition and the per-sample implementation of the SlidingRms component class,
+                 a running RMS over a sliding window that costs the same per sample for any window length.
+    Dependencies:
+    - algorithm
+    - math.h
+    - vector
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <algorithm> // Imports the c++ stdlib algorithm libarary.
+#include <math.h> // Imports the basic c stdlib math library
+#include <vector> // Imports the c++ stdlib vector container used for the ring of squared samples.
+
+/**
+ * The RMS of the last window_length samples, updated in O(1) per sample.
+ *
+ * Keeps the squared samples in a preallocated ring and a running sum of the ones inside the window: each new sample
+ * adds its square and subtracts the square that just left the window.
+ *
+ * A running sum built from additions and subtractions slowly drifts from the true sum through rounding, and a tiny
+ * negative drift would make sqrt() fail on silence. So alongside it a second sum collects only the squares added
+ * since the last correction. Once window_length samples have gone by, that second sum covers exactly the window,
+ * so it replaces the running sum and starts again. This corrects drift every window with no extra per-sample work
+ * and no O(window) rescan.
+ *
+ * The sums are kept in double whatever the sample type.
+ *
+ * Attributes
+ * ----------
+ * private std::vector<SampleType> squares: The ring of squared samples. Its size is the longest supported window.
+ * private int window_length: The number of samples in the window.
+ * private int write_index: The ring index the next square is written to.
+ * private double running_sum: The sum of the squares in the window, updated incrementally.
+ * private double fresh_sum: The sum of the squares added since the last drift correction.
+ * private int fresh_count: The number of squares in fresh_sum.
+ *
+ * Methods
+ * -------
+ * public void prepare(int max_window_length): Allocates the ring for windows of up to the given length and clears it.
+ * public void setWindowLength(int new_window_length): Sets the window length, resumming the new window from the ring.
+ * public void reset(): Clears the ring and the sums.
+ * public SampleType processSample(SampleType sample): Adds a sample and returns the RMS of the window ending on it.
+ * public void process(SampleType* samples, int numSamples): Replaces each sample of a block with the RMS of the window ending on it.
+ * public int getWindowLength(): Returns the window length in samples.
+ *
+ * Owned by
+ * - SignalProcessor
+ */
+template <typename SampleType>
+class SlidingRms
+{
+public:
+    /**
+     * Allocates the ring for windows of up to the given length, and clears it.
+     *
+     * Allocates memory, so should only be called from prepareToPlay.
+     *
+     * Arguments
+     * ---------
+     * int max_window_length: The longest window in samples.
+     */
+    void prepare(int max_window_length);
+
+    /**
+     * Sets the number of samples in the window.
+     *
+     * The ring always holds the most recent max_window_length squares, so the new window is resummed from it.
+     * This is O(window length), once per change, and never allocates.
+     *
+     * Arguments
+     * ---------
+     * int new_window_length: The new window length in samples. Clamped to between 1 and the length passed to prepare.
+     */
+    void setWindowLength(int new_window_length);
+
+    /**
+     * Clears the ring and the sums.
+     */
+    void reset();
+
+    /**
+     * Adds a sample to the window and returns the RMS of the window ending on it.
+     *
+     * Arguments
+     * ---------
+     * SampleType sample: The next input sample.
+     *
+     * Returns
+     * -------
+     * SampleType: The RMS of the last window_length samples.
+     */
+    SampleType processSample(SampleType sample) {
+        const int capacity = (int) squares.size();
+        if (capacity == 0) {
+            return (SampleType) fabs(sample);
+        }
+
+        // The square leaving the window is window_length entries behind the write position.
+        int leaving_index = write_index - window_length;
+        if (leaving_index < 0) {
+            leaving_index += capacity;
+        }
+        const SampleType square = sample * sample;
+        running_sum += (double) square - (double) squares[leaving_index];
+        squares[write_index] = square;
+        if (++write_index == capacity) {
+            write_index = 0;
+        }
+
+        // Once the fresh sum covers the whole window, it is the exact sum: swap it in to discard the drift.
+        fresh_sum += (double) square;
+        if (++fresh_count == window_length) {
+            running_sum = fresh_sum;
+            fresh_sum = 0;
+            fresh_count = 0;
+        }
+
+        return (SampleType) sqrt(std::max(running_sum, 0.0) / window_length);
+    };
+
+    /**
+     * Replaces each sample of a block with the RMS of the window ending on it.
+     *
+     * Arguments
+     * ---------
+     * SampleType* samples: The input samples. Overwritten with the RMS.
+     * int numSamples: The number of samples.
+     */
+    void process(SampleType* samples, int numSamples);
+
+    /**
+     * Returns the number of samples in the window.
+     *
+     * Returns
+     * -------
+     * int: The window length in samples.
+     */
+    int getWindowLength() const { return window_length; };
+
+private:
+    /// <summary>
+    ///     The ring of squared samples. Its size is the longest supported window, so any shorter window can be resummed from it.
+    /// </summary>
+    std::vector<SampleType> squares;
+    /// <summary>
+    ///     The number of samples in the window.
+    /// </summary>
+    int window_length = 1;
+    /// <summary>
+    ///     The ring index the next square is written to.
+    /// </summary>
+    int write_index = 0;
+    /// <summary>
+    ///     The sum of the squares in the window, updated incrementally every sample.
+    /// </summary>
+    double running_sum = 0;
+    /// <summary>
+    ///     The sum of the squares added since the last drift correction.
+    /// </summary>
+    double fresh_sum = 0;
+    /// <summary>
+    ///     The number of squares in fresh_sum.
+    /// </summary>
+    int fresh_count = 0;
+};
@@ -0,0 +1,300 @@
+/*
+  ==============================================================================
+
+    SpectralFeatures.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the SpectralFeatures component class.
+    Dependencies:
+    - SpectralFeatures.h
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "SpectralFeatures.h" // Import the interface definition for the SpectralFeatures component for implementation.
+
+/**
+ * Allocates the buffers and tables for the given window and hop, and clears the history.
+ *
+ * Allocates memory, so should only be called from prepareToPlay.
+ *
+ * Arguments
+ * ---------
+ * double freq: The number of input samples per second.
+ * int new_fft_size: The number of samples in each analysis window. Rounded up to a power of 2, at least 16.
+ * int new_hop_size: The number of samples between analyses. Clamped to between 1 and the window size.
+ */
+template <typename SampleType>
+void SpectralFeatures<SampleType>::prepare(double freq, int new_fft_size, int new_hop_size)
+{
+    const double pi = 3.14159265358979323846;
+    sampling_frequency = freq;
+    fft_size = 16;
+    while (fft_size < new_fft_size) {
+        fft_size *= 2;
+    }
+    hop_size = std::min(std::max(new_hop_size, 1), fft_size);
+    const int half = fft_size / 2;
+
+    ring.assign(fft_size, (SampleType) 0);
+    window.resize(fft_size);
+    for (int index = 0; index < fft_size; ++index) {
+        // A periodic Hann window, so overlapping hops sum to a constant.
+        window[index] = (SampleType) (0.5 - 0.5 * cos(2 * pi * index / fft_size));
+    }
+    fft.prepare(fft_size);
+    windowed.assign(fft_size, (SampleType) 0);
+    real.assign(half + 1, (SampleType) 0);
+    imaginary.assign(half + 1, (SampleType) 0);
+    power.assign(half + 1, (SampleType) 0);
+    magnitude.assign(half + 1, (SampleType) 0);
+    band_edges.assign(max_bands + 1, 0);
+    updateBandEdges();
+    reset();
+}
+
+/**
+ * Selects which features are computed. The power spectrum is computed whenever any feature or band is enabled.
+ *
+ * Arguments
+ * ---------
+ * int mask: Bit (1 << (int) feature) set for each Feature to compute.
+ */
+template <typename SampleType>
+void SpectralFeatures<SampleType>::setEnabledFeatures(int mask)
+{
+    const bool was_running = enabled_features != 0 || num_bands > 0;
+    enabled_features = mask & ((1 << num_features) - 1);
+    if (!was_running) {
+        // The ring stopped filling while nothing was enabled, so start again from silence.
+        reset();
+    }
+}
+
+/**
+ * Sets how many band energies are computed.
+ *
+ * Arguments
+ * ---------
+ * int new_num_bands: The number of bands. Clamped to between 0 and max_bands.
+ */
+template <typename SampleType>
+void SpectralFeatures<SampleType>::setNumBands(int new_num_bands)
+{
+    const bool was_running = enabled_features != 0 || num_bands > 0;
+    num_bands = std::min(std::max(new_num_bands, 0), (int) max_bands);
+    updateBandEdges();
+    if (!was_running) {
+        reset();
+    }
+}
+
+/**
+ * Clears the history and the features.
+ */
+template <typename SampleType>
+void SpectralFeatures<SampleType>::reset()
+{
+    std::fill(ring.begin(), ring.end(), (SampleType) 0);
+    std::fill(magnitude.begin(), magnitude.end(), (SampleType) 0);
+    std::fill(features, features + num_features, (SampleType) 0);
+    std::fill(band_energies, band_energies + max_bands, (SampleType) 0);
+    write_index = 0;
+    since_analysis = 0;
+}
+
+/**
+ * Gathers a block of multichannel audio, and analyses it every hop_size samples.
+ *
+ * Does nothing when no feature or band is enabled, or before prepare.
+ *
+ * Arguments
+ * ---------
+ * const SampleType* const* channels: One pointer per input channel to numSamples samples.
+ * int numChannels: The number of input channels. They are averaged.
+ * int numSamples: The number of samples in each channel.
+ */
+template <typename SampleType>
+void SpectralFeatures<SampleType>::process(const SampleType* const* channels, int numChannels, int numSamples)
+{
+    if (fft_size == 0 || numChannels < 1 || (enabled_features == 0 && num_bands == 0)) {
+        return;
+    }
+    const SampleType scale = (SampleType) 1 / numChannels;
+    int index = 0;
+    while (index < numSamples) {
+        // Copy up to the next analysis or the end of the ring, whichever comes first.
+        const int length = std::min(std::min(numSamples - index, hop_size - since_analysis), fft_size - write_index);
+        SampleType* destination = ring.data() + write_index;
+        std::copy(channels[0] + index, channels[0] + index + length, destination);
+        for (int channel = 1; channel < numChannels; ++channel) {
+            const SampleType* source = channels[channel] + index;
+            for (int offset = 0; offset < length; ++offset) {
+                destination[offset] += source[offset];
+            }
+        }
+        if (numChannels > 1) {
+            for (int offset = 0; offset < length; ++offset) {
+                destination[offset] *= scale;
+            }
+        }
+
+        index += length;
+        write_index += length;
+        if (write_index == fft_size) {
+            write_index = 0;
+        }
+        since_analysis += length;
+        if (since_analysis == hop_size) {
+            since_analysis = 0;
+            analyse();
+        }
+    }
+}
+
+/**
+ * Windows the last fft_size samples, runs the FFT, and derives the enabled features from the power spectrum.
+ */
+template <typename SampleType>
+void SpectralFeatures<SampleType>::analyse()
+{
+    transform();
+    const int half = fft_size / 2;
+    const double bin_width = sampling_frequency / fft_size;
+
+    double total = 0;
+    for (int bin = 0; bin <= half; ++bin) {
+        total += power[bin];
+    }
+    // Below about -120 dBFS there is nothing to describe, so let everything fall to 0 rather than divide noise by noise.
+    const bool silent = total < 1e-12;
+
+    if (isEnabled(Feature::centroid)) {
+        double weighted = 0;
+        for (int bin = 1; bin <= half; ++bin) {
+            weighted += bin * (double) power[bin];
+        }
+        features[(int) Feature::centroid] = silent ? 0 : logPosition(weighted / total * bin_width);
+    }
+    if (isEnabled(Feature::rolloff)) {
+        const double threshold = rolloff_fraction * total;
+        double cumulative = 0;
+        int bin = 0;
+        while (bin < half && (cumulative += power[bin]) < threshold) {
+            ++bin;
+        }
+        features[(int) Feature::rolloff] = silent ? 0 : logPosition(bin * bin_width);
+    }
+    if (isEnabled(Feature::flatness)) {
+        // The ratio of the geometric to the arithmetic mean, leaving out DC. The floor keeps log() finite on empty bins.
+        const double floor = 1e-20 + total * 1e-12;
+        double log_sum = 0;
+        double sum = 0;
+        for (int bin = 1; bin <= half; ++bin) {
+            const double value = power[bin] + floor;
+            log_sum += log(value);
+            sum += value;
+        }
+        features[(int) Feature::flatness] = silent ? 0 : (SampleType) std::min(exp(log_sum / half) / (sum / half), 1.0);
+    }
+    if (isEnabled(Feature::flux)) {
+        // Only increases count, so the flux peaks when something new starts rather than when something stops.
+        double increase = 0;
+        double sum = 0;
+        for (int bin = 0; bin <= half; ++bin) {
+            const SampleType value = (SampleType) sqrt(power[bin]);
+            increase += std::max(value - magnitude[bin], (SampleType) 0);
+            sum += value;
+            magnitude[bin] = value;
+        }
+        features[(int) Feature::flux] = sum > 0 ? (SampleType) (increase / sum) : 0;
+    }
+    for (int band = 0; band < num_bands; ++band) {
+        double energy = 0;
+        for (int bin = band_edges[band]; bin < band_edges[band + 1]; ++bin) {
+            energy += power[bin];
+        }
+        const double decibels = 10 * log10(energy + 1e-30);
+        band_energies[band] = (SampleType) std::min(std::max((decibels - band_floor) / -band_floor, 0.0), 1.0);
+    }
+}
+
+/**
+ * The real FFT of the windowed ring, as the power of each bin from 0 to Nyquist.
+ */
+template <typename SampleType>
+void SpectralFeatures<SampleType>::transform()
+{
+    const int half = fft_size / 2;
+
+    // Window, unrolling the ring from its oldest sample.
+    for (int index = 0; index < fft_size; ++index) {
+        int position = write_index + index;
+        if (position >= fft_size) {
+            position -= fft_size;
+        }
+        windowed[index] = ring[position] * window[index];
+    }
+    fft.forward(windowed.data(), real.data(), imaginary.data());
+
+    // Scaled so a full scale sine sums to 1.
+    double window_energy = 0;
+    for (int index = 0; index < fft_size; ++index) {
+        window_energy += (double) window[index] * window[index];
+    }
+    const SampleType scale = (SampleType) (4.0 / (fft_size * window_energy));
+    for (int bin = 0; bin <= half; ++bin) {
+        // DC and Nyquist have no mirror image in the other half of the spectrum.
+        const SampleType bin_scale = bin == 0 || bin == half ? scale / 2 : scale;
+        power[bin] = (real[bin] * real[bin] + imaginary[bin] * imaginary[bin]) * bin_scale;
+    }
+}
+
+/**
+ * Recomputes the first bin of each band, spreading the bands evenly in log frequency from min_frequency to Nyquist.
+ *
+ * The lowest band also takes the bins below min_frequency, and the highest runs up to Nyquist.
+ */
+template <typename SampleType>
+void SpectralFeatures<SampleType>::updateBandEdges()
+{
+    if (fft_size == 0 || num_bands == 0) {
+        return;
+    }
+    const int half = fft_size / 2;
+    const double nyquist = sampling_frequency / 2;
+    const double bin_width = sampling_frequency / fft_size;
+    band_edges[0] = 0;
+    for (int band = 1; band < num_bands; ++band) {
+        const double edge = min_frequency * pow(nyquist / min_frequency, (double) band / num_bands);
+        band_edges[band] = std::min(std::max((int) ceil(edge / bin_width), band_edges[band - 1]), half);
+    }
+    band_edges[num_bands] = half + 1;
+}
+
+/**
+ * Places a frequency on the log axis from min_frequency to Nyquist.
+ *
+ * Arguments
+ * ---------
+ * double freq: The frequency in Hz.
+ *
+ * Returns
+ * -------
+ * SampleType: 0 at or below min_frequency, 1 at Nyquist.
+ */
+template <typename SampleType>
+SampleType SpectralFeatures<SampleType>::logPosition(double freq) const
+{
+    if (freq <= min_frequency) {
+        return 0;
+    }
+    const double position = log(freq / min_frequency) / log(sampling_frequency / 2 / min_frequency);
+    return (SampleType) std::min(position, 1.0);
+}
+
+// The plugin uses both precisions, depending on what the host asks for.
+template class SpectralFeatures<float>;
+template class SpectralFeatures<double>;
@@ -0,0 +1,358 @@
+/*
+  ==============================================================================
+
+    SpectralFeatures.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition for the SpectralFeatures component class, which derives spectral
+                 centroid, rolloff, flatness, flux and band energies from one windowed real FFT per hop.
+    Dependencies:
+    - algorithm
+    - math.h
+    - vector
+    - RealFft.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <algorithm> // Imports the c++ stdlib algorithm libarary.
+#include <math.h> // Imports the basic c stdlib math library
+#include <vector> // Imports the c++ stdlib vector container used for the preallocated FFT buffers.
+#include "RealFft.h" // Imports the real FFT the power spectrum is computed with.
+
+/**
+ * A spectral feature engine that runs beside SignalProcessor, for sonification CCs that follow timbre as well as level.
+ *
+ * The input (the mean of the channels) is gathered into a ring. Every hop_size samples the last fft_size samples
+ * are Hann windowed and transformed with one real FFT, and every enabled feature is derived from that one power
+ * spectrum, so five features cost one FFT and not five. The analysis happens inside process, at the hop rate,
+ * which is far below the sampling frequency and still above any CC rate.
+ *
+ * The FFT is a RealFft, shared with the other control rate analysers. It and every buffer here are allocated in
+ * prepare, which is the only place anything is allocated.
+ *
+ * Every feature is normalised to [0, 1]:
+ * - centroid: The power-weighted mean frequency, as a position on a log axis from min_frequency to Nyquist.
+ * - rolloff: The frequency below which rolloff_fraction of the power lies, on the same log axis.
+ * - flatness: The geometric mean of the power over its arithmetic mean. 1 for white noise, near 0 for a tone.
+ * - flux: The summed increase of each bin's magnitude since the last hop, over the summed magnitude.
+ * - band energies: The power in each of up to max_bands log-spaced bands, in dB from -60 (0) to 0 dBFS (1).
+ *
+ * Attributes
+ * ----------
+ * public static const int max_bands: The most band energies that can be computed.
+ * public static constexpr double rolloff_fraction: The fraction of the power below the rolloff frequency.
+ * public static constexpr double min_frequency: The bottom of the log frequency axis for the centroid, rolloff and bands, in Hz.
+ * public static constexpr double band_floor: The band energy in dB that maps to 0.
+ * private double sampling_frequency: The number of input samples per second.
+ * private int fft_size: The number of samples in each analysis window. A power of 2.
+ * private int hop_size: The number of samples between analyses.
+ * private int enabled_features: One bit per Feature, for the features to compute.
+ * private int num_bands: The number of band energies to compute.
+ * private std::vector<SampleType> ring: The last fft_size input samples.
+ * private int write_index: The ring index the next sample is written to.
+ * private int since_analysis: The number of samples since the last analysis.
+ * private std::vector<SampleType> window: The Hann window.
+ * private RealFft<SampleType> fft: The real FFT of the windowed ring.
+ * private std::vector<SampleType> windowed: The windowed ring, unrolled from its oldest sample.
+ * private std::vector<SampleType> real, imaginary: The spectrum of the windowed ring, from DC to Nyquist.
+ * private std::vector<SampleType> power: The power of each bin from 0 to Nyquist.
+ * private std::vector<SampleType> magnitude: The magnitude of each bin at the last analysis, for the flux.
+ * private std::vector<int> band_edges: The first bin of each band, and one past the last bin of the last band.
+ * public static const int num_features: The number of values in Feature.
+ * private SampleType features[num_features]: The latest value of each feature.
+ * private SampleType band_energies[max_bands]: The latest energy of each band.
+ *
+ * Methods
+ * -------
+ * public void prepare(double freq, int new_fft_size, int new_hop_size): Allocates the buffers and tables, and clears the history.
+ * public void setEnabledFeatures(int mask): Selects which features are computed.
+ * public void setNumBands(int new_num_bands): Sets how many band energies are computed.
+ * public void reset(): Clears the history and the features.
+ * public void process(const SampleType* const* channels, int numChannels, int numSamples): Gathers a block and analyses it every hop.
+ * public SampleType getFeature(Feature feature): Returns the latest value of a feature.
+ * public SampleType getBandEnergy(int band): Returns the latest energy of a band.
+ * public int getFeatureMidiValue(Feature feature): Returns the latest value of a feature as a MIDI value.
+ * public int getBandMidiValue(int band): Returns the latest energy of a band as a MIDI value.
+ * public bool isEnabled(Feature feature): Returns whether a feature is being computed.
+ * public int getNumBands(): Returns the number of band energies being computed.
+ * private void analyse(): Windows the ring, runs the FFT and derives the enabled features.
+ * private void transform(): The real FFT of the windowed ring, into power.
+ * private void updateBandEdges(): Recomputes the bins of each band.
+ * private SampleType logPosition(double freq): Places a frequency on the log axis from min_frequency to Nyquist.
+ *
+ * Owns
+ * - RealFft
+ *
+ * Owned by
+ * - EnvelopeFollowerAudioProcessor
+ */
+template <typename SampleType>
+class SpectralFeatures
+{
+public:
+    /**
+     * The features derived from the spectrum, other than the band energies.
+     */
+    enum class Feature {
+        /// The power-weighted mean frequency. Bright sounds read high.
+        centroid,
+        /// The frequency below which most of the power lies.
+        rolloff,
+        /// How noise-like the spectrum is.
+        flatness,
+        /// How much the spectrum has changed since the last hop. Peaks on onsets.
+        flux
+    };
+
+    /// <summary>
+    ///     The number of values in Feature.
+    /// </summary>
+    static const int num_features = 4;
+    /// <summary>
+    ///     The most band energies that can be computed.
+    /// </summary>
+    static const int max_bands = 8;
+    /// <summary>
+    ///     The fraction of the power below the rolloff frequency.
+    /// </summary>
+    static constexpr double rolloff_fraction = 0.85;
+    /// <summary>
+    ///     The bottom of the log frequency axis for the centroid, rolloff and bands, in Hz.
+    /// </summary>
+    static constexpr double min_frequency = 20.0;
+    /// <summary>
+    ///     The band energy in dB relative to a full scale sine that maps to 0. 0 dB maps to 1.
+    /// </summary>
+    static constexpr double band_floor = -60.0;
+
+    /**
+     * Allocates the buffers and tables for the given window and hop, and clears the history.
+     *
+     * Allocates memory, so should only be called from prepareToPlay.
+     *
+     * Arguments
+     * ---------
+     * double freq: The number of input samples per second.
+     * int new_fft_size: The number of samples in each analysis window. Rounded up to a power of 2, at least 16.
+     * int new_hop_size: The number of samples between analyses. Clamped to between 1 and the window size.
+     */
+    void prepare(double freq, int new_fft_size, int new_hop_size);
+
+    /**
+     * Selects which features are computed. The power spectrum is computed whenever any feature or band is enabled.
+     *
+     * Arguments
+     * ---------
+     * int mask: Bit (1 << (int) feature) set for each Feature to compute.
+     */
+    void setEnabledFeatures(int mask);
+
+    /**
+     * Sets how many band energies are computed.
+     *
+     * Arguments
+     * ---------
+     * int new_num_bands: The number of bands. Clamped to between 0 and max_bands.
+     */
+    void setNumBands(int new_num_bands);
+
+    /**
+     * Clears the history and the features.
+     */
+    void reset();
+
+    /**
+     * Gathers a block of multichannel audio, and analyses it every hop_size samples.
+     *
+     * Does nothing when no feature or band is enabled, or before prepare.
+     *
+     * Arguments
+     * ---------
+     * const SampleType* const* channels: One pointer per input channel to numSamples samples.
+     * int numChannels: The number of input channels. They are averaged.
+     * int numSamples: The number of samples in each channel.
+     */
+    void process(const SampleType* const* channels, int numChannels, int numSamples);
+
+    /**
+     * Returns the value of a feature at the last analysis.
+     *
+     * Arguments
+     * ---------
+     * Feature feature: The feature.
+     *
+     * Returns
+     * -------
+     * SampleType: The feature, normalised to [0, 1].
+     */
+    SampleType getFeature(Feature feature) const { return features[(int) feature]; };
+
+    /**
+     * Returns the energy of a band at the last analysis.
+     *
+     * Arguments
+     * ---------
+     * int band: The band, from 0 (lowest) to the number of bands - 1.
+     *
+     * Returns
+     * -------
+     * SampleType: The band energy, normalised to [0, 1].
+     */
+    SampleType getBandEnergy(int band) const { return band_energies[band]; };
+
+    /**
+     * Returns the value of a feature at the last analysis as a MIDI value.
+     *
+     * Arguments
+     * ---------
+     * Feature feature: The feature.
+     *
+     * Returns
+     * -------
+     * int: The feature scaled to between 0 and 127.
+     */
+    int getFeatureMidiValue(Feature feature) const { return (int) lround(getFeature(feature) * 127); };
+
+    /**
+     * Returns the energy of a band at the last analysis as a MIDI value.
+     *
+     * Arguments
+     * ---------
+     * int band: The band, from 0 (lowest) to the number of bands - 1.
+     *
+     * Returns
+     * -------
+     * int: The band energy scaled to between 0 and 127.
+     */
+    int getBandMidiValue(int band) const { return (int) lround(getBandEnergy(band) * 127); };
+
+    /**
+     * Returns whether the feature is enabled.
+     *
+     * Arguments
+     * ---------
+     * Feature feature: The feature.
+     *
+     * Returns
+     * -------
+     * bool: True if setEnabledFeatures selected it.
+     */
+    bool isEnabled(Feature feature) const { return (enabled_features >> (int) feature) & 1; };
+
+    /**
+     * Returns the number of band energies being computed.
+     *
+     * Returns
+     * -------
+     * int: The number of bands.
+     */
+    int getNumBands() const { return num_bands; };
+
+private:
+    /**
+     * Windows the last fft_size samples, runs the FFT, and derives the enabled features from the power spectrum.
+     */
+    void analyse();
+
+    /**
+     * The real FFT of the windowed ring, as the power of each bin from 0 to Nyquist.
+     */
+    void transform();
+
+    /**
+     * Recomputes the first bin of each band, spreading the bands evenly in log frequency from min_frequency to Nyquist.
+     */
+    void updateBandEdges();
+
+    /**
+     * Places a frequency on the log axis from min_frequency to Nyquist.
+     *
+     * Arguments
+     * ---------
+     * double freq: The frequency in Hz.
+     *
+     * Returns
+     * -------
+     * SampleType: 0 at or below min_frequency, 1 at Nyquist.
+     */
+    SampleType logPosition(double freq) const;
+
+    /// <summary>
+    ///     The number of input samples per second.
+    /// </summary>
+    double sampling_frequency = 44100;
+    /// <summary>
+    ///     The number of samples in each analysis window. A power of 2. 0 until prepare.
+    /// </summary>
+    int fft_size = 0;
+    /// <summary>
+    ///     The number of samples between analyses.
+    /// </summary>
+    int hop_size = 1;
+    /// <summary>
+    ///     One bit per Feature, for the features to compute.
+    /// </summary>
+    int enabled_features = 0;
+    /// <summary>
+    ///     The number of band energies to compute.
+    /// </summary>
+    int num_bands = 0;
+
+    /// <summary>
+    ///     The last fft_size input samples, as a ring.
+    /// </summary>
+    std::vector<SampleType> ring;
+    /// <summary>
+    ///     The ring index the next sample is written to, which is also the oldest sample.
+    /// </summary>
+    int write_index = 0;
+    /// <summary>
+    ///     The number of samples since the last analysis.
+    /// </summary>
+    int since_analysis = 0;
+    /// <summary>
+    ///     The Hann window.
+    /// </summary>
+    std::vector<SampleType> window;
+    /// <summary>
+    ///     The real FFT of the windowed ring.
+    /// </summary>
+    RealFft<SampleType> fft;
+    /// <summary>
+    ///     The windowed ring, unrolled from its oldest sample.
+    /// </summary>
+    std::vector<SampleType> windowed;
+    /// <summary>
+    ///     The real part of the spectrum of the windowed ring, from DC to Nyquist.
+    /// </summary>
+    std::vector<SampleType> real;
+    /// <summary>
+    ///     The imaginary part of the spectrum of the windowed ring, from DC to Nyquist.
+    /// </summary>
+    std::vector<SampleType> imaginary;
+    /// <summary>
+    ///     The power of each bin from 0 to Nyquist, scaled so a full scale sine sums to 1.
+    /// </summary>
+    std::vector<SampleType> power;
+    /// <summary>
+    ///     The magnitude of each bin at the last analysis, for the flux.
+    /// </summary>
+    std::vector<SampleType> magnitude;
+    /// <summary>
+    ///     The first bin of each band, followed by one past the last bin of the last band.
+    /// </summary>
+    std::vector<int> band_edges;
+    /// <summary>
+    ///     The latest value of each feature.
+    /// </summary>
+    SampleType features[num_features] = {};
+    /// <summary>
+    ///     The latest energy of each band.
+    /// </summary>
+    SampleType band_energies[max_bands] = {};
+};
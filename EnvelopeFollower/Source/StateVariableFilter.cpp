@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+    StateVariableFilter.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the block and setup methods of the StateVariableFilter component class.
+    Dependencies:
+    - StateVariableFilter.h
+    - math.h
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "StateVariableFilter.h" // Import the interface definition for the StateVariableFilter component for implementation.
+#include <math.h> // Imports the basic c stdlib math library
+
+/**
+ * The constructor for the StateVariableFilter component.
+ *
+ * Builds the shared tan lookup table if no filter has yet, so it is never built on the audio thread.
+ */
+template <typename SampleType>
+StateVariableFilter<SampleType>::StateVariableFilter()
+{
+    tan_table = getTanTable().data();
+    setCutoff(cutoff_frequency);
+}
+
+/**
+ * Returns the lookup table of tan(pi * x) for x from 0 to max_normalised_cutoff, building it on first call.
+ *
+ * The table depends only on the normalised cutoff, so one table serves every instance at every sampling frequency.
+ *
+ * Returns
+ * -------
+ * const std::vector<SampleType>&: tan_table_size + 1 entries.
+ */
+template <typename SampleType>
+const std::vector<SampleType>& StateVariableFilter<SampleType>::getTanTable()
+{
+    // Built once, the first time any filter of this sample type is constructed.
+    static const std::vector<SampleType> table = [] {
+        const double pi = 3.1415926535897932;
+        std::vector<SampleType> entries(tan_table_size + 1);
+        for (int index = 0; index <= tan_table_size; ++index) {
+            entries[index] = (SampleType) tan(pi * max_normalised_cutoff * index / tan_table_size);
+        }
+        return entries;
+    }();
+    return table;
+}
+
+/**
+ * Sets the number of input audio samples per second.
+ *
+ * Arguments
+ * ---------
+ * double freq: The new number of input audio samples per second.
+ */
+template <typename SampleType>
+void StateVariableFilter<SampleType>::setSamplingFrequency(double freq)
+{
+    inverse_sampling_frequency = (SampleType) (1.0 / freq);
+    // The fixed cutoff's integrator gain depends on the sampling frequency.
+    setCutoff(cutoff_frequency);
+}
+
+/**
+ * Sets the Q of the filter.
+ *
+ * Arguments
+ * ---------
+ * double q: The new Q. 1 / sqrt(2) gives a Butterworth lowpass and highpass.
+ */
+template <typename SampleType>
+void StateVariableFilter<SampleType>::setResonance(double q)
+{
+    damping = (SampleType) (1.0 / std::max(q, 0.01));
+}
+
+/**
+ * Sets the cutoff used by the overload of processSample without a cutoff argument.
+ *
+ * Arguments
+ * ---------
+ * double freq: The new cutoff frequency in Hz.
+ */
+template <typename SampleType>
+void StateVariableFilter<SampleType>::setCutoff(double freq)
+{
+    cutoff_frequency = freq;
+    g = fastTan((SampleType) freq * inverse_sampling_frequency);
+}
+
+/**
+ * Clears the integrator state.
+ */
+template <typename SampleType>
+void StateVariableFilter<SampleType>::reset()
+{
+    ic1eq = 0;
+    ic2eq = 0;
+}
+
+/**
+ * Filters a block of samples in place, with a cutoff for every sample.
+ *
+ * Arguments
+ * ---------
+ * SampleType* samples: The samples to filter. Overwritten with the selected output.
+ * const SampleType* cutoffs: The cutoff frequency in Hz for each sample.
+ * int numSamples: The number of samples.
+ * Output output: Which of the outputs to write back.
+ */
+template <typename SampleType>
+void StateVariableFilter<SampleType>::process(SampleType* samples, const SampleType* cutoffs, int numSamples, Output output)
+{
+    // Pick the output once per block rather than once per sample.
+    switch (output) {
+        case Output::low:
+            for (int index = 0; index < numSamples; ++index) {
+                samples[index] = processSample(samples[index], cutoffs[index]).low;
+            }
+            break;
+        case Output::band:
+            for (int index = 0; index < numSamples; ++index) {
+                samples[index] = processSample(samples[index], cutoffs[index]).band;
+            }
+            break;
+        case Output::high:
+            for (int index = 0; index < numSamples; ++index) {
+                samples[index] = processSample(samples[index], cutoffs[index]).high;
+            }
+            break;
+    }
+}
+
+// The plugin uses both precisions, depending on what the host asks for.
+template class StateVariableFilter<float>;
+template class StateVariableFilter<double>;
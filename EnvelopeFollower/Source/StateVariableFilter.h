@@ -0,0 +1,265 @@
+/*
+  ==============================================================================
+
+    StateVariableFilter.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition and the per-sample implementation of the StateVariableFilter component
+                 class, a zero-delay-feedback filter whose cutoff can change every sample.
+    Dependencies:
+    - algorithm
+    - vector
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <algorithm> // Imports the c++ stdlib algorithm libarary.
+#include <vector> // Imports the c++ stdlib vector container used for the tan lookup table.
+
+/**
+ * A topology-preserving transform (zero-delay-feedback) state-variable filter.
+ *
+ * One state update gives the lowpass, bandpass and highpass outputs together. Unlike Filter, changing the cutoff
+ * doesn't need a call to tan() and a coefficient rebuild: tan(pi * cutoff / sampling_frequency) comes from a
+ * lookup table shared by every instance, and the rest of the coefficients are a handful of multiplies and one
+ * divide. That makes it cheap enough to take a new cutoff every sample, for sweeping the detector band at audio rate.
+ *
+ * Based on the trapezoidal integrator SVF in
+ * - https://cytomic.com/files/dsp/SvfLinearTrapOptimised2.pdf
+ *
+ * Templated on the sample type.
+ *
+ * Attributes
+ * ----------
+ * public static const int tan_table_size: The number of intervals in the tan lookup table.
+ * public static const double max_normalised_cutoff: The highest cutoff the table covers, as a fraction of the sampling frequency.
+ * private const SampleType* tan_table: The shared lookup table of tan(pi * cutoff / sampling_frequency).
+ * private SampleType inverse_sampling_frequency: 1 / the sampling frequency, so a cutoff in Hz can be normalised with a multiply.
+ * private double cutoff_frequency: The cutoff set by setCutoff, in Hz.
+ * private SampleType damping: 1 / Q. Defaults to sqrt(2), a Butterworth response.
+ * private SampleType g: The integrator gain for the cutoff set by setCutoff.
+ * private SampleType ic1eq: The state of the first integrator.
+ * private SampleType ic2eq: The state of the second integrator.
+ *
+ * Methods
+ * -------
+ * public StateVariableFilter(): Builds the shared lookup table on first use.
+ * public void setSamplingFrequency(double freq): Sets the number of input samples per second.
+ * public void setResonance(double q): Sets the Q of the filter.
+ * public void setCutoff(double freq): Sets the cutoff used by the overload of processSample without a cutoff argument.
+ * public void reset(): Clears the integrator state.
+ * public Outputs processSample(SampleType sample): Filters one sample at the cutoff set by setCutoff.
+ * public Outputs processSample(SampleType sample, SampleType cutoff): Filters one sample at the given cutoff in Hz.
+ * public void process(SampleType* samples, const SampleType* cutoffs, int numSamples, Output output): Filters a block in place with a cutoff per sample.
+ * public SampleType fastTan(SampleType normalised_cutoff): Looks up tan(pi * normalised_cutoff).
+ * private Outputs tick(SampleType sample, SampleType gain): One state update with the given integrator gain.
+ * private static const std::vector<SampleType>& getTanTable(): Returns the shared lookup table, building it on first call.
+ *
+ * Owned by
+ * - SignalProcessor
+ */
+template <typename SampleType>
+class StateVariableFilter
+{
+public:
+    /**
+     * The three simultaneous outputs of one state update.
+     */
+    struct Outputs {
+        /// The lowpass output.
+        SampleType low;
+        /// The bandpass output.
+        SampleType band;
+        /// The highpass output.
+        SampleType high;
+    };
+
+    /**
+     * Selects which of the outputs process writes back.
+     */
+    enum class Output {
+        low,
+        band,
+        high
+    };
+
+    /// <summary>
+    ///     The number of intervals in the tan lookup table. Linear interpolation between them stays within
+    ///     about 4e-5 of tan() over the whole table.
+    /// </summary>
+    static const int tan_table_size = 4096;
+    /// <summary>
+    ///     The highest cutoff the table covers, as a fraction of the sampling frequency. Higher cutoffs are clamped to it.
+    /// </summary>
+    static constexpr double max_normalised_cutoff = 0.49;
+
+    /**
+     * The constructor for the StateVariableFilter component.
+     *
+     * Builds the shared tan lookup table if no filter has yet, so it is never built on the audio thread.
+     */
+    StateVariableFilter();
+
+    /**
+     * Sets the number of input audio samples per second.
+     *
+     * Arguments
+     * ---------
+     * double freq: The new number of input audio samples per second.
+     */
+    void setSamplingFrequency(double freq);
+
+    /**
+     * Sets the Q of the filter.
+     *
+     * Arguments
+     * ---------
+     * double q: The new Q. 1 / sqrt(2) gives a Butterworth lowpass and highpass.
+     */
+    void setResonance(double q);
+
+    /**
+     * Sets the cutoff used by the overload of processSample without a cutoff argument.
+     *
+     * Arguments
+     * ---------
+     * double freq: The new cutoff frequency in Hz.
+     */
+    void setCutoff(double freq);
+
+    /**
+     * Clears the integrator state.
+     */
+    void reset();
+
+    /**
+     * Filters one sample at the cutoff set by setCutoff.
+     *
+     * Arguments
+     * ---------
+     * SampleType sample: The next input sample.
+     *
+     * Returns
+     * -------
+     * Outputs: The lowpass, bandpass and highpass outputs.
+     */
+    Outputs processSample(SampleType sample) {
+        return tick(sample, g);
+    };
+
+    /**
+     * Filters one sample at the given cutoff. Costs one table lookup and one divide more than the fixed-cutoff overload.
+     *
+     * Arguments
+     * ---------
+     * SampleType sample: The next input sample.
+     * SampleType cutoff: The cutoff frequency in Hz for this sample.
+     *
+     * Returns
+     * -------
+     * Outputs: The lowpass, bandpass and highpass outputs.
+     */
+    Outputs processSample(SampleType sample, SampleType cutoff) {
+        return tick(sample, fastTan(cutoff * inverse_sampling_frequency));
+    };
+
+    /**
+     * Filters a block of samples in place, with a cutoff for every sample.
+     *
+     * Arguments
+     * ---------
+     * SampleType* samples: The samples to filter. Overwritten with the selected output.
+     * const SampleType* cutoffs: The cutoff frequency in Hz for each sample.
+     * int numSamples: The number of samples.
+     * Output output: Which of the outputs to write back.
+     */
+    void process(SampleType* samples, const SampleType* cutoffs, int numSamples, Output output);
+
+    /**
+     * Looks up tan(pi * normalised_cutoff), interpolating linearly between table entries.
+     *
+     * Arguments
+     * ---------
+     * SampleType normalised_cutoff: The cutoff as a fraction of the sampling frequency. Clamped to [0, max_normalised_cutoff].
+     *
+     * Returns
+     * -------
+     * SampleType: Approximately tan(pi * normalised_cutoff).
+     */
+    SampleType fastTan(SampleType normalised_cutoff) const {
+        const SampleType position = std::min(std::max(normalised_cutoff, (SampleType) 0), (SampleType) max_normalised_cutoff)
+                                    * (SampleType) (tan_table_size / max_normalised_cutoff);
+        const int index = std::min((int) position, tan_table_size - 1);
+        const SampleType fraction = position - (SampleType) index;
+        return tan_table[index] + fraction * (tan_table[index + 1] - tan_table[index]);
+    };
+
+private:
+    /**
+     * One trapezoidal state update with the given integrator gain.
+     *
+     * Arguments
+     * ---------
+     * SampleType sample: The next input sample.
+     * SampleType gain: tan(pi * cutoff / sampling_frequency).
+     *
+     * Returns
+     * -------
+     * Outputs: The lowpass, bandpass and highpass outputs.
+     */
+    Outputs tick(SampleType sample, SampleType gain) {
+        // Solve the zero-delay feedback loop for the two integrator outputs.
+        const SampleType a1 = (SampleType) 1 / ((SampleType) 1 + gain * (gain + damping));
+        const SampleType a2 = gain * a1;
+        const SampleType a3 = gain * a2;
+        const SampleType v3 = sample - ic2eq;
+        const SampleType v1 = a1 * ic1eq + a2 * v3;
+        const SampleType v2 = ic2eq + a2 * ic1eq + a3 * v3;
+        // Update the trapezoidal integrator states.
+        ic1eq = 2 * v1 - ic1eq;
+        ic2eq = 2 * v2 - ic2eq;
+        return { v2, v1, sample - damping * v1 - v2 };
+    };
+
+    /**
+     * Returns the lookup table of tan(pi * x) for x from 0 to max_normalised_cutoff, building it on first call.
+     *
+     * Returns
+     * -------
+     * const std::vector<SampleType>&: tan_table_size + 1 entries.
+     */
+    static const std::vector<SampleType>& getTanTable();
+
+    /// <summary>
+    ///     The shared lookup table of tan(pi * cutoff / sampling_frequency).
+    /// </summary>
+    const SampleType* tan_table = nullptr;
+    /// <summary>
+    ///     1 / the sampling frequency, so a cutoff in Hz can be normalised with a multiply.
+    /// </summary>
+    SampleType inverse_sampling_frequency = (SampleType) (1.0 / 44100.0);
+    /// <summary>
+    ///     The cutoff frequency set by setCutoff, in Hz.
+    /// </summary>
+    double cutoff_frequency = 1000;
+    /// <summary>
+    ///     1 / Q. sqrt(2) by default, which gives Butterworth lowpass and highpass outputs.
+    /// </summary>
+    SampleType damping = (SampleType) 1.4142135623730951;
+    /// <summary>
+    ///     The integrator gain for the cutoff set by setCutoff.
+    /// </summary>
+    SampleType g = 0;
+    /// <summary>
+    ///     The state of the first (bandpass) integrator.
+    /// </summary>
+    SampleType ic1eq = 0;
+    /// <summary>
+    ///     The state of the second (lowpass) integrator.
+    /// </summary>
+    SampleType ic2eq = 0;
+};
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    TruePeakDetector.cpp
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the implementation of the interpolator design and block methods of the TruePeakDetector component class.
+    Dependencies:
+    - TruePeakDetector.h
+
+  ==============================================================================
+*/
+
+// Import the dependencies for this file.
+#include "TruePeakDetector.h" // Import the interface definition for the TruePeakDetector component for implementation.
+
+/**
+ * The zeroth-order modified Bessel function of the first kind, used by the Kaiser window.
+ *
+ * Arguments
+ * ---------
+ * double x: The argument.
+ *
+ * Returns
+ * -------
+ * double: I0(x), summed until the terms stop mattering.
+ */
+static double besselI0(double x)
+{
+    double sum = 1;
+    double term = 1;
+    for (int k = 1; k < 50 && term > 1e-12 * sum; ++k) {
+        const double factor = x / (2 * k);
+        term *= factor * factor;
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * The constructor for the TruePeakDetector component.
+ *
+ * Designs a 64-tap windowed sinc lowpass at the original Nyquist frequency, for a 4x higher rate, and splits it
+ * into four phases. Tap n of the prototype belongs to phase n % 4, and phase 0 is a unit impulse at delay, since
+ * the sinc is 0 at every other whole sample. Each interpolating phase is normalised to unity gain at DC.
+ */
+template <typename SampleType>
+TruePeakDetector<SampleType>::TruePeakDetector()
+{
+    const int factor = 4;
+    const int length = factor * taps_per_phase;
+    const double centre = factor * delay;
+    const double beta = 8.0; // Around 80 dB of stopband rejection.
+    const double pi = 3.14159265358979323846;
+
+    for (int phase = 1; phase < factor; ++phase) {
+        double taps[taps_per_phase];
+        double sum = 0;
+        for (int tap = 0; tap < taps_per_phase; ++tap) {
+            const int n = factor * tap + phase;
+            const double t = (n - centre) / factor;
+            const double sinc = sin(pi * t) / (pi * t);
+            const double ratio = (n - centre) / centre;
+            const double window = ratio * ratio < 1 ? besselI0(beta * sqrt(1 - ratio * ratio)) / besselI0(beta) : 0;
+            taps[tap] = n < length ? sinc * window : 0;
+            sum += taps[tap];
+        }
+        // History is stored oldest first, so tap k (k samples back) goes at the far end.
+        for (int tap = 0; tap < taps_per_phase; ++tap) {
+            phases[phase - 1][taps_per_phase - 1 - tap] = (SampleType) (taps[tap] / sum);
+        }
+    }
+    reset();
+}
+
+/**
+ * Clears the history.
+ */
+template <typename SampleType>
+void TruePeakDetector<SampleType>::reset()
+{
+    std::fill(history, history + 2 * taps_per_phase, (SampleType) 0);
+    position = 0;
+}
+
+/**
+ * Replaces each sample of a block with the true peak delay samples back.
+ *
+ * Arguments
+ * ---------
+ * SampleType* samples: The input samples. Overwritten with the true peaks.
+ * int numSamples: The number of samples.
+ */
+template <typename SampleType>
+void TruePeakDetector<SampleType>::process(SampleType* samples, int numSamples)
+{
+    const int tail = taps_per_phase - 1;
+    int start = 0;
+    while (start < numSamples) {
+        const int length = std::min(chunk_length, numSamples - start);
+
+        // Lay the previous inputs and this chunk out in order, oldest first.
+        const SampleType* newest = history + position + taps_per_phase;
+        std::copy(newest - tail + 1, newest + 1, chunk);
+        std::copy(samples + start, samples + start + length, chunk + tail);
+
+        for (int index = 0; index < length; ++index) {
+            samples[start + index] = interpolate(chunk + index);
+        }
+
+        // Carry the last inputs over in the mirrored history, so processSample can pick up where this left off.
+        for (int index = 0; index < taps_per_phase; ++index) {
+            history[index] = history[index + taps_per_phase] = chunk[length - 1 + index];
+        }
+        position = taps_per_phase - 1;
+        start += length;
+    }
+}
+
+// The plugin uses both precisions, depending on what the host asks for.
+template class TruePeakDetector<float>;
+template class TruePeakDetector<double>;
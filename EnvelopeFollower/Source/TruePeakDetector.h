@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+    TruePeakDetector.h
+    Created: 16 Oct 2026
+    Last Updated: 16 Oct 2026
+
+    Description: Contains the API definition and the per-sample implementation of the TruePeakDetector component
+                 class, which finds the peaks between samples with a 4x polyphase interpolator.
+    Dependencies:
+    - algorithm
+    - math.h
+    - EnvelopeBank.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Import the dependencies for the contents of this file.
+#include <algorithm> // Imports the c++ stdlib algorithm libarary.
+#include <math.h> // Imports the basic c stdlib math library
+#include "EnvelopeBank.h" // Import the LaneVector SIMD helpers used for the interpolation taps.
+
+/**
+ * Rectifies a signal after upsampling it 4x, so that peaks falling between samples are caught.
+ *
+ * A full-scale signal near the Nyquist frequency can peak well above its largest sample. Upsampling 4x
+ * and taking the largest of the four sub-samples finds those inter-sample peaks, as in ITU-R BS.1770.
+ *
+ * The interpolator is a 64-tap Kaiser-windowed sinc split into four 16-tap phases, one per sub-sample. Rather than
+ * stuffing three zeros after every sample and running all 64 taps at 4x the rate (256 multiplies per input
+ * sample), each phase only runs over the real samples. The sinc is centred on a whole sample, so the first phase
+ * is a plain 8 sample delay and needs no multiplies at all, leaving 3 x 16 = 48 multiplies per input sample.
+ * Those run LaneVector<SampleType>::width taps at a time over a contiguous run of inputs. processSample keeps its
+ * history mirrored so the last 16 inputs never wrap around. process instead copies the block a chunk at a time
+ * behind the previous 15 inputs, so its loads never wait on the scalar stores that just wrote the history.
+ *
+ * The output lags the input by 8 samples, the centre of the interpolator.
+ *
+ * Attributes
+ * ----------
+ * public static const int taps_per_phase: The number of taps in each of the four phases.
+ * public static const int delay: The delay in samples from an input sample to its sub-samples at the output.
+ * public static const int chunk_length: The number of samples process copies into its linear scratch at a time.
+ * private SampleType phases[3][taps_per_phase]: The taps of the three interpolating phases, oldest input first.
+ * private SampleType history[2 * taps_per_phase]: The last taps_per_phase input samples, stored twice in a row.
+ * private SampleType chunk[taps_per_phase - 1 + chunk_length]: Scratch for process, holding a run of inputs in order.
+ * private int position: The index in history of the newest sample.
+ *
+ * Methods
+ * -------
+ * public TruePeakDetector(): Designs the interpolator.
+ * public void reset(): Clears the history.
+ * public SampleType processSample(SampleType sample): Takes one sample and returns the largest magnitude of its four sub-samples.
+ * public void process(SampleType* samples, int numSamples): Replaces each sample of a block with its true peak.
+ * private SampleType interpolate(const SampleType* window): Runs the three phases over one window and returns the true peak.
+ * private static SampleType sumLanes(Register value): Adds up the lanes of a register.
+ *
+ * Owned by
+ * - SignalProcessor
+ */
+template <typename SampleType>
+class TruePeakDetector
+{
+public:
+    /// <summary>
+    ///     The number of taps in each of the four phases. A multiple of every LaneVector width.
+    /// </summary>
+    static const int taps_per_phase = 16;
+    /// <summary>
+    ///     The delay in samples from an input sample to its sub-samples at the output. Half the phase length.
+    /// </summary>
+    static const int delay = taps_per_phase / 2;
+    /// <summary>
+    ///     The number of samples process copies into its linear scratch at a time.
+    /// </summary>
+    static const int chunk_length = 64;
+
+    /**
+     * The constructor for the TruePeakDetector component.
+     *
+     * Designs the interpolator and clears the history.
+     */
+    TruePeakDetector();
+
+    /**
+     * Clears the history.
+     */
+    void reset();
+
+    /**
+     * Takes one input sample, and returns the largest magnitude among the four sub-samples delay samples back.
+     *
+     * Arguments
+     * ---------
+     * SampleType sample: The next input sample.
+     *
+     * Returns
+     * -------
+     * SampleType: The true peak of the sample delay samples ago. Never negative.
+     */
+    SampleType processSample(SampleType sample) {
+        // Write the sample twice, so the last taps_per_phase samples are always one contiguous run.
+        position = (position + 1) & (taps_per_phase - 1);
+        history[position] = sample;
+        history[position + taps_per_phase] = sample;
+        const SampleType* window = history + position + 1;
+
+        return interpolate(window);
+    };
+
+    /**
+     * Replaces each sample of a block with the true peak delay samples back.
+     *
+     * Gives the same output as calling processSample on every sample, and the two can be mixed freely.
+     *
+     * Arguments
+     * ---------
+     * SampleType* samples: The input samples. Overwritten with the true peaks.
+     * int numSamples: The number of samples.
+     */
+    void process(SampleType* samples, int numSamples);
+
+private:
+    /**
+     * Runs the three interpolating phases over one window of inputs, and returns the largest of the four sub-sample magnitudes.
+     *
+     * Arguments
+     * ---------
+     * const SampleType* window: The last taps_per_phase input samples, oldest first.
+     *
+     * Returns
+     * -------
+     * SampleType: The true peak of the sample delay samples before the newest. Never negative.
+     */
+    SampleType interpolate(const SampleType* window) const {
+        typedef LaneVector<SampleType> V;
+
+        // The three interpolating phases share every load of the inputs.
+        typename V::Register sum_1 = V::broadcast(0);
+        typename V::Register sum_2 = V::broadcast(0);
+        typename V::Register sum_3 = V::broadcast(0);
+        for (int tap = 0; tap < taps_per_phase; tap += V::width) {
+            const typename V::Register inputs = V::load(window + tap);
+            sum_1 = V::add(sum_1, V::mul(V::load(phases[0] + tap), inputs));
+            sum_2 = V::add(sum_2, V::mul(V::load(phases[1] + tap), inputs));
+            sum_3 = V::add(sum_3, V::mul(V::load(phases[2] + tap), inputs));
+        }
+
+        // The first phase is the input itself, delay samples back.
+        SampleType peak = (SampleType) fabs(window[taps_per_phase - 1 - delay]);
+        peak = std::max(peak, (SampleType) fabs(sumLanes(sum_1)));
+        peak = std::max(peak, (SampleType) fabs(sumLanes(sum_2)));
+        peak = std::max(peak, (SampleType) fabs(sumLanes(sum_3)));
+        return peak;
+    };
+
+    /**
+     * Adds up the lanes of a register.
+     *
+     * Arguments
+     * ---------
+     * typename LaneVector<SampleType>::Register value: The register to sum.
+     *
+     * Returns
+     * -------
+     * SampleType: The sum of every lane.
+     */
+    static SampleType sumLanes(typename LaneVector<SampleType>::Register value) {
+        SampleType lanes[LaneVector<SampleType>::width];
+        LaneVector<SampleType>::store(lanes, value);
+        SampleType sum = 0;
+        for (int lane = 0; lane < LaneVector<SampleType>::width; ++lane) {
+            sum += lanes[lane];
+        }
+        return sum;
+    };
+
+    /// <summary>
+    ///     The taps of the three interpolating phases (a quarter, a half and three quarters of a sample), oldest input first.
+    /// </summary>
+    SampleType phases[3][taps_per_phase];
+    /// <summary>
+    ///     The last taps_per_phase input samples, stored twice in a row so any taps_per_phase of them are contiguous.
+    /// </summary>
+    SampleType history[2 * taps_per_phase];
+    /// <summary>
+    ///     Scratch for process: the last taps_per_phase - 1 inputs followed by up to chunk_length new ones, in order.
+    /// </summary>
+    SampleType chunk[taps_per_phase - 1 + chunk_length];
+    /// <summary>
+    ///     The index in history of the newest sample.
+    /// </summary>
+    int position = 0;
+};